@@ -0,0 +1,1116 @@
+/**
+ ******************************************************************************
+ * @file            Bench.c
+ * @author          Maxime
+ * @brief           Host benchmark runner for the PIC18 API
+ * @brief           Runs the API against the simulated register file (HostSim.c)
+ *                  and reports, for each benchmark:
+ *                      - calls: number of API calls measured
+ *                      - sfr/call: register accesses per call (exact)
+ *                      - cyc/call: instruction cycles per call, caller side (estimate)
+ *                      - bytes/s: data throughput on the simulated line
+ *                      - lost: bytes lost on the simulated line, or the failed checks
+ *                        of the benchmarks verifying known answers (See their comment)
+ *
+ * @note            Usage:
+ @verbatim
+                    bench                   Print the results
+                    bench -w <file>         Print the results and save them as the new baseline
+                    bench -c <file>         Print the results and fail if any register access count,
+                                            cycle count or loss count is higher than in the baseline
+ @endverbatim
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include <stdio.h>
+#include <string.h>
+#include "HostSim.h"
+#include "TraceDecode.h"
+#include "../Inc/GPIO.h"
+#include "../Inc/Interrupts.h"
+#include "../Inc/USART.h"
+#include "../Inc/SystemTime.h"
+#include "../Inc/SoftTimer.h"
+#include "../Inc/Scheduler.h"
+#include "../Inc/Profile.h"
+#include "../Inc/MemoryMonitor.h"
+#include "../Inc/Packet.h"
+#include "../Inc/CRC.h"
+#include "../Inc/Format.h"
+#include "../Inc/Trace.h"
+//-----------------------------------
+
+//-----------------------------------
+#define BENCH_BRG_9600          103                             //!< 16MHz, high speed: 9615 bauds
+#define BENCH_BRG_115200        8                               //!< 16MHz, high speed: 111111 bauds
+#define BENCH_RX_BYTES          256
+#define BENCH_RX_WORK           1000                            //!< Cycles of application work between two reception polls
+#define BENCH_MAX               32
+#define BENCH_TIMERS            256
+#define BENCH_TASKS             8
+#define BENCH_MD_NODES          8                               //!< Multi-drop bus: frames sent round robin to the nodes
+#define BENCH_MD_FRAMES         32
+#define BENCH_MD_PAYLOAD        8
+#define BENCH_PACKETS           4
+#define BENCH_PACKET_SIZE       32
+#define BENCH_CRC_STATES        4096                            //!< CRC-16 and CRC-32 values compared across the implementations
+#define BENCH_LOG_EVENTS        100                             //!< Log events, one every BENCH_LOG_PERIOD cycles
+#define BENCH_LOG_PERIOD        40000                           //!< 10ms at 16MHz
+#define BENCH_DRIFT_WINDOWS     2000                            //!< Interrupts disabled windows, see BenchSysTimeDrift()
+#define BENCH_LOAD_ISR_CYCLES   6554                            //!< Timer3 handler: 10% of its 65536 cycles period, see BenchSysTimeLoad()
+//-----------------------------------
+
+/**
+ * @brief   Benchmark result type
+ *
+ */
+typedef struct
+{
+    const char *Name;
+    uint32_t Calls;                                             //!< API calls measured
+    uint64_t Accesses;                                          //!< Register accesses during the calls
+    uint64_t Cycles;                                            //!< Instruction cycles during the calls
+    uint32_t Bytes;                                             //!< Bytes moved on the line
+    uint64_t LineCycles;                                        //!< Instruction cycles needed to move the bytes
+    uint32_t Lost;                                              //!< Bytes lost on the line
+}BenchResultType;
+
+static BenchResultType Results[BENCH_MAX];
+static uint8_t ResultCnt = 0;
+static uint64_t MarkAccesses, MarkCycles;
+static const char Line48[] = "T=0023.5C H=041% P=1013.2hPa V=3.30V ID=0001 OK\r";
+//-----------------------------------
+
+static void BenchIsr(void)
+{
+    InterruptDispatch();
+}
+//-----------------------------------
+
+static void Start(void)
+{
+    MarkAccesses = HostSimAccesses();
+    MarkCycles = HostSimCycles();
+}
+//-----------------------------------
+
+static BenchResultType *Stop(const char *name, uint32_t calls)
+{
+    //---------
+    BenchResultType *r = &Results[ResultCnt++];
+    //---------
+    memset(r, 0, sizeof(*r));
+    r->Name = name;
+    r->Calls = calls;
+    r->Accesses = HostSimAccesses() - MarkAccesses;
+    r->Cycles = HostSimCycles() - MarkCycles;
+    //---------
+    return r;
+}
+//-----------------------------------
+
+static void Setup(uint8_t brg)
+{
+    HostSimReset();
+    HostSimSetIsr(BenchIsr);
+    USARTAsyncInit(brg);
+}
+//-----------------------------------
+
+static uint8_t TxDone(void)
+{
+    return HostSimTxIdle();
+}
+//-----------------------------------
+
+static void BenchPrintPolled(void)
+{
+    //---------
+    BenchResultType *r;
+    uint64_t t0;
+    //---------
+    Setup(BENCH_BRG_9600);
+    t0 = HostSimCycles();
+    Start();
+    USARTPrint(Line48);
+    r = Stop("usart_print_polled_48B_9600", 1);
+    HostSimRunUntil(TxDone, 4000000);
+    r->Bytes = HostSimTxCapture(0, 0);
+    r->LineCycles = HostSimCycles() - t0;
+    r->Lost = (uint32_t)(sizeof(Line48) - 1) - r->Bytes;
+    //---------
+}
+//-----------------------------------
+
+static void BenchPrintQueued(void)
+{
+    //---------
+    BenchResultType *r;
+    uint64_t t0;
+    //---------
+    Setup(BENCH_BRG_9600);
+    USARTTxIntEnable();
+    MCUInterruptEnable();
+    t0 = HostSimCycles();
+    Start();
+    USARTPrint(Line48);
+    r = Stop("usart_print_queued_48B_9600", 1);
+    HostSimRunUntil(TxDone, 4000000);
+    r->Bytes = HostSimTxCapture(0, 0);
+    r->LineCycles = HostSimCycles() - t0;
+    r->Lost = (uint32_t)(sizeof(Line48) - 1) - r->Bytes;
+    //---------
+}
+//-----------------------------------
+
+static void BenchRx(uint8_t ring)
+{
+    //---------
+    BenchResultType *r;
+    uint8_t data[BENCH_RX_BYTES];
+    uint32_t received = 0, calls = 0;
+    uint64_t t0, accesses = 0, cycles = 0;
+    uint16_t i;
+    int c;
+    //---------
+    for(i = 0; i < BENCH_RX_BYTES; ++i)
+        data[i] = (uint8_t)i;
+    //---------
+    Setup(BENCH_BRG_115200);
+    if(ring)
+    {
+        USARTRxIntEnable();
+        MCUInterruptEnable();
+    }
+    t0 = HostSimCycles();
+    HostSimRxInject(data, BENCH_RX_BYTES);
+    //---------
+    while(!HostSimRxIdle() || (ring ? USARTRxBufferAvailable() : USARTRxAvailable()))
+    {
+        HostSimDelay(BENCH_RX_WORK);                            //!< Application busy elsewhere
+        Start();
+        if(ring)
+        {
+            while((c = USARTRxBufferRead()) >= 0)
+                ++received;
+        }
+        else
+        {
+            while(USARTRxAvailable())
+            {
+                USARTReceiveByte();
+                ++received;
+            }
+        }
+        ++calls;
+        accesses += HostSimAccesses() - MarkAccesses;
+        cycles += HostSimCycles() - MarkCycles;
+    }
+    //---------
+    r = Stop(ring ? "usart_rx_ring_256B_115200" : "usart_rx_polled_256B_115200", calls);
+    r->Accesses = accesses;
+    r->Cycles = cycles;
+    r->Bytes = received;
+    r->LineCycles = HostSimCycles() - t0;
+    r->Lost = BENCH_RX_BYTES - received;
+    //---------
+}
+//-----------------------------------
+
+static void BenchRxPolled(void)
+{
+    BenchRx(0);
+}
+//-----------------------------------
+
+static void BenchRxRing(void)
+{
+    BenchRx(1);
+}
+//-----------------------------------
+
+/**
+ * @brief   Node 3 of a multi-drop bus carrying frames for 8 nodes: the interrupts taken by the node
+ *          are counted as calls, the payload bytes it received as bytes.
+ */
+static void BenchMultidrop(void)
+{
+    //---------
+    BenchResultType *r;
+    uint16_t bus[BENCH_MD_FRAMES * (BENCH_MD_PAYLOAD + 2)];
+    uint8_t frame[USART_MD_FRAME_SIZE];
+    uint32_t received = 0, interrupts;
+    uint16_t i, j, n = 0;
+    uint64_t t0;
+    int len;
+    //---------
+    for(i = 0; i < BENCH_MD_FRAMES; ++i)
+    {
+        bus[n++] = 0x100 | (i % BENCH_MD_NODES);
+        bus[n++] = BENCH_MD_PAYLOAD;
+        for(j = 0; j < BENCH_MD_PAYLOAD; ++j)
+            bus[n++] = (uint16_t)(i + j);
+    }
+    //---------
+    HostSimReset();
+    HostSimSetIsr(BenchIsr);
+    USARTMultidropInit(BENCH_BRG_115200, 3);
+    MCUInterruptEnable();
+    t0 = HostSimCycles();
+    interrupts = HostSimInterrupts();
+    Start();
+    HostSimRxInject9(bus, n);
+    while(!HostSimRxIdle() || USARTMultidropFrameReady())
+    {
+        HostSimDelay(BENCH_RX_WORK);
+        if((len = USARTMultidropRead(frame)) >= 0)
+            received += (uint32_t)len;
+    }
+    r = Stop("usart_multidrop_rx_1_of_8_nodes", HostSimInterrupts() - interrupts);
+    r->Bytes = received;
+    r->LineCycles = HostSimCycles() - t0;
+    r->Lost = BENCH_MD_FRAMES / BENCH_MD_NODES * BENCH_MD_PAYLOAD - received;
+    InterruptUnregisterHandler(USART_RX_INT_FLAG);
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Packets sent by the device, looped back to its receiver: the interrupts taken are
+ *          counted as calls, the payload bytes received intact as bytes.
+ */
+static uint8_t PacketTxDone(void)
+{
+    return !PacketTxBusy() && HostSimTxIdle();
+}
+//-----------------------------------
+
+static void BenchPacket(void)
+{
+    //---------
+    static uint16_t line[BENCH_PACKETS * (BENCH_PACKET_SIZE + 2) * 2 + 2 * BENCH_PACKETS];
+    static uint8_t bytes[sizeof(line) / sizeof(line[0])];
+    BenchResultType *r;
+    uint8_t data[BENCH_PACKETS][BENCH_PACKET_SIZE];
+    uint32_t received = 0, interrupts, n;
+    uint16_t i, j;
+    uint8_t *packet, len;
+    uint64_t t0;
+    //---------
+    for(i = 0; i < BENCH_PACKETS; ++i)
+        for(j = 0; j < BENCH_PACKET_SIZE; ++j)
+            data[i][j] = (uint8_t)(0xBC + i * BENCH_PACKET_SIZE + j);     //!< Goes through END and ESC
+    //---------
+    Setup(BENCH_BRG_115200);
+    PacketInit();
+    MCUInterruptEnable();
+    t0 = HostSimCycles();
+    interrupts = HostSimInterrupts();
+    Start();
+    for(i = 0; i < BENCH_PACKETS; ++i)
+    {
+        PacketSend(data[i], BENCH_PACKET_SIZE);
+        HostSimRunUntil(PacketTxDone, 4000000);
+    }
+    n = HostSimTxCapture(line, sizeof(line) / sizeof(line[0]));
+    for(i = 0; i < n && i < sizeof(bytes); ++i)
+        bytes[i] = (uint8_t)line[i];
+    HostSimRxInject(bytes, (uint16_t)i);
+    i = 0;
+    do
+    {
+        HostSimDelay(BENCH_RX_WORK);
+        while((packet = PacketReceive(&len)) != NULL)
+        {
+            if(len == BENCH_PACKET_SIZE && i < BENCH_PACKETS && memcmp(packet, data[i], len) == 0)
+                received += len;
+            PacketRelease();
+            ++i;
+        }
+    }while(!HostSimRxIdle());
+    r = Stop("packet_loopback_4x32B_115200", HostSimInterrupts() - interrupts);
+    r->Bytes = received;
+    r->LineCycles = HostSimCycles() - t0;
+    r->Lost = BENCH_PACKETS * BENCH_PACKET_SIZE - received;
+    InterruptUnregisterHandler(USART_RX_INT_FLAG);
+    InterruptUnregisterHandler(UART_TX_INT_FLAG);
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   CRC check values: lost counts the implementations, block functions included, that do not
+ *          give the CRC of "123456789", and the bytes for which the bitwise, nibble and table
+ *          implementations disagree (every CRC-8 value, BENCH_CRC_STATES CRC-16 and CRC-32 values)
+ *
+ */
+static void BenchCrc(void)
+{
+    //---------
+    static const uint8_t check[] = "123456789";
+    BenchResultType *r;
+    uint8_t crc8[3], c8;
+    uint16_t crc16[3], c16;
+    uint32_t crc32[3], c32, lost = 0;
+    uint16_t i, j;
+    //---------
+    HostSimReset();
+    crc8[0] = crc8[1] = crc8[2] = CRC8_INIT;
+    crc16[0] = crc16[1] = crc16[2] = CRC16_INIT;
+    crc32[0] = crc32[1] = crc32[2] = CRC32_INIT;
+    Start();
+    for(i = 0; i < sizeof(check) - 1; ++i)
+    {
+        crc8[0] = CRC8BitUpdate(crc8[0], check[i]);
+        crc8[1] = CRC8NibbleUpdate(crc8[1], check[i]);
+        crc8[2] = CRC8TableUpdate(crc8[2], check[i]);
+        crc16[0] = CRC16BitUpdate(crc16[0], check[i]);
+        crc16[1] = CRC16NibbleUpdate(crc16[1], check[i]);
+        crc16[2] = CRC16TableUpdate(crc16[2], check[i]);
+        crc32[0] = CRC32BitUpdate(crc32[0], check[i]);
+        crc32[1] = CRC32NibbleUpdate(crc32[1], check[i]);
+        crc32[2] = CRC32TableUpdate(crc32[2], check[i]);
+    }
+    r = Stop("crc_check_123456789", 9 * (sizeof(check) - 1));
+    for(i = 0; i < 3; ++i)
+        lost += (crc8[i] != 0xF4) + (crc16[i] != 0x29B1) + (CRC32Final(crc32[i]) != 0xCBF43926UL);
+    lost += CRC8Block(CRC8_INIT, check, sizeof(check) - 1) != 0xF4;
+    lost += CRC16Block(CRC16_INIT, check, sizeof(check) - 1) != 0x29B1;
+    lost += CRC32Final(CRC32Block(CRC32_INIT, check, sizeof(check) - 1)) != 0xCBF43926UL;
+    //---------
+    for(i = 0; i < 256; ++i)
+        for(j = 0; j < 256; ++j)
+        {
+            c8 = CRC8BitUpdate((uint8_t)i, (uint8_t)j);
+            lost += c8 != CRC8NibbleUpdate((uint8_t)i, (uint8_t)j) || c8 != CRC8TableUpdate((uint8_t)i, (uint8_t)j);
+        }
+    c16 = CRC16_INIT;
+    c32 = CRC32_INIT;
+    for(i = 0; i < BENCH_CRC_STATES; ++i)
+    {
+        j = (uint8_t)(i * 37 + (i >> 8));                       //!< Every byte value, shifted on each turn
+        lost += CRC16NibbleUpdate(c16, (uint8_t)j) != CRC16BitUpdate(c16, (uint8_t)j)
+             || CRC16TableUpdate(c16, (uint8_t)j) != CRC16BitUpdate(c16, (uint8_t)j);
+        lost += CRC32NibbleUpdate(c32, (uint8_t)j) != CRC32BitUpdate(c32, (uint8_t)j)
+             || CRC32TableUpdate(c32, (uint8_t)j) != CRC32BitUpdate(c32, (uint8_t)j);
+        c16 = CRC16BitUpdate(c16, (uint8_t)j);
+        c32 = CRC32BitUpdate(c32, (uint8_t)j);
+    }
+    r->Lost = lost;
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   1 when a FormatString() output or length differs from the known answer
+ *
+ */
+static uint32_t BenchFormatDiff(const char *line, uint8_t len, const char *expected)
+{
+    return len != strlen(expected) || strcmp(line, expected) != 0;
+}
+//-----------------------------------
+
+/**
+ * @brief   FormatString() conversions, lost counts the outputs that differ from the known answers
+ *
+ */
+static void BenchFormat(void)
+{
+    //---------
+    BenchResultType *r;
+    uint32_t lost = 0;
+    char line[32];
+    //---------
+    HostSimReset();
+    Start();
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "%d", -1234), "-1234");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "%d", -32768), "-32768");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "[%6d]", -42), "[   -42]");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "[%-6d]", -42), "[-42   ]");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "[%06d]", -42), "[-00042]");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "[%5u]", 7), "[    7]");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "[%-5u]", 7), "[7    ]");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "[%05u]", 65535), "[65535]");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "%.2u", 5), "0.05");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "%.2u", 0), "0.00");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "%.2u", 1234), "12.34");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "[%7.3d]", -5), "[ -0.005]");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "%lx", 0xDEADBEEFUL), "deadbeef");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "%lu", 4294967295UL), "4294967295");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "%ld", -100000L), "-100000");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "%X", 0xBEEF), "BEEF");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "%04X", 0xA), "000A");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "%x", 0), "0");
+    lost += BenchFormatDiff(line, FormatString(line, sizeof(line), "%-4s|%c%%", "ab", 'Z'), "ab  |Z%");
+    lost += BenchFormatDiff(line, FormatString(line, 4, "%u", 12345), "123");
+    r = Stop("format_string_known_answers", 20);
+    r->Lost = lost;
+    //---------
+}
+//-----------------------------------
+
+static void BenchLogText(void)
+{
+    //---------
+    static const char first[] = "rx=1000 err=5\r";              //!< Known answer of the first event
+    BenchResultType *r;
+    uint32_t expected = 0, wrong = 0;
+    uint16_t i, sent[sizeof(first) - 1];
+    uint64_t t0;
+    char line[32];
+    //---------
+    Setup(BENCH_BRG_9600);
+    USARTTxIntEnable();
+    MCUInterruptEnable();
+    t0 = HostSimCycles();
+    Start();
+    for(i = 0; i < BENCH_LOG_EVENTS; ++i)
+    {
+        FormatPrint(USARTPutByte, "rx=%u err=%u\r", 1000 + i, 5);
+        HostSimDelay(BENCH_LOG_PERIOD);
+    }
+    r = Stop("log_text_100_events_9600", BENCH_LOG_EVENTS);
+    r->Cycles -= (uint64_t)BENCH_LOG_EVENTS * BENCH_LOG_PERIOD;
+    HostSimRunUntil(TxDone, 40000000);
+    for(i = 0; i < BENCH_LOG_EVENTS; ++i)
+        expected += FormatString(line, sizeof(line), "rx=%u err=%u\r", 1000 + i, 5);
+    r->Bytes = HostSimTxCapture(sent, sizeof(sent) / sizeof(sent[0]));
+    for(i = 0; i < sizeof(sent) / sizeof(sent[0]); ++i)
+        wrong += sent[i] != (uint8_t)first[i];
+    r->LineCycles = HostSimCycles() - t0;
+    r->Lost = expected - r->Bytes + wrong;
+    USARTTxIntDisable();
+    InterruptUnregisterHandler(UART_TX_INT_FLAG);
+    //---------
+}
+//-----------------------------------
+
+static const char BenchTraceFmt[] = "rx=%u err=%u";
+
+/**
+ * @brief   Format string lookup of the trace benchmark, see TraceDecode()
+ *
+ */
+static const char *BenchTraceFormat(uint16_t id)
+{
+    return id == (uint16_t)(unsigned long)BenchTraceFmt ? BenchTraceFmt : NULL;
+}
+//-----------------------------------
+
+/**
+ * @brief   The events sent are decoded with the tracedecode decoder (See TraceDecode.h), lost counts
+ *          the bytes not sent, the events not decoded or decoded to another line than FormatString()
+ *          prints, and the wrong format strings not detected: TRACE1() with a %lu conversion
+ *
+ */
+static void BenchLogTrace(void)
+{
+    //---------
+    static uint16_t line[BENCH_LOG_EVENTS * 6];
+    static uint8_t bytes[sizeof(line) / sizeof(line[0])];
+    static char text[BENCH_LOG_EVENTS * 16];
+    BenchResultType *r;
+    TraceDecodeStatsType stats;
+    uint32_t n, wrong = 0;
+    uint16_t i, errors;
+    uint64_t t0;
+    char expected[32], *str;
+    FILE *out;
+    //---------
+    Setup(BENCH_BRG_9600);
+    TraceInit();
+    MCUInterruptEnable();
+    t0 = HostSimCycles();
+    Start();
+    for(i = 0; i < BENCH_LOG_EVENTS; ++i)
+    {
+        TRACE2(BenchTraceFmt, 1000 + i, 5);
+        HostSimDelay(BENCH_LOG_PERIOD);
+    }
+    r = Stop("log_trace_100_events_9600", BENCH_LOG_EVENTS);
+    r->Cycles -= (uint64_t)BENCH_LOG_EVENTS * BENCH_LOG_PERIOD;
+    HostSimRunUntil(TxDone, 40000000);
+    r->Bytes = HostSimTxCapture(line, sizeof(line) / sizeof(line[0]));
+    r->LineCycles = HostSimCycles() - t0;
+    r->Lost = BENCH_LOG_EVENTS * 6 - r->Bytes;                  //!< ID and 2 arguments per event
+    //---------
+    for(n = 0; n < r->Bytes && n < sizeof(bytes); ++n)
+        bytes[n] = (uint8_t)line[n];
+    out = fmemopen(text, sizeof(text), "w");
+    TraceDecode(bytes, n, BenchTraceFormat, 0, out, &stats);
+    fclose(out);
+    str = text;
+    for(i = 0; i < BENCH_LOG_EVENTS; ++i)
+    {
+        FormatString(expected, sizeof(expected), "rx=%u err=%u\n", 1000 + i, 5);
+        if(strncmp(str, expected, strlen(expected)) != 0)
+        {
+            ++wrong;
+            continue;
+        }
+        str += strlen(expected);
+    }
+    wrong += BENCH_LOG_EVENTS - stats.Events + stats.Skipped + stats.Incomplete;
+    errors = TraceGetFormatErrors();
+    TRACE1("x=%lu", 1);
+    wrong += TraceGetFormatErrors() != errors + 1;
+    TraceFlush();
+    r->Lost += wrong;
+    InterruptUnregisterHandler(UART_TX_INT_FLAG);
+    //---------
+}
+//-----------------------------------
+
+static void BenchGpioToggle(void)
+{
+    //---------
+    uint16_t i;
+    //---------
+    HostSimReset();
+    GPIOSetOutput(GPIOB, 3);
+    Start();
+    for(i = 0; i < 1000; ++i)
+        GPIOTogglePin(GPIOB, 3);
+    Stop("gpio_toggle_pin", 1000);
+    //---------
+}
+//-----------------------------------
+
+static void BenchGpioPinWrite(void)
+{
+    //---------
+    uint16_t i;
+    //---------
+    HostSimReset();
+    GPIOPinOutput(GPIO_PINS(GPIOD, 0x0F));
+    Start();
+    for(i = 0; i < 1000; ++i)
+        GPIOPinWrite(GPIO_PINS(GPIOD, 0x0F), (uint8_t)i);
+    Stop("gpio_pin_write_4_pins", 1000);
+    //---------
+}
+//-----------------------------------
+
+static void BenchInterruptGetFlag(void)
+{
+    //---------
+    uint16_t i;
+    //---------
+    HostSimReset();
+    Start();
+    for(i = 0; i < 1000; ++i)
+        InterruptGetFlag(USART_RX_INT_FLAG);
+    Stop("interrupt_get_flag", 1000);
+    //---------
+}
+//-----------------------------------
+
+static void BenchTmr1Handler(void)
+{
+    PIR1bits.TMR1IF = 0;
+}
+//-----------------------------------
+
+static void BenchNoHandler(void)
+{
+}
+//-----------------------------------
+
+static void BenchInterruptDispatch(void)
+{
+    //---------
+    uint16_t i;
+    //---------
+    HostSimReset();
+    InterruptUnregisterHandler(USART_RX_INT_FLAG);
+    InterruptUnregisterHandler(UART_TX_INT_FLAG);
+    InterruptRegisterHandler(TMR0_OVF_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGHEST, BenchNoHandler);
+    InterruptRegisterHandler(INT0_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGH, BenchNoHandler);
+    InterruptRegisterHandler(TMR1_OVF_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_NORMAL, BenchTmr1Handler);
+    InterruptRegisterHandler(CCP2_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_LOW, BenchNoHandler);
+    PIE1bits.TMR1IE = 1;                                        //!< One source enabled and pending per dispatch
+    Start();
+    for(i = 0; i < 1000; ++i)
+    {
+        PIR1bits.TMR1IF = 1;
+        InterruptDispatch();
+    }
+    Stop("interrupt_dispatch_4_handlers", 1000);
+    InterruptUnregisterHandler(TMR0_OVF_INT_FLAG);
+    InterruptUnregisterHandler(INT0_INT_FLAG);
+    InterruptUnregisterHandler(TMR1_OVF_INT_FLAG);
+    InterruptUnregisterHandler(CCP2_INT_FLAG);
+    //---------
+}
+//-----------------------------------
+
+static void BenchSysTimeIdle(void)
+{
+    //---------
+    BenchResultType *r;
+    uint32_t interrupts;
+    //---------
+    HostSimReset();
+    HostSimSetIsr(BenchIsr);
+    SystimeInit();
+    interrupts = HostSimInterrupts();
+    Start();
+    HostSimDelay((uint32_t)FOSC_MHZ * 250000UL);                 //!< One second of idle time
+    r = Stop("systime_idle_1s", HostSimInterrupts() - interrupts);
+    r->Cycles -= (uint32_t)FOSC_MHZ * 250000UL;                 //!< Interrupt load only: calls are interrupts
+    InterruptUnregisterHandler(TMR0_OVF_INT_FLAG);
+    //---------
+}
+//-----------------------------------
+
+static void BenchSysTimeTickUs(void)
+{
+    //---------
+    uint16_t i;
+    //---------
+    HostSimReset();
+    HostSimSetIsr(BenchIsr);
+    SystimeInit();
+    Start();
+    for(i = 0; i < 1000; ++i)
+        Tick_us();
+    Stop("systime_tick_us", 1000);
+    InterruptUnregisterHandler(TMR0_OVF_INT_FLAG);
+    //---------
+}
+//-----------------------------------
+
+static void BenchSysTimeWait(void)
+{
+    //---------
+    HostSimReset();
+    HostSimSetIsr(BenchIsr);
+    SystimeInit();
+    Start();
+    Wait_ms(1000);
+    Stop("systime_wait_1s", 1);
+    InterruptUnregisterHandler(TMR0_OVF_INT_FLAG);
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Time kept while the interrupts are disabled for 1.04 ms at a time (a 9600 bauds
+ *          SUART_MODE_DELAY frame): lost is the Tick_ms() error in milliseconds
+ *
+ */
+static void BenchSysTimeDrift(void)
+{
+    //---------
+    BenchResultType *r;
+    uint32_t interrupts, ms, elapsed;
+    uint16_t i;
+    //---------
+    HostSimReset();
+    HostSimSetIsr(BenchIsr);
+    SystimeInit();
+    interrupts = HostSimInterrupts();
+    ms = Tick_ms();
+    Start();
+    for(i = 0; i < BENCH_DRIFT_WINDOWS; ++i)
+    {
+        di();
+        HostSimDelay((uint32_t)FOSC_MHZ * 260UL);               //!< 1.04 ms
+        ei();
+    }
+    r = Stop("systime_drift_2000_di_1040us", HostSimInterrupts() - interrupts);
+    elapsed = (uint32_t)(r->Cycles / SYSTIME_CYCLES_PER_MS);
+    ms = Tick_ms() - ms;
+    r->Lost = ms > elapsed ? ms - elapsed : elapsed - ms;
+    r->Cycles -= (uint64_t)BENCH_DRIFT_WINDOWS * FOSC_MHZ * 260UL;   //!< Interrupt load only: calls are interrupts
+    InterruptUnregisterHandler(TMR0_OVF_INT_FLAG);
+    //---------
+}
+//-----------------------------------
+
+static uint64_t BenchLoadBusy;                                  //!< Cycles of work in the second measurement window, see BenchSysTimeLoad()
+static uint8_t BenchLoadWindow;
+//-----------------------------------
+
+static void BenchLoadHandler(void)
+{
+    PIR2bits.TMR3IF = 0;
+    HostSimDelay(BENCH_LOAD_ISR_CYCLES);
+    if(BenchLoadWindow)
+        BenchLoadBusy += BENCH_LOAD_ISR_CYCLES;
+}
+//-----------------------------------
+
+/**
+ * @brief   CPU load measured by SysTimeIdle(): the main loop works load - 10% of a millisecond
+ *          after each idle wait, a Timer3 handler 10% of the time. The handler delays the main
+ *          loop work past the next millisecond at times: lost is the error in per cent of
+ *          SysTimeCpuLoad() over the second window, against the work done in the window. The
+ *          loop and interrupts overheads, about 1%, are load left out of the work
+ *
+ */
+static void BenchSysTimeLoad(const char *name, uint8_t load)
+{
+    //---------
+    BenchResultType *r;
+    uint32_t work = (uint32_t)(load - 10) * SYSTIME_CYCLES_PER_MS / 100;
+    uint8_t measured, expected;
+    //---------
+    HostSimReset();
+    HostSimSetIsr(BenchIsr);
+    SystimeInit();
+    InterruptRegisterHandler(TMR3_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGH, BenchLoadHandler);
+    T3CON = 0x81;
+    PIR2bits.TMR3IF = 0;
+    PIE2bits.TMR3IE = 1;
+    INTCONbits.PEIE = 1;
+    BenchLoadBusy = 0;
+    BenchLoadWindow = 0;
+    Start();
+    while(Tick_ms() < 2 * SYSTIME_LOAD_WINDOW_MS)
+    {
+        SysTimeIdle();
+        BenchLoadWindow = Tick_ms() >= SYSTIME_LOAD_WINDOW_MS;  //!< The first SysTimeIdle() call past it opens the second window
+        HostSimDelay(work);
+        if(BenchLoadWindow)
+            BenchLoadBusy += work;
+    }
+    measured = SysTimeCpuLoad();
+    r = Stop(name, 2 * SYSTIME_LOAD_WINDOW_MS);
+    expected = (uint8_t)((BenchLoadBusy * 100 / SYSTIME_CYCLES_PER_MS + SYSTIME_LOAD_WINDOW_MS / 2) / SYSTIME_LOAD_WINDOW_MS);
+    r->Lost = measured > expected ? measured - expected : expected - measured;
+    PIE2bits.TMR3IE = 0;
+    T3CON = 0;
+    InterruptUnregisterHandler(TMR3_INT_FLAG);
+    InterruptUnregisterHandler(TMR0_OVF_INT_FLAG);
+    //---------
+}
+//-----------------------------------
+
+static void BenchSysTimeLoad30(void)
+{
+    BenchSysTimeLoad("systime_load_30pct", 30);
+}
+//-----------------------------------
+
+static void BenchSysTimeLoad50(void)
+{
+    BenchSysTimeLoad("systime_load_50pct", 50);
+}
+//-----------------------------------
+
+static void BenchSysTimeLoad70(void)
+{
+    BenchSysTimeLoad("systime_load_70pct", 70);
+}
+//-----------------------------------
+
+static void BenchSoftTimerHandler(void *arg)
+{
+    ++*(uint32_t *)arg;
+}
+//-----------------------------------
+
+static void BenchSoftTimer(void)
+{
+    //---------
+    static SoftTimerType timers[BENCH_TIMERS];
+    BenchResultType *r;
+    uint32_t fired = 0;
+    uint64_t accesses = 0, cycles = 0;
+    uint16_t i;
+    //---------
+    HostSimReset();
+    HostSimSetIsr(BenchIsr);
+    SystimeInit();
+    SoftTimerInit();
+    for(i = 0; i < BENCH_TIMERS; ++i)                           //!< Periodic timers from 10 to 265 ms
+        SoftTimerStart(&timers[i], 10 + i, 10 + i, BenchSoftTimerHandler, &fired);
+    for(i = 0; i < 1000; ++i)                                   //!< One task call per millisecond, during one second
+    {
+        HostSimDelay((uint32_t)FOSC_MHZ * 250UL);
+        Start();
+        SoftTimerTask();
+        accesses += HostSimAccesses() - MarkAccesses;
+        cycles += HostSimCycles() - MarkCycles;
+    }
+    r = Stop("softtimer_task_256_timers_1s", fired);
+    r->Accesses = accesses;
+    r->Cycles = cycles;
+    InterruptUnregisterHandler(TMR0_OVF_INT_FLAG);
+    //---------
+}
+//-----------------------------------
+
+static TaskType BenchTasks[BENCH_TASKS];
+static uint32_t BenchTaskRuns;
+//-----------------------------------
+
+static uint8_t BenchTask(TaskType *task)
+{
+    //---------
+    TASK_BEGIN(task);
+    while(1)
+    {
+        ++BenchTaskRuns;
+        if(task == &BenchTasks[0])                              //!< One task sleeps, the other ones yield
+            TASK_WAIT_MS(task, 10);
+        else
+            TASK_YIELD(task);
+    }
+    TASK_END(task);
+    //---------
+}
+//-----------------------------------
+
+static void BenchScheduler(void)
+{
+    //---------
+    BenchResultType *r;
+    uint64_t accesses = 0, cycles = 0;
+    uint16_t i;
+    //---------
+    HostSimReset();
+    HostSimSetIsr(BenchIsr);
+    SystimeInit();
+    SoftTimerInit();
+    SchedulerInit();
+    for(i = 0; i < BENCH_TASKS; ++i)
+        SchedulerAddTask(&BenchTasks[i], BenchTask);
+    BenchTaskRuns = 0;
+    for(i = 0; i < 1000; ++i)                                   //!< One scheduler turn per millisecond, during one second
+    {
+        HostSimDelay((uint32_t)FOSC_MHZ * 250UL);
+        Start();
+        SchedulerStep();
+        accesses += HostSimAccesses() - MarkAccesses;
+        cycles += HostSimCycles() - MarkCycles;
+    }
+    r = Stop("scheduler_step_8_tasks_1s", BenchTaskRuns);
+    r->Accesses = accesses;
+    r->Cycles = cycles;
+    InterruptUnregisterHandler(TMR0_OVF_INT_FLAG);
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Cost of an empty section, lost is the calibration error in cycles: the mean of the
+ *          empty sections plus the error on a 1000 cycles section
+ *
+ */
+static void BenchProfile(void)
+{
+    //---------
+    BenchResultType *r;
+    ProfileSectionType empty, known;
+    uint32_t error;
+    uint16_t i;
+    //---------
+    HostSimReset();
+    HostSimSetIsr(BenchIsr);
+    ProfileInit();
+    Start();
+    for(i = 0; i < 1000; ++i)
+    {
+        PROFILE_BEGIN(0);
+        PROFILE_END(0);
+    }
+    r = Stop("profile_begin_end", 1000);
+    PROFILE_BEGIN(1);
+    HostSimDelay(1000);
+    PROFILE_END(1);
+    ProfileGetSection(0, &empty);
+    ProfileGetSection(1, &known);
+    error = known.Total > 1000 ? known.Total - 1000 : 1000 - known.Total;
+    r->Lost = empty.Total / empty.Count + error;
+    InterruptUnregisterHandler(TMR3_INT_FLAG);
+    //---------
+}
+//-----------------------------------
+
+static char BenchMemMonText[96];
+
+static void BenchMemMonPrint(const char *str)
+{
+    strncat(BenchMemMonText, str, sizeof(BenchMemMonText) - strlen(BenchMemMonText) - 1);
+}
+//-----------------------------------
+
+/**
+ * @brief   Cost of a stack sample, lost counts the differences with the known answers: a stack
+ *          full reset at boot, a 32 bytes region written up to its 10th byte, a depth of 12
+ *          levels, then an underflow and an overflow
+ *
+ */
+static void BenchMemMon(void)
+{
+    //---------
+    static const char expected[] = "stack max=31/31 full=1 underflow=1 boot=80\rrx used=10/32\r";
+    BenchResultType *r;
+    MemMonStackType stack;
+    uint8_t buf[32];
+    uint16_t i;
+    uint32_t lost = 0;
+    //---------
+    HostSimReset();
+    STKPTR = 0x80 | 5;
+    MemMonInit();
+    lost += STKPTR != 5;                                        //!< STKFUL cleared, depth kept
+    STKPTR = 12;
+    Start();
+    for(i = 0; i < 1000; ++i)
+        MemMonStackSample();
+    r = Stop("memmon_stack_sample", 1000);
+    MemMonGetStack(&stack);
+    lost += stack.MaxDepth != 12 || stack.Full != 0 || stack.Underflow != 0 || stack.Boot != MEMMON_BOOT_STACK_FULL;
+    lost += MemMonAddRegion("rx", buf, sizeof(buf));
+    lost += MemMonHighWater(buf, sizeof(buf)) != 0;
+    memset(buf, 0, 10);
+    lost += MemMonHighWater(buf, sizeof(buf)) != 10;
+    STKPTR = 0x40 | 3;
+    MemMonStackSample();
+    STKPTR = 0x80 | 31;
+    MemMonStackSample();
+    lost += STKPTR != 31;
+    BenchMemMonText[0] = '\0';
+    MemMonPrint(BenchMemMonPrint);
+    lost += strcmp(BenchMemMonText, expected) != 0;
+    r->Lost = lost;
+    //---------
+}
+//-----------------------------------
+
+static void (*const Benchmarks[])(void) =
+{
+    BenchPrintPolled,
+    BenchPrintQueued,
+    BenchRxPolled,
+    BenchRxRing,
+    BenchMultidrop,
+    BenchPacket,
+    BenchCrc,
+    BenchFormat,
+    BenchLogText,
+    BenchLogTrace,
+    BenchGpioToggle,
+    BenchGpioPinWrite,
+    BenchInterruptGetFlag,
+    BenchInterruptDispatch,
+    BenchSysTimeIdle,
+    BenchSysTimeTickUs,
+    BenchSysTimeWait,
+    BenchSysTimeDrift,
+    BenchSysTimeLoad30,
+    BenchSysTimeLoad50,
+    BenchSysTimeLoad70,
+    BenchSoftTimer,
+    BenchScheduler,
+    BenchProfile,
+    BenchMemMon,
+};
+//-----------------------------------
+
+static void Print(void)
+{
+    //---------
+    uint8_t i;
+    double bps;
+    //---------
+    printf("%-32s %8s %10s %12s %10s %6s\n", "benchmark", "calls", "sfr/call", "cyc/call", "bytes/s", "lost");
+    for(i = 0; i < ResultCnt; ++i)
+    {
+        BenchResultType *r = &Results[i];
+        bps = r->LineCycles ? r->Bytes * (FOSC_MHZ * 1e6 / 4) / (double)r->LineCycles : 0;
+        printf("%-32s %8u %10.1f %12.1f %10.0f %6u\n", r->Name, r->Calls,
+               (double)r->Accesses / r->Calls, (double)r->Cycles / r->Calls, bps, r->Lost);
+    }
+    //---------
+}
+//-----------------------------------
+
+static int Save(const char *file)
+{
+    //---------
+    FILE *f = fopen(file, "w");
+    uint8_t i;
+    //---------
+    if(f == NULL)
+    {
+        perror(file);
+        return 1;
+    }
+    fprintf(f, "# benchmark accesses cycles lost\n");
+    for(i = 0; i < ResultCnt; ++i)
+        fprintf(f, "%s %llu %llu %u\n", Results[i].Name, (unsigned long long)Results[i].Accesses,
+                (unsigned long long)Results[i].Cycles, Results[i].Lost);
+    fclose(f);
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+static int Check(const char *file)
+{
+    //---------
+    FILE *f = fopen(file, "r");
+    char line[160], name[80];
+    unsigned long long accesses, cycles;
+    unsigned lost;
+    int fail = 0;
+    uint8_t i;
+    //---------
+    if(f == NULL)
+    {
+        perror(file);
+        return 1;
+    }
+    while(fgets(line, sizeof(line), f))
+    {
+        if(line[0] == '#' || sscanf(line, "%79s %llu %llu %u", name, &accesses, &cycles, &lost) != 4)
+            continue;
+        for(i = 0; i < ResultCnt; ++i)
+        {
+            BenchResultType *r = &Results[i];
+            if(strcmp(r->Name, name) != 0)
+                continue;
+            if(r->Accesses > accesses || r->Cycles > cycles || r->Lost > lost)
+            {
+                printf("REGRESSION %s: accesses %llu -> %llu, cycles %llu -> %llu, lost %u -> %u\n", name,
+                       accesses, (unsigned long long)r->Accesses, cycles, (unsigned long long)r->Cycles, lost, r->Lost);
+                fail = 1;
+            }
+            break;
+        }
+    }
+    fclose(f);
+    //---------
+    return fail;
+}
+//-----------------------------------
+
+int main(int argc, char **argv)
+{
+    //---------
+    uint8_t i;
+    //---------
+    for(i = 0; i < sizeof(Benchmarks) / sizeof(Benchmarks[0]); ++i)
+        Benchmarks[i]();
+    Print();
+    //---------
+    if(argc == 3 && strcmp(argv[1], "-w") == 0)
+        return Save(argv[2]);
+    if(argc == 3 && strcmp(argv[1], "-c") == 0)
+        return Check(argv[2]);
+    //---------
+    return 0;
+}
+//-----------------------------------
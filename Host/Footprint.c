@@ -0,0 +1,618 @@
+/**
+ ******************************************************************************
+ * @file            Footprint.c
+ * @author          Maxime
+ * @brief           Flash and RAM footprint report of the production image
+ * @brief           Reads the .map file produced by the XC8 linker and reports the
+ *                  program memory and data memory used by each module (source file)
+ *                  and by each of its functions:
+ *                      - flash: function sizes of the MODULE INFORMATION section
+ *                      - ram: symbols of the data space psects, sized up to the next
+ *                        symbol of the same psect. Function locals and parameters
+ *                        (func@var, ?func) belong to the module of the function,
+ *                        global and static variables to the source file defining them.
+ *                  The report is compared to a budget file, the command fails when
+ *                  a module or the total exceeds its allowance, and to the footprint
+ *                  of the previous build.
+ *
+ * @note            With a budget file, every module of the image and every source file given
+ *                  must have a budget line: a new module fails the command until it is
+ *                  budgeted (-u reports it only). With source files, the data symbols that none
+ *                  of them defines fail it too: they come from a map older than the sources, the
+ *                  production image must be rebuilt ("make sim" checks it this way).
+ *
+ * @note            A budget only enforces something close to the measurement: a module given as
+ *                  source but with no code in the image fails the command as unmeasured, and a
+ *                  budget over twice the measured size (and over LOOSE_FLASH/LOOSE_RAM) as loose.
+ *                  Set the budget from the measured size plus the expected growth.
+ *
+ * @note            The compiled stack (cstack psects) is overlaid by the linker: the locals
+ *                  of functions that never run at the same time share addresses, so the
+ *                  module RAM figures add up beyond the used RAM, the total does not.
+ *
+ * @note            Footprint and budget file format, one module per line, bytes:
+ @verbatim
+    # module flash ram
+    SoftwareUART 400 48
+    total 32768 1536
+ @endverbatim
+ *
+ * @note            Usage:
+ @verbatim
+    footprint [options] <image.map> [source.c...]
+        -b <file>           Budget file, fail when a module is over its budget
+        -p <file>           Footprint of the previous build, print the differences
+        -w <file>           Save the footprint (can be the -p file)
+        -f                  Print the module totals only, not the functions
+        -u                  Report the modules without a budget line, do not fail
+ @endverbatim
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+//-----------------------------------
+
+//-----------------------------------
+#define MAX_PSECTS              128
+#define MAX_FUNCS               512
+#define MAX_SYMS                2048
+#define MAX_MODULES             64
+#define MAX_NAME                64
+#define SPACE_FLASH             0                               //!< Linker space numbers
+#define SPACE_RAM               1
+#define LOOSE_FLASH             64                              //!< Budgets up to these sizes are never loose, see Loose()
+#define LOOSE_RAM               16
+//-----------------------------------
+
+//-----------------------------------
+typedef struct
+{
+    char Name[MAX_NAME];
+    uint32_t Addr;
+    uint32_t Length;
+    unsigned Space;
+}PsectType;
+
+typedef struct
+{
+    char Name[MAX_NAME];                                        //!< As in the map: _func for C functions
+    int Module;
+    uint32_t Flash;
+    uint32_t Ram;                                               //!< Locals and parameters
+}FuncType;
+
+typedef struct
+{
+    char Name[MAX_NAME];
+    int Psect;
+    uint32_t Addr;
+    uint32_t Size;                                              //!< Data symbols, see SizeRam()
+    int Module;
+}SymType;
+
+typedef struct
+{
+    char Name[MAX_NAME];
+    uint32_t Flash;
+    uint32_t Ram;
+    long PrevFlash;                                             //!< -1: not in the previous footprint
+    long PrevRam;
+    long BudgetFlash;                                           //!< -1: no budget
+    long BudgetRam;
+    int Source;                                                 //!< 1: a source file was given for it
+}ModuleType;
+//-----------------------------------
+
+//-----------------------------------
+static PsectType Psects[MAX_PSECTS];
+static int PsectCnt = 0;
+static FuncType Funcs[MAX_FUNCS];
+static int FuncCnt = 0;
+static SymType Syms[MAX_SYMS];
+static int SymCnt = 0;
+static ModuleType Modules[MAX_MODULES];
+static int ModuleCnt = 0;
+static char SourceNames[MAX_SYMS][MAX_NAME];                    //!< File scope variables of the source files
+static int SourceModules[MAX_SYMS];
+static int SourceCnt = 0;
+//-----------------------------------
+
+static int ModuleIndex(const char *name)
+{
+    //---------
+    int i;
+    //---------
+    for(i = 0; i < ModuleCnt; ++i)
+        if(strcmp(Modules[i].Name, name) == 0)
+            return i;
+    if(ModuleCnt >= MAX_MODULES - 1)                            //!< The last one collects the overflow
+        return MAX_MODULES - 1;
+    //---------
+    memset(&Modules[ModuleCnt], 0, sizeof(ModuleType));
+    snprintf(Modules[ModuleCnt].Name, MAX_NAME, "%s", name);
+    Modules[ModuleCnt].PrevFlash = Modules[ModuleCnt].PrevRam = -1;
+    Modules[ModuleCnt].BudgetFlash = Modules[ModuleCnt].BudgetRam = -1;
+    //---------
+    return ModuleCnt++;
+}
+//-----------------------------------
+
+/**
+ * @brief   Module name of a path: file name without directory nor extension
+ *
+ */
+static int PathModule(const char *path)
+{
+    //---------
+    char name[MAX_NAME];
+    const char *s = path, *p;
+    char *dot;
+    //---------
+    for(p = path; *p; ++p)
+        if(*p == '/' || *p == '\\')
+            s = p + 1;
+    snprintf(name, sizeof(name), "%s", s);
+    dot = strrchr(name, '.');
+    if(dot != NULL && dot != name)
+        *dot = '\0';
+    //---------
+    return ModuleIndex(name);
+}
+//-----------------------------------
+
+static FuncType *FindFunc(const char *name)
+{
+    //---------
+    int i;
+    //---------
+    for(i = 0; i < FuncCnt; ++i)                                //!< C functions carry a leading underscore
+        if(strcmp(Funcs[i].Name, name) == 0 || (Funcs[i].Name[0] == '_' && strcmp(Funcs[i].Name + 1, name) == 0))
+            return &Funcs[i];
+    //---------
+    return NULL;
+}
+//-----------------------------------
+
+static int FindPsect(const char *name)
+{
+    //---------
+    int i;
+    //---------
+    for(i = 0; i < PsectCnt; ++i)
+        if(strcmp(Psects[i].Name, name) == 0)
+            return i;
+    //---------
+    return -1;
+}
+//-----------------------------------
+
+static int LoadMap(const char *file)
+{
+    //---------
+    FILE *fp = fopen(file, "r");
+    enum { NONE, TOTAL, SYMBOLS, MODULES } part = NONE;
+    char line[512], name[MAX_NAME], cls[MAX_NAME], psect[MAX_NAME];
+    unsigned link, load, length, space, size;
+    int module = -1;
+    //---------
+    if(fp == NULL)
+    {
+        perror(file);
+        return 1;
+    }
+    while(fgets(line, sizeof(line), fp))
+    {
+        if(strncmp(line, "TOTAL", 5) == 0) { part = TOTAL; continue; }
+        if(strncmp(line, "SEGMENTS", 8) == 0) { part = NONE; continue; }
+        if(strstr(line, "Symbol Table") != NULL) { part = SYMBOLS; continue; }
+        if(strncmp(line, "MODULE INFORMATION", 18) == 0) { part = MODULES; continue; }
+        switch(part)
+        {
+            case TOTAL:                                         //!< name link load length space
+                if(sscanf(line, " %63s %x %x %x %u", name, &link, &load, &length, &space) == 5 && PsectCnt < MAX_PSECTS)
+                {
+                    snprintf(Psects[PsectCnt].Name, MAX_NAME, "%s", name);
+                    Psects[PsectCnt].Addr = link;
+                    Psects[PsectCnt].Length = length;
+                    Psects[PsectCnt].Space = space;
+                    ++PsectCnt;
+                }
+                break;
+            case SYMBOLS:                                       //!< name psect address
+                if(sscanf(line, "%63s %63s %x", name, psect, &link) == 3 && SymCnt < MAX_SYMS)
+                {
+                    snprintf(Syms[SymCnt].Name, MAX_NAME, "%s", name);
+                    Syms[SymCnt].Psect = FindPsect(psect);
+                    Syms[SymCnt].Addr = link;
+                    ++SymCnt;
+                }
+                break;
+            case MODULES:                                       //!< Path, then "function class link load size" lines
+                if(line[0] != '\t' && line[0] != ' ' && line[0] != '\r' && line[0] != '\n' &&
+                   strstr(line, "estimated size") == NULL && strncmp(line, "Module", 6) != 0)
+                {
+                    line[strcspn(line, "\r\n")] = '\0';
+                    module = PathModule(line);
+                }
+                else if(module >= 0 && sscanf(line, " %63s %63s %x %x %u", name, cls, &link, &load, &size) == 5 &&
+                        strcmp(cls, "CODE") == 0 && FuncCnt < MAX_FUNCS)
+                {
+                    snprintf(Funcs[FuncCnt].Name, MAX_NAME, "%s", name);
+                    Funcs[FuncCnt].Module = module;
+                    Funcs[FuncCnt].Flash = size;
+                    Funcs[FuncCnt].Ram = 0;
+                    Modules[module].Flash += size;
+                    ++FuncCnt;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    fclose(fp);
+    //---------
+    if(PsectCnt == 0 || FuncCnt == 0)
+    {
+        fprintf(stderr, "%s: no psect or module information, is it an XC8 map file?\n", file);
+        return 1;
+    }
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+/**
+ * @brief   Collect the file scope definitions of a C source file: lines starting at
+ *          column 0, the identifier before the first '[', '=' or ';' (variables)
+ *
+ */
+static int LoadSource(const char *file)
+{
+    //---------
+    FILE *fp = fopen(file, "r");
+    int module = PathModule(file);
+    char line[512], last[MAX_NAME];
+    const char *s;
+    size_t n;
+    //---------
+    if(fp == NULL)
+    {
+        perror(file);
+        return 1;
+    }
+    Modules[module].Source = 1;
+    while(fgets(line, sizeof(line), fp))
+    {
+        if(!(isalpha((unsigned char)line[0]) || line[0] == '_') || strncmp(line, "typedef", 7) == 0 ||
+           strncmp(line, "extern", 6) == 0)
+            continue;
+        last[0] = '\0';
+        for(s = line; *s && *s != '(' && *s != '[' && *s != '=' && *s != ';' && *s != '/'; )
+        {
+            if(isalpha((unsigned char)*s) || *s == '_')
+            {
+                for(n = 0; isalnum((unsigned char)s[n]) || s[n] == '_'; ++n)
+                    ;
+                snprintf(last, sizeof(last), "%.*s", (int)(n < MAX_NAME ? n : MAX_NAME - 1), s);
+                s += n;
+            }
+            else
+                ++s;
+        }
+        if((*s == '[' || *s == '=' || *s == ';') && last[0] != '\0' && SourceCnt < MAX_SYMS)
+        {
+            snprintf(SourceNames[SourceCnt], MAX_NAME, "%s", last);
+            SourceModules[SourceCnt] = module;
+            ++SourceCnt;
+        }
+    }
+    fclose(fp);
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+static int CompareSyms(const void *a, const void *b)
+{
+    const SymType *sa = a, *sb = b;
+    if(sa->Psect != sb->Psect)
+        return sa->Psect - sb->Psect;
+    return (sa->Addr > sb->Addr) - (sa->Addr < sb->Addr);
+}
+//-----------------------------------
+
+/**
+ * @brief   Size the data symbols and charge them to their module and function
+ *
+ */
+static void SizeRam(void)
+{
+    //---------
+    char owner[MAX_NAME];
+    uint32_t end, size;
+    FuncType *fn;
+    SymType *sym;
+    int i, j, module;
+    char *at;
+    //---------
+    for(i = j = 0; i < SymCnt; ++i)                             //!< Data space symbols, without the linker __L/__H/__p ones
+    {
+        if(Syms[i].Psect < 0 || Psects[Syms[i].Psect].Space != SPACE_RAM)
+            continue;
+        if(strncmp(Syms[i].Name, "__", 2) == 0 && strchr(Syms[i].Name, '@') == NULL)
+            continue;
+        Syms[j++] = Syms[i];
+    }
+    SymCnt = j;
+    qsort(Syms, (size_t)SymCnt, sizeof(SymType), CompareSyms);
+    //---------
+    for(i = 0; i < SymCnt; ++i)
+    {
+        sym = &Syms[i];
+        end = Psects[sym->Psect].Addr + Psects[sym->Psect].Length;
+        for(j = i + 1; j < SymCnt && Syms[j].Psect == sym->Psect; ++j)
+        {
+            if(Syms[j].Addr > sym->Addr)
+            {
+                end = Syms[j].Addr;
+                break;
+            }
+        }
+        size = end > sym->Addr ? end - sym->Addr : 0;
+        sym->Size = size;
+        //---------
+        fn = NULL;
+        module = -1;
+        snprintf(owner, sizeof(owner), "%.63s", sym->Name[0] == '?' ? sym->Name + 1 : sym->Name);
+        at = strchr(owner, '@');
+        if(at != NULL || sym->Name[0] == '?')                   //!< Locals and parameters
+        {
+            if(at != NULL)
+                *at = '\0';
+            fn = FindFunc(owner);
+            if(fn != NULL)
+                module = fn->Module;
+        }
+        else if(sym->Name[0] == '_')                            //!< C variables
+        {
+            for(j = 0; j < SourceCnt; ++j)
+            {
+                if(strcmp(SourceNames[j], sym->Name + 1) == 0)
+                {
+                    module = SourceModules[j];
+                    break;
+                }
+            }
+        }
+        else                                                    //!< Compiler temporaries
+            module = ModuleIndex("(compiler)");
+        if(module < 0)
+            module = ModuleIndex("(unknown)");
+        //---------
+        sym->Module = module;
+        Modules[module].Ram += size;
+        if(fn != NULL)
+            fn->Ram += size;
+    }
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Budget over twice the measured size, and over the minimum budget
+ * @retval  1: loose, 0: close enough
+ *
+ */
+static int Loose(uint32_t used, long budget, long minimum)
+{
+    return budget > minimum && budget > 2 * (long)used;
+}
+//-----------------------------------
+
+/**
+ * @brief   Read a footprint file, into the previous (budget = 0) or budget (budget = 1) fields
+ *
+ */
+static int LoadFootprint(const char *file, int budget)
+{
+    //---------
+    FILE *fp = fopen(file, "r");
+    char line[160], name[MAX_NAME];
+    unsigned long flash, ram;
+    int module;
+    //---------
+    if(fp == NULL)
+    {
+        if(budget)
+            perror(file);
+        return budget;                                          //!< No previous footprint on the first build
+    }
+    while(fgets(line, sizeof(line), fp))
+    {
+        if(line[0] == '#' || sscanf(line, "%63s %lu %lu", name, &flash, &ram) != 3)
+            continue;
+        module = ModuleIndex(name);
+        if(budget)
+        {
+            Modules[module].BudgetFlash = (long)flash;
+            Modules[module].BudgetRam = (long)ram;
+        }
+        else
+        {
+            Modules[module].PrevFlash = (long)flash;
+            Modules[module].PrevRam = (long)ram;
+        }
+    }
+    fclose(fp);
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+static int SaveFootprint(const char *file)
+{
+    //---------
+    FILE *fp = fopen(file, "w");
+    int i;
+    //---------
+    if(fp == NULL)
+    {
+        perror(file);
+        return 1;
+    }
+    fprintf(fp, "# module flash ram\n");
+    for(i = 0; i < ModuleCnt; ++i)
+        if(Modules[i].Flash != 0 || Modules[i].Ram != 0)
+            fprintf(fp, "%s %u %u\n", Modules[i].Name, Modules[i].Flash, Modules[i].Ram);
+    fclose(fp);
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+static void PrintDelta(char *buf, size_t len, uint32_t value, long prev)
+{
+    if(prev < 0)
+        snprintf(buf, len, "new");
+    else if((long)value == prev)
+        snprintf(buf, len, "=");
+    else
+        snprintf(buf, len, "%+ld", (long)value - prev);
+}
+//-----------------------------------
+
+static void Usage(void)
+{
+    fprintf(stderr, "usage: footprint [-b budget] [-p previous] [-w output] [-f] [-u] image.map [source.c...]\n");
+}
+//-----------------------------------
+
+int main(int argc, char **argv)
+{
+    //---------
+    const char *map = NULL, *budget = NULL, *prev = NULL, *out = NULL;
+    char dflash[24], dram[24], limit[48];
+    int opt, i, j, brief = 0, unbudgeted = 0, fail = 0, total, unknown, sources = 0;
+    ModuleType *m;
+    //---------
+    for(opt = 1; opt < argc; ++opt)
+    {
+        if(argv[opt][0] != '-')
+        {
+            if(map == NULL)
+            {
+                map = argv[opt];
+                if(LoadMap(map) != 0)
+                    return 1;
+            }
+            else if(LoadSource(argv[opt]) != 0)
+                return 1;
+            else
+                ++sources;
+            continue;
+        }
+        if(argv[opt][1] == 'f') { brief = 1; continue; }
+        if(argv[opt][1] == 'u') { unbudgeted = 1; continue; }
+        if(opt + 1 >= argc) { Usage(); return 2; }
+        switch(argv[opt][1])
+        {
+            case 'b': budget = argv[++opt]; break;
+            case 'p': prev = argv[++opt]; break;
+            case 'w': out = argv[++opt]; break;
+            default: Usage(); return 2;
+        }
+    }
+    if(map == NULL)
+    {
+        Usage();
+        return 2;
+    }
+    SizeRam();
+    //---------
+    total = ModuleIndex("total");
+    for(i = 0; i < PsectCnt; ++i)
+    {
+        if(Psects[i].Space == SPACE_FLASH)
+            Modules[total].Flash += Psects[i].Length;
+        else if(Psects[i].Space == SPACE_RAM)
+            Modules[total].Ram += Psects[i].Length;
+    }
+    if((prev != NULL && LoadFootprint(prev, 0) != 0) || (budget != NULL && LoadFootprint(budget, 1) != 0))
+        return 1;
+    if(out != NULL && SaveFootprint(out) != 0)
+        return 1;
+    //---------
+    printf("%-24s %8s %8s %8s %8s %15s\n", "module/function", "flash", "ram", "d.flash", "d.ram", "budget");
+    for(i = 0; i < ModuleCnt; ++i)
+    {
+        m = &Modules[i];
+        if(m->Flash == 0 && m->Ram == 0 && m->PrevFlash < 0)
+            continue;
+        PrintDelta(dflash, sizeof(dflash), m->Flash, m->PrevFlash);
+        PrintDelta(dram, sizeof(dram), m->Ram, m->PrevRam);
+        if(m->BudgetFlash >= 0)
+            snprintf(limit, sizeof(limit), "%ld/%ld", m->BudgetFlash, m->BudgetRam);
+        else
+            snprintf(limit, sizeof(limit), "-");
+        printf("%-24s %8u %8u %8s %8s %15s\n", m->Name, m->Flash, m->Ram, dflash, dram, limit);
+        for(j = 0; j < FuncCnt && !brief; ++j)
+            if(Funcs[j].Module == i)
+                printf("    %-20s %8u %8u\n", Funcs[j].Name, Funcs[j].Flash, Funcs[j].Ram);
+        if(m->BudgetFlash >= 0 && ((long)m->Flash > m->BudgetFlash || (long)m->Ram > m->BudgetRam))
+            fail = 1;
+    }
+    //---------
+    for(i = 0; i < ModuleCnt; ++i)
+    {
+        m = &Modules[i];
+        if(m->BudgetFlash >= 0 && ((long)m->Flash > m->BudgetFlash || (long)m->Ram > m->BudgetRam))
+            printf("OVER BUDGET %s: flash %u/%ld, ram %u/%ld\n", m->Name, m->Flash, m->BudgetFlash, m->Ram, m->BudgetRam);
+    }
+    for(i = 0; i < ModuleCnt; ++i)                              //!< Every budget measured and close to the measurement
+    {
+        m = &Modules[i];
+        if(i == total || m->BudgetFlash < 0)
+            continue;
+        if(m->Source && m->Flash == 0 && m->Ram == 0 && (m->BudgetFlash != 0 || m->BudgetRam != 0))
+            printf("UNMEASURED %s: no code in the image, budget %ld/%ld, rebuild the production image\n",
+                   m->Name, m->BudgetFlash, m->BudgetRam);
+        else if(Loose(m->Flash, m->BudgetFlash, LOOSE_FLASH) || Loose(m->Ram, m->BudgetRam, LOOSE_RAM))
+            printf("LOOSE BUDGET %s: flash %u/%ld, ram %u/%ld, set it from the measurement\n",
+                   m->Name, m->Flash, m->BudgetFlash, m->Ram, m->BudgetRam);
+        else
+            continue;
+        fail = 1;
+    }
+    unknown = ModuleIndex("(unknown)");
+    for(i = 0; i < ModuleCnt && budget != NULL; ++i)            //!< Every module budgeted, the ones not linked in too
+    {
+        m = &Modules[i];
+        if(i == unknown || m->BudgetFlash >= 0 || (m->Flash == 0 && m->Ram == 0 && !m->Source))
+            continue;
+        printf("NO BUDGET %s: flash %u, ram %u, add it to %s\n", m->Name, m->Flash, m->Ram, budget);
+        if(!unbudgeted)
+            fail = 1;
+    }
+    if(Modules[unknown].Ram != 0 && sources != 0)               //!< The map does not come from these sources
+    {
+        for(i = 0; i < SymCnt; ++i)
+            if(Syms[i].Module == unknown && Syms[i].Size != 0)
+                printf("UNKNOWN %s: ram %u, defined by no source file given\n", Syms[i].Name, Syms[i].Size);
+        printf("NOT VERIFIED: %u bytes of RAM of %s belong to no source file given, rebuild the production image\n",
+               Modules[unknown].Ram, map);
+        fail = 1;
+    }
+    //---------
+    return fail;
+}
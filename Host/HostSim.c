@@ -0,0 +1,647 @@
+/**
+ ******************************************************************************
+ * @file            HostSim.c
+ * @author          Maxime
+ * @brief           Source file for the host PIC18F452 register model
+ * @brief           See HostSim.h
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include <string.h>
+#include "HostSim.h"
+//-----------------------------------
+
+//-----------------------------------
+#define SFR_BASE                0xF80
+#define SFR_COUNT               0x80
+#define SFR(addr)               Sfr[(addr) - SFR_BASE]
+
+#define A_PORTA                 0xF80
+#define A_LATA                  0xF89
+#define A_TRISA                 0xF92
+#define A_PIE1                  0xF9D
+#define A_PIR1                  0xF9E
+#define A_PIE2                  0xFA0
+#define A_PIR2                  0xFA1
+#define A_RCSTA                 0xFAB
+#define A_TXSTA                 0xFAC
+#define A_TXREG                 0xFAD
+#define A_RCREG                 0xFAE
+#define A_SPBRG                 0xFAF
+#define A_T3CON                 0xFB1
+#define A_TMR3L                 0xFB2
+#define A_TMR3H                 0xFB3
+#define A_T1CON                 0xFCD
+#define A_TMR1L                 0xFCE
+#define A_TMR1H                 0xFCF
+#define A_T0CON                 0xFD5
+#define A_TMR0L                 0xFD6
+#define A_TMR0H                 0xFD7
+#define A_INTCON3               0xFF0
+#define A_INTCON2               0xFF1
+#define A_INTCON                0xFF2
+
+#define M_TXIF                  0x10
+#define M_RCIF                  0x20
+#define M_GIE                   0x80
+#define M_PEIE                  0x40
+#define M_TMR0IF                0x04
+#define M_TMR3IF                0x02
+#define M_TMR1IF                0x01
+//-----------------------------------
+static uint8_t Sfr[SFR_COUNT];                                  //!< Register file 0xF80 - 0xFFF
+static HostSfrHookType Hooks[SFR_COUNT];                        //!< Per register access hooks
+static uint64_t Cycles = 0;                                     //!< Instruction cycles elapsed
+static uint64_t Accesses = 0;                                   //!< Register accesses
+static uint32_t Interrupts = 0;                                 //!< Interrupts serviced
+static void (*Isr)(void) = 0;                                   //!< Device interrupt service routine
+static uint8_t InIsr = 0;                                       //!< Interrupt being serviced
+static uint16_t Pending = 0;                                    //!< TXREG/RCREG accessed, processed on the next access
+static uint8_t Inputs[5];                                       //!< External pin levels
+//-----------------------------------
+static uint8_t TxRegFull = 0;                                   //!< TXREG holds a byte
+static uint16_t TxRegData;
+static uint8_t TsrBusy = 0;                                     //!< Transmit shift register busy
+static uint16_t TsrData;
+static uint64_t TsrEnd;                                         //!< Cycle at which the stop bit ends
+static uint16_t TxLine[HOST_SIM_LINE_SIZE];                     //!< Frames sent by the device
+static uint32_t TxCount = 0;
+//-----------------------------------
+static uint16_t RxLine[HOST_SIM_LINE_SIZE];                     //!< Frames queued for the device
+static uint32_t RxHead = 0, RxTail = 0;
+static uint64_t RxNext;                                         //!< Cycle at which the next frame stop bit is sampled
+static uint16_t RxFifo[2];                                      //!< Receive FIFO, RCREG is RxFifo[0]
+static uint8_t RxFifoCnt = 0;
+static uint32_t RxLost = 0;
+//-----------------------------------
+static uint16_t Tmr0;                                           //!< Timer0 counter
+static uint32_t Tmr0Prescaler;                                  //!< Instruction cycles counted by the prescaler
+static uint64_t Tmr0Last;                                       //!< Cycle of the last Timer0 update
+static uint8_t Tmr0L, Tmr0H;                                    //!< TMR0L/TMR0H as last presented to the device
+static uint8_t Tmr0HBuf;                                        //!< TMR0H written by the device, loaded into the counter by a TMR0L write
+static uint8_t Tmr0LAccess = 0;                                 //!< TMR0L accessed: read or write, resolved on the next access
+//-----------------------------------
+static uint16_t Tmr1;                                           //!< Timer1 counter
+static uint64_t Tmr1Prescaler;                                  //!< Internal clock: instruction cycles counted by the prescaler, oscillator: cycles * HOST_SIM_T1OSC_HZ
+static uint64_t Tmr1Last;                                       //!< Cycle of the last Timer1 update
+static uint8_t Tmr1L, Tmr1H;                                    //!< TMR1L/TMR1H as last presented to the device
+static uint8_t Tmr1HBuf;                                        //!< TMR1H written by the device, loaded into the counter by a TMR1L write
+static uint8_t Tmr1LAccess = 0;                                 //!< TMR1L accessed: read or write, resolved on the next access
+//-----------------------------------
+static uint16_t Tmr3;                                           //!< Timer3 counter
+static uint32_t Tmr3Prescaler;                                  //!< Instruction cycles counted by the prescaler
+static uint64_t Tmr3Last;                                       //!< Cycle of the last Timer3 update
+//-----------------------------------
+
+static uint32_t UsartBitCycles(void)
+{
+    //---------
+    uint8_t txsta = SFR(A_TXSTA);
+    uint32_t brg = (uint32_t)SFR(A_SPBRG) + 1;
+    //---------
+    if(txsta & 0x10)
+        return brg;                                             //!< Synchronous: FOSC / (4 * (n + 1))
+    return (txsta & 0x04) ? 4 * brg : 16 * brg;                 //!< Asynchronous: FOSC / (16 or 64 * (n + 1))
+}
+//-----------------------------------
+
+static void UsartTxUpdate(void)
+{
+    //---------
+    uint64_t start = Cycles;
+    //---------
+    if(TsrBusy && Cycles >= TsrEnd)
+    {
+        if(TxCount < HOST_SIM_LINE_SIZE)
+            TxLine[TxCount] = TsrData;
+        ++TxCount;
+        TsrBusy = 0;
+        start = TsrEnd;                                         //!< Next frame starts right after the stop bit
+    }
+    //---------
+    if(!TsrBusy && TxRegFull && (SFR(A_TXSTA) & 0x20) && (SFR(A_RCSTA) & 0x80))
+    {
+        TsrData = TxRegData;
+        TsrBusy = 1;
+        TxRegFull = 0;
+        TsrEnd = start + UsartBitCycles() * ((SFR(A_TXSTA) & 0x40) ? 11 : 10);
+    }
+    //---------
+    if(TxRegFull)
+        SFR(A_PIR1) &= (uint8_t)~M_TXIF;
+    else
+        SFR(A_PIR1) |= M_TXIF;
+    if(TsrBusy)
+        SFR(A_TXSTA) &= (uint8_t)~0x02;
+    else
+        SFR(A_TXSTA) |= 0x02;
+    //---------
+}
+//-----------------------------------
+
+static void UsartRxDeliver(uint16_t frame)
+{
+    //---------
+    uint8_t rcsta = SFR(A_RCSTA);
+    //---------
+    if(!(rcsta & 0x80) || !(rcsta & 0x10))
+    {
+        ++RxLost;                                               //!< Receiver disabled
+        return;
+    }
+    if((rcsta & 0x40) && (rcsta & 0x08) && !(frame & 0x100))
+        return;                                                 //!< Data frame filtered out by the address detection
+    if((rcsta & 0x02) || RxFifoCnt == 2)
+    {
+        SFR(A_RCSTA) |= 0x02;                                   //!< OERR, reception stops until CREN is cleared
+        ++RxLost;
+        return;
+    }
+    RxFifo[RxFifoCnt++] = frame;
+    //---------
+}
+//-----------------------------------
+
+static void UsartRxUpdate(void)
+{
+    //---------
+    if(!(SFR(A_RCSTA) & 0x10))
+        SFR(A_RCSTA) &= (uint8_t)~0x02;                         //!< Clearing CREN clears OERR
+    //---------
+    while(RxTail != RxHead && Cycles >= RxNext)
+    {
+        UsartRxDeliver(RxLine[RxTail % HOST_SIM_LINE_SIZE]);
+        ++RxTail;
+        RxNext += UsartBitCycles() * ((SFR(A_RCSTA) & 0x40) ? 11 : 10);
+    }
+    //---------
+    if(RxFifoCnt)
+    {
+        SFR(A_PIR1) |= M_RCIF;
+        SFR(A_RCREG) = (uint8_t)RxFifo[0];
+        SFR(A_RCSTA) = (uint8_t)((SFR(A_RCSTA) & 0xFE) | ((RxFifo[0] >> 8) & 0x01));
+    }
+    else
+        SFR(A_PIR1) &= (uint8_t)~M_RCIF;
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Timer0: internal clock only. A TMR0L access latches the counter high byte into TMR0H
+ *          (read); it is a write if TMR0L changed by the next access, then the counter is loaded
+ *          from TMR0L and the TMR0H buffer (written before TMR0L, or along with it in 16 bits),
+ *          and does not count for 2 cycles.
+ *
+ */
+static void Timer0Update(void)
+{
+    //---------
+    uint8_t t0con = SFR(A_T0CON);
+    uint32_t pre = (t0con & 0x08) ? 1 : (2UL << (t0con & 0x07));
+    uint32_t elapsed = (uint32_t)(Cycles - Tmr0Last);
+    uint32_t counts, max = (t0con & 0x40) ? 0x100 : 0x10000;
+    //---------
+    Tmr0Last = Cycles;
+    if(Tmr0LAccess && SFR(A_TMR0L) != Tmr0L)                    //!< Written by the device: prescaler cleared
+    {
+        if(SFR(A_TMR0H) != Tmr0H)
+            Tmr0HBuf = SFR(A_TMR0H);
+        Tmr0 = (uint16_t)(((t0con & 0x40) ? 0 : (Tmr0HBuf << 8)) | SFR(A_TMR0L));
+        Tmr0Prescaler = 0;
+        elapsed = elapsed > 2 ? elapsed - 2 : 0;                //!< Increment inhibited for 2 cycles after the write
+    }
+    Tmr0LAccess = 0;
+    if(!(t0con & 0x80) || (t0con & 0x20))                       //!< Off, or counting T0CKI
+        elapsed = 0;
+    //---------
+    Tmr0Prescaler += elapsed;
+    counts = Tmr0Prescaler / pre;
+    Tmr0Prescaler %= pre;
+    if((uint32_t)(Tmr0 & (max - 1)) + counts >= max)
+        SFR(A_INTCON) |= M_TMR0IF;
+    Tmr0 = (uint16_t)((Tmr0 + counts) & (max - 1));
+    SFR(A_TMR0L) = Tmr0L = (uint8_t)Tmr0;
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Timer1: internal clock, or the 32.768 kHz oscillator (TMR1CS and T1OSCEN), which keeps
+ *          counting in SLEEP. Written like Timer0: TMR1H then TMR1L, detected on the next access.
+ *
+ */
+static void Timer1Update(void)
+{
+    //---------
+    uint8_t t1con = SFR(A_T1CON);
+    uint64_t elapsed = Cycles - Tmr1Last;
+    uint64_t counts, div;
+    //---------
+    Tmr1Last = Cycles;
+    if(Tmr1LAccess && SFR(A_TMR1L) != Tmr1L)                    //!< Written by the device
+    {
+        if(SFR(A_TMR1H) != Tmr1H)
+            Tmr1HBuf = SFR(A_TMR1H);
+        Tmr1 = (uint16_t)((Tmr1HBuf << 8) | SFR(A_TMR1L));
+        if(t1con & 0x02)                                        //!< Prescaler cleared, the oscillator keeps its phase
+            Tmr1Prescaler %= (uint64_t)FOSC_MHZ * 250000ULL;
+        else
+            Tmr1Prescaler = 0;
+    }
+    Tmr1LAccess = 0;
+    if(!(t1con & 0x01) || ((t1con & 0x02) && !(t1con & 0x08)))  //!< Off, or counting T13CKI
+        elapsed = 0;
+    //---------
+    if(t1con & 0x02)                                            //!< Oscillator
+    {
+        Tmr1Prescaler += elapsed * HOST_SIM_T1OSC_HZ;
+        div = (uint64_t)FOSC_MHZ * 250000ULL << ((t1con >> 4) & 0x03);
+    }
+    else
+    {
+        Tmr1Prescaler += elapsed;
+        div = 1ULL << ((t1con >> 4) & 0x03);
+    }
+    counts = Tmr1Prescaler / div;
+    Tmr1Prescaler %= div;
+    if((uint64_t)Tmr1 + counts >= 0x10000)
+        SFR(A_PIR1) |= M_TMR1IF;
+    Tmr1 = (uint16_t)(Tmr1 + counts);
+    SFR(A_TMR1L) = Tmr1L = (uint8_t)Tmr1;
+    if(!(t1con & 0x80))                                         //!< 8 bits reads: TMR1H is live
+        SFR(A_TMR1H) = Tmr1H = (uint8_t)(Tmr1 >> 8);
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Timer3: internal clock only. The counter is loaded from TMR3H:TMR3L while the timer
+ *          is off (write it stopped), in 16 bits mode a TMR3L access latches the high byte into TMR3H.
+ *
+ */
+static void Timer3Update(void)
+{
+    //---------
+    uint8_t t3con = SFR(A_T3CON);
+    uint32_t pre = 1UL << ((t3con >> 4) & 0x03);
+    uint32_t elapsed = (uint32_t)(Cycles - Tmr3Last);
+    uint32_t counts;
+    //---------
+    Tmr3Last = Cycles;
+    if(!(t3con & 0x01) || (t3con & 0x02))                       //!< Off, or counting T13CKI
+    {
+        Tmr3 = (uint16_t)((SFR(A_TMR3H) << 8) | SFR(A_TMR3L));
+        Tmr3Prescaler = 0;
+        return;
+    }
+    //---------
+    Tmr3Prescaler += elapsed;
+    counts = Tmr3Prescaler / pre;
+    Tmr3Prescaler %= pre;
+    if((uint32_t)Tmr3 + counts >= 0x10000)
+        SFR(A_PIR2) |= M_TMR3IF;
+    Tmr3 = (uint16_t)(Tmr3 + counts);
+    SFR(A_TMR3L) = (uint8_t)Tmr3;
+    if(!(t3con & 0x80))                                         //!< 8 bits reads: TMR3H is live
+        SFR(A_TMR3H) = (uint8_t)(Tmr3 >> 8);
+    //---------
+}
+//-----------------------------------
+
+static uint8_t IntRequest(uint8_t ignoreGie)
+{
+    //---------
+    uint8_t intcon = SFR(A_INTCON);
+    uint8_t intcon3 = SFR(A_INTCON3);
+    //---------
+    if(!ignoreGie && !(intcon & M_GIE))
+        return 0;
+    if((intcon >> 3) & intcon & 0x07)                           //!< TMR0, INT0, RB change
+        return 1;
+    if((intcon3 >> 3) & intcon3 & 0x03)                         //!< INT1, INT2
+        return 1;
+    if(!ignoreGie && !(intcon & M_PEIE))
+        return 0;
+    return (SFR(A_PIE1) & SFR(A_PIR1)) || (SFR(A_PIE2) & SFR(A_PIR2));
+}
+//-----------------------------------
+
+static void Update(void)
+{
+    //---------
+    uint8_t p;
+    //---------
+    for(p = 0; p < 5; ++p)
+    {
+        uint8_t tris = SFR(A_TRISA + p);
+        SFR(A_PORTA + p) = (uint8_t)((SFR(A_LATA + p) & ~tris) | (Inputs[p] & tris));
+    }
+    //---------
+    UsartTxUpdate();
+    UsartRxUpdate();
+    Timer0Update();
+    Timer1Update();
+    Timer3Update();
+    //---------
+    if(!InIsr && Isr && IntRequest(0))
+    {
+        InIsr = 1;
+        ++Interrupts;
+        Cycles += HOST_SIM_ISR_CYCLES;
+        SFR(A_INTCON) &= (uint8_t)~M_GIE;                       //!< Cleared by hardware, set back by RETFIE
+        Isr();
+        SFR(A_INTCON) |= M_GIE;
+        InIsr = 0;
+    }
+    //---------
+}
+//-----------------------------------
+
+static void Commit(void)
+{
+    //---------
+    uint16_t addr = Pending;
+    //---------
+    Pending = 0;
+    if(addr == A_TXREG)
+    {
+        TxRegData = (uint16_t)(SFR(A_TXREG) | ((SFR(A_TXSTA) & 0x01) << 8));
+        TxRegFull = 1;
+        UsartTxUpdate();
+    }
+    else if(addr == A_RCREG && RxFifoCnt)
+    {
+        RxFifo[0] = RxFifo[1];
+        --RxFifoCnt;
+        UsartRxUpdate();
+    }
+    //---------
+}
+//-----------------------------------
+
+volatile uint8_t *HostSfr(uint16_t addr)
+{
+    //---------
+    Commit();
+    ++Accesses;
+    Cycles += HOST_SIM_CYCLES_PER_ACCESS;
+    Update();
+    Commit();                                                   //!< Left over by the interrupt service routine
+    //---------
+    if(addr == A_TMR0L)
+    {
+        if(SFR(A_TMR0H) != Tmr0H)                               //!< Written by the device since the last latch
+            Tmr0HBuf = SFR(A_TMR0H);
+        SFR(A_TMR0H) = Tmr0H = (uint8_t)(Tmr0 >> 8);            //!< Read latch
+        Tmr0LAccess = 1;
+    }
+    if(addr == A_TMR1L)
+    {
+        if(SFR(A_TMR1H) != Tmr1H)
+            Tmr1HBuf = SFR(A_TMR1H);
+        if(SFR(A_T1CON) & 0x80)
+            SFR(A_TMR1H) = Tmr1H = (uint8_t)(Tmr1 >> 8);        //!< 16 bits read latch
+        Tmr1LAccess = 1;
+    }
+    if(addr == A_TMR3L && (SFR(A_T3CON) & 0x81) == 0x81)
+        SFR(A_TMR3H) = (uint8_t)(Tmr3 >> 8);                    //!< 16 bits read latch
+    if(Hooks[addr - SFR_BASE])
+        Hooks[addr - SFR_BASE](addr);
+    if(addr == A_TXREG || addr == A_RCREG)
+        Pending = addr;
+    //---------
+    return &SFR(addr);
+}
+//-----------------------------------
+
+volatile uint8_t *HostSfrPtr(volatile uint8_t *reg)
+{
+    return HostSfr((uint16_t)(SFR_BASE + (reg - Sfr)));
+}
+//-----------------------------------
+
+void HostSimDelay(uint32_t cycles)
+{
+    //---------
+    uint32_t step;
+    //---------
+    Commit();
+    while(cycles != 0)
+    {
+        step = cycles > 8 ? 8 : cycles;
+        Cycles += step;
+        cycles -= step;
+        Update();
+        Commit();
+    }
+    //---------
+}
+//-----------------------------------
+
+void HostSimSleep(void)
+{
+    //---------
+    uint64_t tout = Cycles + 4000000ULL * 60;
+    //---------
+    Commit();
+    while(!IntRequest(1) && Cycles < tout)
+    {
+        Cycles += 8;
+        Tmr0Last = Cycles;                                      //!< Oscillator stopped: Timer0 and Timer3 frozen, Timer1 counts its own oscillator only
+        Tmr3Last = Cycles;
+        if(!(SFR(A_T1CON) & 0x02))
+            Tmr1Last = Cycles;
+        Update();
+    }
+    //---------
+}
+//-----------------------------------
+
+void HostSimReset(void)
+{
+    //---------
+    memset(Sfr, 0, sizeof(Sfr));
+    memset(Hooks, 0, sizeof(Hooks));
+    memset(Inputs, 0, sizeof(Inputs));
+    SFR(A_TRISA) = SFR(A_TRISA + 1) = SFR(A_TRISA + 2) = SFR(A_TRISA + 3) = 0xFF;
+    SFR(A_TRISA + 4) = 0x07;
+    SFR(A_INTCON2) = 0xF5;
+    SFR(A_TXSTA) = 0x02;
+    //---------
+    Cycles = 0;
+    Accesses = 0;
+    Interrupts = 0;
+    Isr = 0;
+    InIsr = 0;
+    Pending = 0;
+    //---------
+    TxRegFull = 0;
+    TsrBusy = 0;
+    TxCount = 0;
+    RxHead = RxTail = 0;
+    RxFifoCnt = 0;
+    RxLost = 0;
+    //---------
+    SFR(A_T0CON) = 0xFF;
+    Tmr0 = 0;
+    Tmr0Prescaler = 0;
+    Tmr0Last = 0;
+    Tmr0L = Tmr0H = Tmr0HBuf = 0;
+    Tmr0LAccess = 0;
+    Tmr1 = 0;
+    Tmr1Prescaler = 0;
+    Tmr1Last = 0;
+    Tmr1L = Tmr1H = Tmr1HBuf = 0;
+    Tmr1LAccess = 0;
+    Tmr3 = 0;
+    Tmr3Prescaler = 0;
+    Tmr3Last = 0;
+    //---------
+}
+//-----------------------------------
+
+void HostSimSetIsr(void (*isr)(void))
+{
+    Isr = isr;
+}
+//-----------------------------------
+
+void HostSimSetHook(uint16_t addr, HostSfrHookType hook)
+{
+    Hooks[addr - SFR_BASE] = hook;
+}
+//-----------------------------------
+
+uint64_t HostSimCycles(void)
+{
+    return Cycles;
+}
+//-----------------------------------
+
+uint64_t HostSimAccesses(void)
+{
+    return Accesses;
+}
+//-----------------------------------
+
+uint32_t HostSimInterrupts(void)
+{
+    return Interrupts;
+}
+//-----------------------------------
+
+void HostSimRxInject9(const uint16_t *data, uint16_t cnt)
+{
+    //---------
+    if(RxTail == RxHead)
+        RxNext = Cycles + UsartBitCycles() * ((SFR(A_RCSTA) & 0x40) ? 11 : 10);
+    //---------
+    while(cnt != 0 && (RxHead - RxTail) < HOST_SIM_LINE_SIZE)
+    {
+        RxLine[RxHead % HOST_SIM_LINE_SIZE] = *data;
+        ++RxHead;
+        ++data;
+        --cnt;
+    }
+    //---------
+}
+//-----------------------------------
+
+void HostSimRxInject(const uint8_t *data, uint16_t cnt)
+{
+    //---------
+    uint16_t frame;
+    //---------
+    while(cnt != 0)
+    {
+        frame = *data;
+        HostSimRxInject9(&frame, 1);
+        ++data;
+        --cnt;
+    }
+    //---------
+}
+//-----------------------------------
+
+uint8_t HostSimRxIdle(void)
+{
+    Commit();
+    return RxTail == RxHead;
+}
+//-----------------------------------
+
+uint32_t HostSimRxLost(void)
+{
+    Commit();
+    return RxLost;
+}
+//-----------------------------------
+
+uint32_t HostSimTxCapture(uint16_t *data, uint32_t max)
+{
+    //---------
+    Commit();
+    if(data != 0)
+        memcpy(data, TxLine, sizeof(uint16_t) * (max < TxCount ? max : (TxCount < HOST_SIM_LINE_SIZE ? TxCount : HOST_SIM_LINE_SIZE)));
+    //---------
+    return TxCount;
+}
+//-----------------------------------
+
+uint8_t HostSimTxIdle(void)
+{
+    Commit();
+    return !TxRegFull && !TsrBusy;
+}
+//-----------------------------------
+
+void HostSimSetInputs(uint8_t port, uint8_t value)
+{
+    //---------
+    uint8_t old = Inputs[port];
+    uint8_t rise = (uint8_t)(~old & value);
+    uint8_t fall = (uint8_t)(old & ~value);
+    uint8_t edg = SFR(A_INTCON2);
+    //---------
+    Inputs[port] = value;
+    if(port == 1)
+    {
+        if(((edg & 0x40) ? rise : fall) & 0x01)
+            SFR(A_INTCON) |= 0x02;                              //!< INT0IF
+        if(((edg & 0x20) ? rise : fall) & 0x02)
+            SFR(A_INTCON3) |= 0x01;                             //!< INT1IF
+        if(((edg & 0x10) ? rise : fall) & 0x04)
+            SFR(A_INTCON3) |= 0x02;                             //!< INT2IF
+        if((rise | fall) & 0xF0 & SFR(A_TRISA + 1))
+            SFR(A_INTCON) |= 0x01;                              //!< RBIF
+    }
+    //---------
+    Commit();
+    Update();
+    //---------
+}
+//-----------------------------------
+
+uint8_t HostSimRunUntil(uint8_t (*done)(void), uint64_t tout)
+{
+    //---------
+    uint64_t end = Cycles + tout;
+    //---------
+    while(Cycles < end)
+    {
+        if(done && done())
+            return 1;
+        HostSimDelay(8);
+    }
+    //---------
+    return done ? done() : 0;
+}
+//-----------------------------------
@@ -0,0 +1,207 @@
+/**
+ ******************************************************************************
+ * @file            HostSim.h
+ * @author          Maxime
+ * @brief           header file for the host PIC18F452 register model
+ * @brief           This file provides the functions used by host programs
+ *                  (benchmarks, tools) to drive the simulated device:
+ *                      - Simulated time and register access counters
+ *                      - USART line stimuli and capture
+ *                      - GPIO input pins
+ *                      - Timer0 (internal clock, 8/16 bits, prescaler, increment inhibit after a write)
+ *                      - Timer1 (internal clock or 32.768 kHz oscillator, 16 bits, prescaler)
+ *                      - Timer3 (internal clock, 16 bits, prescaler)
+ *                      - Interrupt service routine registration
+ *
+ * @note            The model is transaction based, not cycle accurate:
+ *                      - Every register access costs @ref HOST_SIM_CYCLES_PER_ACCESS
+ *                        instruction cycles.
+ *                      - Every interrupt costs @ref HOST_SIM_ISR_CYCLES instruction
+ *                        cycles of context saving/restoring, on top of the handler.
+ *                  The access counts are exact and deterministic, the cycle counts
+ *                  are estimates good enough to compare implementations.
+ *
+ * @note            TXREG is considered written and RCREG read whenever they are
+ *                  accessed, as the API never does otherwise.
+ *
+ * @note            History:
+ *                  - Oct 16, 2026: Initial release
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+#ifndef HOSTSIM_H
+#define	HOSTSIM_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------
+#include <xc.h>
+#include <stdint.h>
+//-----------------------------------
+
+/** @defgroup HOST_SIM_CONFIG Host model settings
+ * @{
+ */
+#define HOST_SIM_CYCLES_PER_ACCESS                  2                   //!< Instruction cycles charged per register access
+#define HOST_SIM_ISR_CYCLES                         30                  //!< Instruction cycles charged per interrupt for context saving/restoring
+#define HOST_SIM_LINE_SIZE                          4096                //!< Size of the USART stimulus and capture buffers
+#define HOST_SIM_T1OSC_HZ                           32768ULL            //!< Timer1 oscillator frequency
+/**
+  * @}
+  */
+
+/**
+ * @brief   Register access hook type, see HostSimSetHook()
+ *
+ */
+typedef void (*HostSfrHookType)(uint16_t addr);
+
+//-----------------------------------
+/**
+ * @brief   Reset the simulated device: registers, time, counters and line buffers
+ * @param   none
+ * @retval  none
+ */
+extern void HostSimReset(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Register the interrupt service routine of the simulated device
+ * @param   isr: function called whenever an enabled interrupt flag is set and GIE is set
+ * @retval  none
+ */
+extern void HostSimSetIsr(void (*isr)(void));
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Register a function called on every access to a given register
+ * @param   addr: register address
+ * @param   hook: function to call, NULL to remove the hook
+ * @retval  none
+ * @note    The hook is called before the access, it may update the register content.
+ */
+extern void HostSimSetHook(uint16_t addr, HostSfrHookType hook);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Get the number of instruction cycles elapsed since the last reset
+ * @param   none
+ * @retval  instruction cycles
+ */
+extern uint64_t HostSimCycles(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Get the number of register accesses since the last reset
+ * @param   none
+ * @retval  register accesses
+ */
+extern uint64_t HostSimAccesses(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Get the number of interrupts serviced since the last reset
+ * @param   none
+ * @retval  interrupts serviced
+ */
+extern uint32_t HostSimInterrupts(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Queue 8 bits frames on the USART RX line
+ * @param   data: bytes to send to the device
+ * @param   cnt: number of bytes
+ * @retval  none
+ * @note    Frames are sent back to back at the baud rate currently programmed in the device.
+ */
+extern void HostSimRxInject(const uint8_t *data, uint16_t cnt);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Queue 9 bits frames on the USART RX line
+ * @param   data: 9 bits values to send to the device
+ * @param   cnt: number of values
+ * @retval  none
+ * @note    With ADDEN set, frames whose 9th bit is clear are ignored by the receiver.
+ */
+extern void HostSimRxInject9(const uint16_t *data, uint16_t cnt);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Check whether all the queued RX frames have been delivered
+ * @param   none
+ * @retval  1: RX line idle, 0: frames pending
+ */
+extern uint8_t HostSimRxIdle(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Get the number of RX frames lost by the USART (overrun or receiver disabled)
+ * @param   none
+ * @retval  frames lost
+ */
+extern uint32_t HostSimRxLost(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Get the frames sent by the device on the USART TX line
+ * @param   data: buffer to copy the frames into, 9th bit included. Can be NULL.
+ * @param   max: buffer size
+ * @retval  number of frames sent since the last reset
+ */
+extern uint32_t HostSimTxCapture(uint16_t *data, uint32_t max);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Check whether the USART transmitter is idle (TXREG and shift register empty)
+ * @param   none
+ * @retval  1: idle, 0: busy
+ */
+extern uint8_t HostSimTxIdle(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Drive the external level of an I/O port
+ * @param   port: I/O port name constant (See IO_PORT_CONSTANTS in PIC18Types.h)
+ * @param   value: pin levels, only the pins configured as inputs are affected
+ * @retval  none
+ * @note    A falling/rising edge on RB0 sets INT0IF according to INTEDG0.
+ */
+extern void HostSimSetInputs(uint8_t port, uint8_t value);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Run the simulated device until a condition is met or a time-out expires
+ * @param   done: condition function, NULL to just wait for the time-out
+ * @param   tout: time-out in instruction cycles
+ * @retval  1: condition met, 0: time-out
+ */
+extern uint8_t HostSimRunUntil(uint8_t (*done)(void), uint64_t tout);
+//-----------------------------------
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* HOSTSIM_H */
@@ -0,0 +1,1463 @@
+/**
+ ******************************************************************************
+ * @file            PIC18Sim.c
+ * @author          Maxime
+ * @brief           PIC18F452 instruction set simulator for the production image
+ * @brief           Loads the Intel HEX file produced by MPLAB/XC8 and the .sym
+ *                  symbol file, executes the program with the instruction timings
+ *                  of the device datasheet and reports, for each function symbol:
+ *                      - calls: number of calls (CALL/RCALL to the function entry,
+ *                        interrupt vector for the interrupt service routine)
+ *                      - incl.*: cycles from the entry to the matching return,
+ *                        callees and interrupts included (total, min, max, average)
+ *                      - self: cycles spent executing the function own instructions
+ *
+ * @note            Modeled peripherals:
+ *                      - Timer0 (8/16 bits, prescaler, TMR0H buffer)
+ *                      - Timer1 and Timer3 (prescaler, 16 bits read/write buffer)
+ *                      - Timer2 (prescaler, PR2 match, postscaler)
+ *                      - CCP1/CCP2 compare modes on Timer1/Timer3
+ *                      - USART asynchronous mode (baud rate, 2 bytes RX FIFO, OERR,
+ *                        address detection, TXIF/TRMT/RCIF)
+ *                      - PORTB inputs with INT0/INT1/INT2 edges and RB change
+ *                      - Interrupts, with or without priorities
+ *                  Not modeled: ADC, MSSP, PSP, EEPROM/flash writes, watchdog,
+ *                  external timer clocks.
+ *
+ * @note            Usage:
+ @verbatim
+    pic18sim [options] <image.hex> [image.sym]
+        -f <MHz>            Oscillator frequency, default 16
+        -t <ms>             Simulated time, default 1000
+        -d <ms>             Delay before the stimuli start, default 10
+        -u <text>           Send text on the USART RX line, at the baud rate programmed by the firmware
+        -i <us>             Toggle the RB0/INT0 input every <us> microseconds
+        -s <baud>:<text>    Send text as 8N1 serial frames on the RB0/INT0 input (software UART)
+        -x                  Print the text sent by the firmware on the USART TX line
+        -n <count>          Number of functions to report, default all
+        -l <file>           Write the pin events to file, one per line (See "make suart-check"):
+                                <cycle> O <port><pin> <level>   output pin transition
+                                <cycle> I B<pin> <level>        input pin transition
+                                <cycle> R B                     PORTB read
+                                <cycle> X                       return from interrupt
+ @endverbatim
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+//-----------------------------------
+
+//-----------------------------------
+#define ROM_SIZE                0x8000                          //!< 32KB program memory
+#define RAM_SIZE                0x1000                          //!< 4KB data memory space, SFRs from 0xF80
+#define STACK_SIZE              31
+#define MAX_FUNCS               512
+#define MAX_FRAMES              64
+#define MAX_EVENTS              65536
+#define LINE_SIZE               4096
+
+// Special function registers
+#define R_PORTA                 0xF80
+#define R_PORTB                 0xF81
+#define R_LATA                  0xF89
+#define R_TRISA                 0xF92
+#define R_PIE1                  0xF9D
+#define R_PIR1                  0xF9E
+#define R_IPR1                  0xF9F
+#define R_PIE2                  0xFA0
+#define R_PIR2                  0xFA1
+#define R_IPR2                  0xFA2
+#define R_RCSTA                 0xFAB
+#define R_TXSTA                 0xFAC
+#define R_TXREG                 0xFAD
+#define R_RCREG                 0xFAE
+#define R_SPBRG                 0xFAF
+#define R_T3CON                 0xFB1
+#define R_TMR3L                 0xFB2
+#define R_TMR3H                 0xFB3
+#define R_CCP2CON               0xFBA
+#define R_CCPR2L                0xFBB
+#define R_CCPR2H                0xFBC
+#define R_CCP1CON               0xFBD
+#define R_CCPR1L                0xFBE
+#define R_CCPR1H                0xFBF
+#define R_T2CON                 0xFCA
+#define R_PR2                   0xFCB
+#define R_TMR2                  0xFCC
+#define R_T1CON                 0xFCD
+#define R_TMR1L                 0xFCE
+#define R_TMR1H                 0xFCF
+#define R_RCON                  0xFD0
+#define R_T0CON                 0xFD5
+#define R_TMR0L                 0xFD6
+#define R_TMR0H                 0xFD7
+#define R_STATUS                0xFD8
+#define R_FSR2L                 0xFD9
+#define R_FSR2H                 0xFDA
+#define R_PLUSW2                0xFDB
+#define R_PREINC2               0xFDC
+#define R_POSTDEC2              0xFDD
+#define R_POSTINC2              0xFDE
+#define R_INDF2                 0xFDF
+#define R_BSR                   0xFE0
+#define R_FSR1L                 0xFE1
+#define R_FSR1H                 0xFE2
+#define R_PLUSW1                0xFE3
+#define R_PREINC1               0xFE4
+#define R_POSTDEC1              0xFE5
+#define R_POSTINC1              0xFE6
+#define R_INDF1                 0xFE7
+#define R_WREG                  0xFE8
+#define R_FSR0L                 0xFE9
+#define R_FSR0H                 0xFEA
+#define R_PLUSW0                0xFEB
+#define R_PREINC0               0xFEC
+#define R_POSTDEC0              0xFED
+#define R_POSTINC0              0xFEE
+#define R_INDF0                 0xFEF
+#define R_INTCON3               0xFF0
+#define R_INTCON2               0xFF1
+#define R_INTCON                0xFF2
+#define R_PRODL                 0xFF3
+#define R_PRODH                 0xFF4
+#define R_TABLAT                0xFF5
+#define R_TBLPTRL               0xFF6
+#define R_TBLPTRH               0xFF7
+#define R_TBLPTRU               0xFF8
+#define R_PCL                   0xFF9
+#define R_PCLATH                0xFFA
+#define R_PCLATU                0xFFB
+#define R_STKPTR                0xFFC
+#define R_TOSL                  0xFFD
+#define R_TOSH                  0xFFE
+#define R_TOSU                  0xFFF
+
+// STATUS bits
+#define S_C                     0x01
+#define S_DC                    0x02
+#define S_Z                     0x04
+#define S_OV                    0x08
+#define S_N                     0x10
+//-----------------------------------
+
+/**
+ * @brief   Function symbol type
+ *
+ */
+typedef struct
+{
+    char Name[64];
+    uint32_t Start;                                             //!< Entry address
+    uint32_t End;                                               //!< First address after the function
+    uint32_t Calls;
+    uint32_t Returns;                                           //!< Calls completed, the inclusive cycles are for these
+    uint64_t Incl;                                              //!< Inclusive cycles, all calls
+    uint64_t InclMin;
+    uint64_t InclMax;
+    uint64_t Self;                                              //!< Cycles of the function own instructions
+}FuncType;
+
+/**
+ * @brief   Shadow call stack frame type
+ *
+ */
+typedef struct
+{
+    int Func;                                                   //!< Index in Funcs[], -1 when unknown
+    uint32_t Ret;                                               //!< Return address
+    uint64_t Entry;                                             //!< Cycle count at entry
+}FrameType;
+
+/**
+ * @brief   Input pin event type
+ *
+ */
+typedef struct
+{
+    uint64_t Cycle;
+    uint8_t Level;                                              //!< RB0 level
+}EventType;
+//-----------------------------------
+static uint8_t Rom[ROM_SIZE];
+static uint8_t Config[16];                                      //!< Configuration bytes 0x300000
+static uint8_t Ram[RAM_SIZE];
+static uint32_t Pc;
+static uint32_t Stack[STACK_SIZE];
+static uint8_t ShadowW, ShadowStatus, ShadowBsr;                //!< Fast register stack
+static uint8_t Sleeping = 0;
+static uint64_t Cycles = 0;
+static uint64_t Instructions = 0;
+//-----------------------------------
+static FuncType Funcs[MAX_FUNCS];
+static int FuncCnt = 0;
+static FrameType Frames[MAX_FRAMES];
+static int FrameCnt = 0;
+static uint64_t IsrCycles = 0;                                  //!< Cycles spent in interrupt context
+static uint32_t IsrCount = 0;
+static uint8_t InIsr = 0;                                       //!< Interrupt nesting depth
+static uint8_t IsrLevels = 0;                                   //!< Bit 0: low priority active, bit 1: high priority active
+//-----------------------------------
+static uint8_t Tmr0HBuf, Tmr1HBuf, Tmr3HBuf;                    //!< 16 bits timers high byte buffers
+static uint16_t Tmr0Pre, Tmr1Pre, Tmr2Pre, Tmr3Pre;             //!< Prescaler counters
+static uint8_t Tmr2Post;                                        //!< Timer2 postscaler counter
+static uint8_t Tmr0Inhibit;                                     //!< Timer0 increment inhibit after a write
+static uint8_t PinB = 0xFF;                                     //!< PORTB external levels
+static EventType Events[MAX_EVENTS];
+static uint32_t EventCnt = 0, EventIdx = 0;
+//-----------------------------------
+static uint8_t TxRegFull = 0, TsrBusy = 0;
+static uint16_t TxRegData, TsrData;
+static uint64_t TsrEnd;
+static char TxLine[LINE_SIZE];
+static uint32_t TxCount = 0;
+static const char *RxText = NULL;
+static uint64_t RxNext;
+static uint16_t RxFifo[2];
+static uint8_t RxFifoCnt = 0;
+static uint32_t RxLost = 0;
+//-----------------------------------
+static uint32_t PinEdges[5][8];                                 //!< Output pin transitions
+static FILE *Log = NULL;                                        //!< Pin events log, -l option
+//-----------------------------------
+
+static uint16_t Word(uint32_t addr)
+{
+    addr &= ROM_SIZE - 2;
+    return (uint16_t)(Rom[addr] | (Rom[addr + 1] << 8));
+}
+//-----------------------------------
+
+static int FindFunc(uint32_t addr)
+{
+    //---------
+    int lo = 0, hi = FuncCnt - 1, mid;
+    //---------
+    while(lo <= hi)
+    {
+        mid = (lo + hi) / 2;
+        if(addr < Funcs[mid].Start)
+            hi = mid - 1;
+        else if(addr >= Funcs[mid].End)
+            lo = mid + 1;
+        else
+            return mid;
+    }
+    return -1;
+}
+//-----------------------------------
+
+static void PushFrame(uint32_t target, uint32_t ret)
+{
+    //---------
+    int f = FindFunc(target);
+    //---------
+    if(f >= 0 && Funcs[f].Start != target)
+        f = -1;                                                 //!< Jump inside a function, not a call
+    if(FrameCnt < MAX_FRAMES)
+    {
+        Frames[FrameCnt].Func = f;
+        Frames[FrameCnt].Ret = ret;
+        Frames[FrameCnt].Entry = Cycles;
+        ++FrameCnt;
+    }
+    if(f >= 0)
+        ++Funcs[f].Calls;
+    //---------
+}
+//-----------------------------------
+
+static void PopFrame(uint32_t ret)
+{
+    //---------
+    int i;
+    uint64_t incl;
+    FuncType *fn;
+    //---------
+    for(i = FrameCnt - 1; i >= 0; --i)                          //!< Unwind up to the frame returning there
+    {
+        if(Frames[i].Ret == ret)
+            break;
+    }
+    if(i < 0)
+        return;
+    while(FrameCnt > i)
+    {
+        --FrameCnt;
+        if(Frames[FrameCnt].Func < 0)
+            continue;
+        fn = &Funcs[Frames[FrameCnt].Func];
+        incl = Cycles - Frames[FrameCnt].Entry;
+        ++fn->Returns;
+        fn->Incl += incl;
+        if(fn->InclMin == 0 || incl < fn->InclMin)
+            fn->InclMin = incl;
+        if(incl > fn->InclMax)
+            fn->InclMax = incl;
+    }
+    //---------
+}
+//-----------------------------------
+
+//-----------------------------------
+// Hardware stack
+//-----------------------------------
+static void Push(uint32_t addr)
+{
+    //---------
+    uint8_t sp = Ram[R_STKPTR] & 0x1F;
+    //---------
+    if(sp >= STACK_SIZE)
+    {
+        Ram[R_STKPTR] |= 0x80;                                  //!< STKFUL
+        return;
+    }
+    ++sp;
+    Stack[sp - 1] = addr & 0x1FFFFF;
+    if(sp == STACK_SIZE)
+        Ram[R_STKPTR] |= 0x80;
+    Ram[R_STKPTR] = (uint8_t)((Ram[R_STKPTR] & 0xC0) | sp);
+    //---------
+}
+//-----------------------------------
+
+static uint32_t Pop(void)
+{
+    //---------
+    uint8_t sp = Ram[R_STKPTR] & 0x1F;
+    uint32_t addr;
+    //---------
+    if(sp == 0)
+    {
+        Ram[R_STKPTR] |= 0x40;                                  //!< STKUNF
+        return 0;
+    }
+    addr = Stack[sp - 1];
+    --sp;
+    Ram[R_STKPTR] = (uint8_t)((Ram[R_STKPTR] & 0xC0) | sp);
+    //---------
+    return addr;
+}
+//-----------------------------------
+
+//-----------------------------------
+// Peripherals
+//-----------------------------------
+static uint32_t UsartBitCycles(void)
+{
+    //---------
+    uint32_t brg = (uint32_t)Ram[R_SPBRG] + 1;
+    //---------
+    if(Ram[R_TXSTA] & 0x10)
+        return brg;
+    return (Ram[R_TXSTA] & 0x04) ? 4 * brg : 16 * brg;
+}
+//-----------------------------------
+
+static void UsartUpdate(void)
+{
+    //---------
+    uint64_t start = Cycles;
+    uint8_t rcsta = Ram[R_RCSTA];
+    uint16_t frame;
+    //---------
+    if(TsrBusy && Cycles >= TsrEnd)
+    {
+        if(TxCount < LINE_SIZE - 1)
+            TxLine[TxCount] = (char)TsrData;
+        ++TxCount;
+        TsrBusy = 0;
+        start = TsrEnd;
+    }
+    if(!TsrBusy && TxRegFull && (Ram[R_TXSTA] & 0x20) && (rcsta & 0x80))
+    {
+        TsrData = TxRegData;
+        TsrBusy = 1;
+        TxRegFull = 0;
+        TsrEnd = start + UsartBitCycles() * ((Ram[R_TXSTA] & 0x40) ? 11 : 10);
+    }
+    Ram[R_PIR1] = (uint8_t)(TxRegFull ? (Ram[R_PIR1] & ~0x10) : (Ram[R_PIR1] | 0x10));
+    Ram[R_TXSTA] = (uint8_t)(TsrBusy ? (Ram[R_TXSTA] & ~0x02) : (Ram[R_TXSTA] | 0x02));
+    //---------
+    if(!(rcsta & 0x10))
+        Ram[R_RCSTA] &= (uint8_t)~0x02;
+    while(RxText && *RxText && Cycles >= RxNext)
+    {
+        frame = (uint8_t)*RxText++;
+        RxNext += UsartBitCycles() * 10;
+        rcsta = Ram[R_RCSTA];
+        if(!(rcsta & 0x80) || !(rcsta & 0x10))
+            ++RxLost;
+        else if((rcsta & 0x02) || RxFifoCnt == 2)
+        {
+            Ram[R_RCSTA] |= 0x02;
+            ++RxLost;
+        }
+        else if(!((rcsta & 0x40) && (rcsta & 0x08) && !(frame & 0x100)))
+            RxFifo[RxFifoCnt++] = frame;
+    }
+    if(RxFifoCnt)
+    {
+        Ram[R_PIR1] |= 0x20;
+        Ram[R_RCREG] = (uint8_t)RxFifo[0];
+    }
+    else
+        Ram[R_PIR1] &= (uint8_t)~0x20;
+    //---------
+}
+//-----------------------------------
+
+static void SetInputB(uint8_t level)
+{
+    //---------
+    uint8_t old = PinB;
+    uint8_t rise = (uint8_t)(~old & level), fall = (uint8_t)(old & ~level);
+    uint8_t edg = Ram[R_INTCON2], b;
+    //---------
+    if(Log)
+    {
+        for(b = 0; b < 8; ++b)
+            if((rise | fall) & (1u << b))
+                fprintf(Log, "%llu I B%u %u\n", (unsigned long long)Cycles, b, (level >> b) & 1u);
+    }
+    PinB = level;
+    if(((edg & 0x40) ? rise : fall) & 0x01)
+        Ram[R_INTCON] |= 0x02;
+    if(((edg & 0x20) ? rise : fall) & 0x02)
+        Ram[R_INTCON3] |= 0x01;
+    if(((edg & 0x10) ? rise : fall) & 0x04)
+        Ram[R_INTCON3] |= 0x02;
+    if((rise | fall) & 0xF0 & Ram[R_TRISA + 1])
+        Ram[R_INTCON] |= 0x01;
+    //---------
+}
+//-----------------------------------
+
+static uint16_t Timer16Tick(uint16_t addrL, uint16_t *pre, uint16_t div)
+{
+    //---------
+    uint16_t v;
+    //---------
+    if(++*pre < div)
+        return 1;
+    *pre = 0;
+    v = (uint16_t)(Ram[addrL] | (Ram[addrL + 1] << 8));
+    ++v;
+    Ram[addrL] = (uint8_t)v;
+    Ram[addrL + 1] = (uint8_t)(v >> 8);
+    //---------
+    return v;
+}
+//-----------------------------------
+
+static void CompareCheck(uint16_t ccpcon, uint16_t ccpr, uint16_t tmr, uint16_t flagReg, uint8_t flag)
+{
+    //---------
+    uint8_t mode = Ram[ccpcon] & 0x0F;
+    //---------
+    if(mode < 0x08 || mode > 0x0B)
+        return;
+    if(Ram[ccpr] != Ram[tmr] || Ram[ccpr + 1] != Ram[tmr + 1])
+        return;
+    Ram[flagReg] |= flag;
+    if(mode == 0x0B)
+    {
+        Ram[tmr] = 0;                                           //!< Special event trigger resets the timer
+        Ram[tmr + 1] = 0;
+    }
+    //---------
+}
+//-----------------------------------
+
+static void PeripheralsTick(void)
+{
+    //---------
+    uint8_t t0con = Ram[R_T0CON], t1con = Ram[R_T1CON], t2con = Ram[R_T2CON], t3con = Ram[R_T3CON];
+    uint16_t v;
+    //---------
+    if((t0con & 0x80) && !(t0con & 0x20) && !Sleeping)
+    {
+        if(Tmr0Inhibit)
+            --Tmr0Inhibit;
+        else if(++Tmr0Pre >= ((t0con & 0x08) ? 1 : (2u << (t0con & 0x07))))
+        {
+            Tmr0Pre = 0;
+            if(t0con & 0x40)
+            {
+                if(++Ram[R_TMR0L] == 0)
+                    Ram[R_INTCON] |= 0x04;
+            }
+            else
+            {
+                v = (uint16_t)(Ram[R_TMR0L] | (Ram[R_TMR0H] << 8));
+                ++v;
+                Ram[R_TMR0L] = (uint8_t)v;
+                Ram[R_TMR0H] = (uint8_t)(v >> 8);
+                if(v == 0)
+                    Ram[R_INTCON] |= 0x04;
+            }
+        }
+    }
+    //---------
+    if((t1con & 0x01) && !(t1con & 0x02) && !Sleeping)
+    {
+        v = Timer16Tick(R_TMR1L, &Tmr1Pre, (uint16_t)(1u << ((t1con >> 4) & 0x03)));
+        if(v == 0)
+            Ram[R_PIR1] |= 0x01;
+        if(Tmr1Pre == 0)
+        {
+            CompareCheck(R_CCP1CON, R_CCPR1L, R_TMR1L, R_PIR1, 0x04);
+            if(!(t3con & 0x40))
+                CompareCheck(R_CCP2CON, R_CCPR2L, R_TMR1L, R_PIR2, 0x01);
+        }
+    }
+    if((t3con & 0x01) && !(t3con & 0x02) && !Sleeping)
+    {
+        v = Timer16Tick(R_TMR3L, &Tmr3Pre, (uint16_t)(1u << ((t3con >> 4) & 0x03)));
+        if(v == 0)
+            Ram[R_PIR2] |= 0x02;
+        if(Tmr3Pre == 0 && (t3con & 0x40))
+            CompareCheck(R_CCP2CON, R_CCPR2L, R_TMR3L, R_PIR2, 0x01);
+    }
+    //---------
+    if((t2con & 0x04) && !Sleeping)
+    {
+        if(++Tmr2Pre >= ((t2con & 0x02) ? 16 : ((t2con & 0x01) ? 4 : 1)))
+        {
+            Tmr2Pre = 0;
+            if(Ram[R_TMR2] == Ram[R_PR2])
+            {
+                Ram[R_TMR2] = 0;
+                if(++Tmr2Post > ((t2con >> 3) & 0x0F))
+                {
+                    Tmr2Post = 0;
+                    Ram[R_PIR1] |= 0x02;
+                }
+            }
+            else
+                ++Ram[R_TMR2];
+        }
+    }
+    //---------
+    while(EventIdx < EventCnt && Cycles >= Events[EventIdx].Cycle)
+    {
+        SetInputB((uint8_t)((PinB & 0xFE) | Events[EventIdx].Level));
+        ++EventIdx;
+    }
+    //---------
+}
+//-----------------------------------
+
+static void Tick(uint32_t n)
+{
+    //---------
+    while(n--)
+    {
+        ++Cycles;
+        if(InIsr)
+            ++IsrCycles;
+        PeripheralsTick();
+    }
+    UsartUpdate();
+    //---------
+}
+//-----------------------------------
+
+//-----------------------------------
+// Data memory
+//-----------------------------------
+static uint16_t Fsr(int n)
+{
+    static const uint16_t lo[3] = { R_FSR0L, R_FSR1L, R_FSR2L };
+    return (uint16_t)((Ram[lo[n]] | (Ram[lo[n] + 1] << 8)) & 0x0FFF);
+}
+//-----------------------------------
+
+static void FsrSet(int n, uint16_t v)
+{
+    static const uint16_t lo[3] = { R_FSR0L, R_FSR1L, R_FSR2L };
+    Ram[lo[n]] = (uint8_t)v;
+    Ram[lo[n] + 1] = (uint8_t)((v >> 8) & 0x0F);
+}
+//-----------------------------------
+
+/**
+ * @brief   Resolve an indirect addressing register into the target address
+ * @retval  0: not an indirect register
+ */
+static int Indirect(uint16_t addr, uint16_t *target)
+{
+    //---------
+    int n;
+    uint16_t f;
+    //---------
+    if(addr >= R_PLUSW2 && addr <= R_INDF2)
+        n = 2;
+    else if(addr >= R_PLUSW1 && addr <= R_INDF1)
+        n = 1;
+    else if(addr >= R_PLUSW0 && addr <= R_INDF0)
+        n = 0;
+    else
+        return 0;
+    //---------
+    f = Fsr(n);
+    switch(addr & 0x07)
+    {
+        case 0x07: case 0x03: case 0x0F:                        //!< INDFn
+            *target = f; break;
+        case 0x06: case 0x02: case 0x0E:                        //!< POSTINCn
+            *target = f; FsrSet(n, (uint16_t)(f + 1)); break;
+        case 0x05: case 0x01: case 0x0D:                        //!< POSTDECn
+            *target = f; FsrSet(n, (uint16_t)(f - 1)); break;
+        case 0x04: case 0x0C:                                   //!< PREINCn
+            FsrSet(n, (uint16_t)(f + 1)); *target = Fsr(n); break;
+        default:                                                //!< PLUSWn
+            *target = (uint16_t)((f + (int8_t)Ram[R_WREG]) & 0x0FFF); break;
+    }
+    //---------
+    return 1;
+}
+//-----------------------------------
+
+static uint8_t Read(uint16_t addr)
+{
+    //---------
+    uint16_t t;
+    uint8_t v;
+    //---------
+    if(Indirect(addr, &t))
+    {
+        if(Indirect(t, &t))
+            return 0;                                           //!< Indirect access to an indirect register reads 0
+        addr = t;
+    }
+    //---------
+    switch(addr)
+    {
+        case R_PORTB:
+            if(Log)
+                fprintf(Log, "%llu R B\n", (unsigned long long)Cycles);
+            return (uint8_t)((Ram[R_LATA + 1] & ~Ram[R_TRISA + 1]) | (PinB & Ram[R_TRISA + 1]));
+        case R_PCL:
+            Ram[R_PCLATH] = (uint8_t)(Pc >> 8);
+            Ram[R_PCLATU] = (uint8_t)(Pc >> 16);
+            return (uint8_t)Pc;
+        case R_TMR0L:
+            Tmr0HBuf = Ram[R_TMR0H];
+            return Ram[R_TMR0L];
+        case R_TMR0H:
+            return (Ram[R_T0CON] & 0x40) ? 0 : Tmr0HBuf;
+        case R_TMR1L:
+            Tmr1HBuf = Ram[R_TMR1H];
+            return Ram[R_TMR1L];
+        case R_TMR1H:
+            return (Ram[R_T1CON] & 0x80) ? Tmr1HBuf : Ram[R_TMR1H];
+        case R_TMR3L:
+            Tmr3HBuf = Ram[R_TMR3H];
+            return Ram[R_TMR3L];
+        case R_TMR3H:
+            return (Ram[R_T3CON] & 0x80) ? Tmr3HBuf : Ram[R_TMR3H];
+        case R_RCREG:
+            v = Ram[R_RCREG];
+            if(RxFifoCnt)
+            {
+                RxFifo[0] = RxFifo[1];
+                --RxFifoCnt;
+                UsartUpdate();
+            }
+            return v;
+        case R_RCSTA:
+            return (uint8_t)((Ram[R_RCSTA] & 0xFE) | (RxFifoCnt ? ((RxFifo[0] >> 8) & 0x01) : 0));
+        case R_TOSL:
+            return (Ram[R_STKPTR] & 0x1F) ? (uint8_t)Stack[(Ram[R_STKPTR] & 0x1F) - 1] : 0;
+        case R_TOSH:
+            return (Ram[R_STKPTR] & 0x1F) ? (uint8_t)(Stack[(Ram[R_STKPTR] & 0x1F) - 1] >> 8) : 0;
+        case R_TOSU:
+            return (Ram[R_STKPTR] & 0x1F) ? (uint8_t)(Stack[(Ram[R_STKPTR] & 0x1F) - 1] >> 16) : 0;
+        default:
+            break;
+    }
+    return Ram[addr];
+}
+//-----------------------------------
+
+static void Write(uint16_t addr, uint8_t v)
+{
+    //---------
+    uint16_t t;
+    uint8_t sp;
+    //---------
+    if(Indirect(addr, &t))
+    {
+        if(Indirect(t, &t))
+            return;
+        addr = t;
+    }
+    //---------
+    sp = Ram[R_STKPTR] & 0x1F;
+    switch(addr)
+    {
+        case R_PORTA: case R_PORTA + 1: case R_PORTA + 2: case R_PORTA + 3: case R_PORTA + 4:
+            addr = (uint16_t)(addr + (R_LATA - R_PORTA));       //!< Writing PORTx writes LATx
+            /* fall through */
+        case R_LATA: case R_LATA + 1: case R_LATA + 2: case R_LATA + 3: case R_LATA + 4:
+        {
+            uint8_t diff = (uint8_t)(Ram[addr] ^ v), b;
+            for(b = 0; b < 8; ++b)
+                if(diff & (1u << b))
+                {
+                    ++PinEdges[addr - R_LATA][b];
+                    if(Log)
+                        fprintf(Log, "%llu O %c%u %u\n", (unsigned long long)Cycles, 'A' + (addr - R_LATA), b, (v >> b) & 1u);
+                }
+            Ram[addr] = v;
+            return;
+        }
+        case R_PCL:
+            Ram[R_PCL] = v;
+            Pc = ((uint32_t)Ram[R_PCLATU] << 16) | ((uint32_t)Ram[R_PCLATH] << 8) | (v & 0xFE);
+            Tick(1);                                            //!< Computed jump takes one more cycle
+            return;
+        case R_TMR0L:
+            Ram[R_TMR0L] = v;
+            if(!(Ram[R_T0CON] & 0x40))
+                Ram[R_TMR0H] = Tmr0HBuf;
+            Tmr0Pre = 0;
+            Tmr0Inhibit = 2;
+            return;
+        case R_TMR0H:
+            Tmr0HBuf = v;
+            return;
+        case R_TMR1H:
+            if(Ram[R_T1CON] & 0x80) { Tmr1HBuf = v; return; }
+            break;
+        case R_TMR1L:
+            if(Ram[R_T1CON] & 0x80) Ram[R_TMR1H] = Tmr1HBuf;
+            break;
+        case R_TMR3H:
+            if(Ram[R_T3CON] & 0x80) { Tmr3HBuf = v; return; }
+            break;
+        case R_TMR3L:
+            if(Ram[R_T3CON] & 0x80) Ram[R_TMR3H] = Tmr3HBuf;
+            break;
+        case R_T2CON:
+            Tmr2Pre = 0;
+            Tmr2Post = 0;
+            break;
+        case R_TXREG:
+            Ram[R_TXREG] = v;
+            TxRegData = (uint16_t)(v | ((Ram[R_TXSTA] & 0x01) << 8));
+            TxRegFull = 1;
+            UsartUpdate();
+            return;
+        case R_PIR1:
+            Ram[R_PIR1] = (uint8_t)((v & ~0x30) | (Ram[R_PIR1] & 0x30));   //!< TXIF and RCIF are read only
+            return;
+        case R_TOSL:
+            if(sp) Stack[sp - 1] = (Stack[sp - 1] & 0x1FFF00) | v;
+            return;
+        case R_TOSH:
+            if(sp) Stack[sp - 1] = (Stack[sp - 1] & 0x1F00FF) | ((uint32_t)v << 8);
+            return;
+        case R_TOSU:
+            if(sp) Stack[sp - 1] = (Stack[sp - 1] & 0x00FFFF) | ((uint32_t)(v & 0x1F) << 16);
+            return;
+        case R_STKPTR:
+            Ram[R_STKPTR] = (uint8_t)((Ram[R_STKPTR] & v & 0xC0) | (v & 0x1F));   //!< STKFUL/STKUNF can only be cleared
+            return;
+        case R_BSR:
+            v &= 0x0F;
+            break;
+        default:
+            break;
+    }
+    Ram[addr] = v;
+    //---------
+}
+//-----------------------------------
+
+//-----------------------------------
+// Instruction execution
+//-----------------------------------
+static uint16_t FileAddr(uint16_t op)
+{
+    //---------
+    uint8_t f = (uint8_t)op;
+    //---------
+    if(op & 0x0100)
+        return (uint16_t)((Ram[R_BSR] << 8) | f);               //!< Banked
+    return (uint16_t)(f < 0x80 ? f : (0xF00 | f));              //!< Access bank
+}
+//-----------------------------------
+
+static uint8_t Add(uint8_t a, uint8_t b, uint8_t cin, uint8_t flags)
+{
+    //---------
+    uint16_t r = (uint16_t)(a + b + cin);
+    uint8_t s = Ram[R_STATUS] & (uint8_t)~flags;
+    uint8_t res = (uint8_t)r;
+    //---------
+    if(r & 0x100) s |= S_C;
+    if(((a & 0x0F) + (b & 0x0F) + cin) & 0x10) s |= S_DC;
+    if(res == 0) s |= S_Z;
+    if(~(a ^ b) & (a ^ res) & 0x80) s |= S_OV;
+    if(res & 0x80) s |= S_N;
+    Ram[R_STATUS] = (uint8_t)(s & 0x1F);
+    //---------
+    return res;
+}
+//-----------------------------------
+
+static void ZN(uint8_t v)
+{
+    Ram[R_STATUS] = (uint8_t)((Ram[R_STATUS] & ~(S_Z | S_N)) | (v == 0 ? S_Z : 0) | (v & 0x80 ? S_N : 0));
+}
+//-----------------------------------
+
+static uint8_t Skip(void)
+{
+    //---------
+    uint16_t next = Word(Pc);
+    uint8_t two = (next & 0xF000) == 0xC000 || (next & 0xFE00) == 0xEC00 || (next & 0xFF00) == 0xEF00 || (next & 0xFFC0) == 0xEE00;
+    //---------
+    Pc += two ? 4 : 2;
+    return two ? 2 : 1;
+}
+//-----------------------------------
+
+static void TableRead(uint8_t mode)
+{
+    //---------
+    uint32_t p = ((uint32_t)Ram[R_TBLPTRU] << 16) | ((uint32_t)Ram[R_TBLPTRH] << 8) | Ram[R_TBLPTRL];
+    //---------
+    if(mode == 3) ++p;                                          //!< +*
+    p &= 0x3FFFFF;
+    if(p < ROM_SIZE)
+        Ram[R_TABLAT] = Rom[p];
+    else if(p >= 0x300000 && p < 0x300010)
+        Ram[R_TABLAT] = Config[p - 0x300000];
+    else
+        Ram[R_TABLAT] = 0xFF;
+    if(mode == 1) ++p;                                          //!< *+
+    if(mode == 2) --p;                                          //!< *-
+    Ram[R_TBLPTRL] = (uint8_t)p;
+    Ram[R_TBLPTRH] = (uint8_t)(p >> 8);
+    Ram[R_TBLPTRU] = (uint8_t)((p >> 16) & 0x3F);
+    //---------
+}
+//-----------------------------------
+
+static void Call(uint32_t target, uint8_t fast)
+{
+    //---------
+    if(fast)
+    {
+        ShadowW = Ram[R_WREG];
+        ShadowStatus = Ram[R_STATUS];
+        ShadowBsr = Ram[R_BSR];
+    }
+    Push(Pc);
+    PushFrame(target, Pc);
+    Pc = target;
+    //---------
+}
+//-----------------------------------
+
+static void Return(uint8_t fast)
+{
+    //---------
+    Pc = Pop();
+    if(fast)
+    {
+        Ram[R_WREG] = ShadowW;
+        Ram[R_STATUS] = ShadowStatus;
+        Ram[R_BSR] = ShadowBsr;
+    }
+    PopFrame(Pc);
+    //---------
+}
+//-----------------------------------
+
+static void Interrupts(void)
+{
+    //---------
+    uint8_t intcon = Ram[R_INTCON], intcon2 = Ram[R_INTCON2], intcon3 = Ram[R_INTCON3];
+    uint8_t p1 = Ram[R_PIE1] & Ram[R_PIR1], p2 = Ram[R_PIE2] & Ram[R_PIR2];
+    uint8_t hi = 0, lo = 0;
+    uint32_t vector;
+    //---------
+    if(Ram[R_RCON] & 0x80)                                      //!< Priority levels
+    {
+        if((intcon & 0x10) && (intcon & 0x02)) hi = 1;          //!< INT0 is always high priority
+        if((intcon & 0x20) && (intcon & 0x04)) { if(intcon2 & 0x04) hi = 1; else lo = 1; }
+        if((intcon & 0x08) && (intcon & 0x01)) { if(intcon2 & 0x01) hi = 1; else lo = 1; }
+        if((intcon3 & 0x08) && (intcon3 & 0x01)) { if(intcon3 & 0x40) hi = 1; else lo = 1; }
+        if((intcon3 & 0x10) && (intcon3 & 0x02)) { if(intcon3 & 0x80) hi = 1; else lo = 1; }
+        if(p1 & Ram[R_IPR1]) hi = 1;
+        if(p1 & ~Ram[R_IPR1]) lo = 1;
+        if(p2 & Ram[R_IPR2]) hi = 1;
+        if(p2 & ~Ram[R_IPR2]) lo = 1;
+        if(hi && (intcon & 0x80))
+        {
+            vector = 0x08;
+            Ram[R_INTCON] &= 0x7F;
+        }
+        else if(lo && (intcon & 0x40) && (intcon & 0x80))
+        {
+            vector = 0x18;
+            Ram[R_INTCON] &= 0xBF;
+        }
+        else
+            vector = 0;
+        if((hi || lo) && Sleeping)
+            Sleeping = 0;
+    }
+    else
+    {
+        hi = ((intcon >> 3) & intcon & 0x07) || ((intcon3 >> 3) & intcon3 & 0x03);
+        lo = p1 || p2;
+        if((hi || lo) && Sleeping)
+            Sleeping = 0;                                       //!< Wake up regardless of GIE/PEIE
+        if((intcon & 0x80) && (hi || (lo && (intcon & 0x40))))
+        {
+            vector = 0x08;
+            Ram[R_INTCON] &= 0x7F;
+        }
+        else
+            vector = 0;
+    }
+    //---------
+    if(vector == 0)
+        return;
+    ShadowW = Ram[R_WREG];
+    ShadowStatus = Ram[R_STATUS];
+    ShadowBsr = Ram[R_BSR];
+    Push(Pc);
+    ++InIsr;
+    ++IsrCount;
+    IsrLevels |= (uint8_t)((vector == 0x08) ? 0x02 : 0x01);
+    PushFrame(vector, Pc);
+    if(FrameCnt > 0 && Frames[FrameCnt - 1].Func < 0)
+    {
+        int f = FindFunc(vector);                               //!< Vector inside the interrupt function
+        if(f >= 0)
+        {
+            Frames[FrameCnt - 1].Func = f;
+            ++Funcs[f].Calls;
+        }
+    }
+    Pc = vector;
+    Tick(2);                                                    //!< Interrupt latency
+    //---------
+}
+//-----------------------------------
+
+static void Step(void)
+{
+    //---------
+    uint32_t pc0 = Pc;
+    uint16_t op = Word(Pc), op2, a;
+    uint8_t cyc = 1, d, v, w, b, c;
+    int f;
+    //---------
+    Pc += 2;
+    ++Instructions;
+    d = (op & 0x0200) != 0;                                     //!< Destination is the file register
+    w = Ram[R_WREG];
+    c = Ram[R_STATUS] & S_C;
+    //---------
+    switch(op >> 12)
+    {
+        case 0x0:
+            if((op & 0xFF00) == 0x0000)
+            {
+                switch(op & 0xFF)
+                {
+                    case 0x00: break;                                                       //!< NOP
+                    case 0x03: Sleeping = 1; break;                                         //!< SLEEP
+                    case 0x04: break;                                                       //!< CLRWDT
+                    case 0x05: Push(Pc); break;                                             //!< PUSH
+                    case 0x06: Pop(); break;                                                //!< POP
+                    case 0x07:                                                              //!< DAW
+                    {
+                        uint16_t r = w;
+                        if((w & 0x0F) > 9 || (Ram[R_STATUS] & S_DC)) r += 6;
+                        if((r >> 4) > 9 || c) r += 0x60;
+                        Ram[R_WREG] = (uint8_t)r;
+                        Ram[R_STATUS] = (uint8_t)((Ram[R_STATUS] & ~S_C) | ((r > 0xFF) ? S_C : 0));
+                        break;
+                    }
+                    case 0x08: case 0x09: case 0x0A: case 0x0B:                             //!< TBLRD
+                        TableRead((uint8_t)(op & 0x03)); cyc = 2; break;
+                    case 0x0C: case 0x0D: case 0x0E: case 0x0F:                             //!< TBLWT, no flash writes
+                        cyc = 2; break;
+                    case 0x10: case 0x11:                                                   //!< RETFIE
+                        if((Ram[R_RCON] & 0x80) && IsrLevels == 0x01)
+                            Ram[R_INTCON] |= 0x40;                                          //!< GIEL
+                        else
+                            Ram[R_INTCON] |= 0x80;                                          //!< GIE/GIEH
+                        IsrLevels &= (uint8_t)((IsrLevels & 0x02) ? 0x01 : 0x00);
+                        Return((uint8_t)(op & 0x01));
+                        if(InIsr)
+                            --InIsr;
+                        if(Log)
+                            fprintf(Log, "%llu X\n", (unsigned long long)Cycles);
+                        cyc = 2; break;
+                    case 0x12: case 0x13:                                                   //!< RETURN
+                        Return((uint8_t)(op & 0x01)); cyc = 2; break;
+                    case 0xFF:                                                              //!< RESET
+                        Pc = 0; Ram[R_STKPTR] = 0; FrameCnt = 0; break;
+                    default: break;
+                }
+            }
+            else if((op & 0xFF00) == 0x0100)                                                //!< MOVLB
+                Ram[R_BSR] = (uint8_t)(op & 0x0F);
+            else if((op & 0xFE00) == 0x0200)                                                //!< MULWF
+            {
+                uint16_t p = (uint16_t)(w * Read(FileAddr(op)));
+                Ram[R_PRODL] = (uint8_t)p; Ram[R_PRODH] = (uint8_t)(p >> 8);
+            }
+            else if((op & 0xFC00) == 0x0400)                                                //!< DECF
+            {
+                a = FileAddr(op); v = Add(Read(a), 0xFF, 0, 0x1F);
+                if(d) Write(a, v); else Ram[R_WREG] = v;
+            }
+            else
+            {
+                uint8_t k = (uint8_t)op;
+                switch(op >> 8)
+                {
+                    case 0x08: Ram[R_WREG] = Add(k, (uint8_t)~w, 1, 0x1F); break;            //!< SUBLW
+                    case 0x09: Ram[R_WREG] = (uint8_t)(w | k); ZN(Ram[R_WREG]); break;      //!< IORLW
+                    case 0x0A: Ram[R_WREG] = (uint8_t)(w ^ k); ZN(Ram[R_WREG]); break;      //!< XORLW
+                    case 0x0B: Ram[R_WREG] = (uint8_t)(w & k); ZN(Ram[R_WREG]); break;      //!< ANDLW
+                    case 0x0C: Ram[R_WREG] = k; Return(0); cyc = 2; break;                  //!< RETLW
+                    case 0x0D:                                                              //!< MULLW
+                    {
+                        uint16_t p = (uint16_t)(w * k);
+                        Ram[R_PRODL] = (uint8_t)p; Ram[R_PRODH] = (uint8_t)(p >> 8);
+                        break;
+                    }
+                    case 0x0E: Ram[R_WREG] = k; break;                                      //!< MOVLW
+                    case 0x0F: Ram[R_WREG] = Add(w, k, 0, 0x1F); break;                     //!< ADDLW
+                    default: break;
+                }
+            }
+            break;
+        //---------
+        case 0x1: case 0x2: case 0x3: case 0x4: case 0x5:
+            a = FileAddr(op);
+            switch(op & 0xFC00)
+            {
+                case 0x1000: v = (uint8_t)(Read(a) | w); ZN(v); break;                      //!< IORWF
+                case 0x1400: v = (uint8_t)(Read(a) & w); ZN(v); break;                      //!< ANDWF
+                case 0x1800: v = (uint8_t)(Read(a) ^ w); ZN(v); break;                      //!< XORWF
+                case 0x1C00: v = (uint8_t)~Read(a); ZN(v); break;                           //!< COMF
+                case 0x2000: v = Add(Read(a), w, c, 0x1F); break;                           //!< ADDWFC
+                case 0x2400: v = Add(Read(a), w, 0, 0x1F); break;                           //!< ADDWF
+                case 0x2800: v = Add(Read(a), 1, 0, 0x1F); break;                           //!< INCF
+                case 0x2C00: v = (uint8_t)(Read(a) - 1); if(v == 0) cyc += Skip(); break;   //!< DECFSZ
+                case 0x3000:                                                                //!< RRCF
+                    b = Read(a); v = (uint8_t)((b >> 1) | (c << 7));
+                    ZN(v); Ram[R_STATUS] = (uint8_t)((Ram[R_STATUS] & ~S_C) | (b & 0x01)); break;
+                case 0x3400:                                                                //!< RLCF
+                    b = Read(a); v = (uint8_t)((b << 1) | c);
+                    ZN(v); Ram[R_STATUS] = (uint8_t)((Ram[R_STATUS] & ~S_C) | (b >> 7)); break;
+                case 0x3800: b = Read(a); v = (uint8_t)((b << 4) | (b >> 4)); break;        //!< SWAPF
+                case 0x3C00: v = (uint8_t)(Read(a) + 1); if(v == 0) cyc += Skip(); break;   //!< INCFSZ
+                case 0x4000: b = Read(a); v = (uint8_t)((b >> 1) | (b << 7)); ZN(v); break; //!< RRNCF
+                case 0x4400: b = Read(a); v = (uint8_t)((b << 1) | (b >> 7)); ZN(v); break; //!< RLNCF
+                case 0x4800: v = (uint8_t)(Read(a) + 1); if(v != 0) cyc += Skip(); break;   //!< INFSNZ
+                case 0x4C00: v = (uint8_t)(Read(a) - 1); if(v != 0) cyc += Skip(); break;   //!< DCFSNZ
+                case 0x5000: v = Read(a); ZN(v); break;                                     //!< MOVF
+                case 0x5400: v = Add(w, (uint8_t)~Read(a), c, 0x1F); break;                 //!< SUBFWB
+                case 0x5800: v = Add(Read(a), (uint8_t)~w, c, 0x1F); break;                 //!< SUBWFB
+                default:     v = Add(Read(a), (uint8_t)~w, 1, 0x1F); break;                 //!< SUBWF
+            }
+            if(d) Write(a, v); else Ram[R_WREG] = v;
+            break;
+        //---------
+        case 0x6:
+            a = FileAddr(op);
+            switch(op & 0xFE00)
+            {
+                case 0x6000: if(Read(a) < w) cyc += Skip(); break;                          //!< CPFSLT
+                case 0x6200: if(Read(a) == w) cyc += Skip(); break;                         //!< CPFSEQ
+                case 0x6400: if(Read(a) > w) cyc += Skip(); break;                          //!< CPFSGT
+                case 0x6600: if(Read(a) == 0) cyc += Skip(); break;                         //!< TSTFSZ
+                case 0x6800: Write(a, 0xFF); break;                                         //!< SETF
+                case 0x6A00: Write(a, 0); ZN(0); break;                                     //!< CLRF
+                case 0x6C00: Write(a, Add(0, (uint8_t)~Read(a), 1, 0x1F)); break;           //!< NEGF
+                default:     Write(a, w); break;                                            //!< MOVWF
+            }
+            break;
+        //---------
+        case 0x7: case 0x8: case 0x9: case 0xA: case 0xB:
+            a = FileAddr(op);
+            b = (uint8_t)(1u << ((op >> 9) & 0x07));
+            switch(op >> 12)
+            {
+                case 0x7: Write(a, (uint8_t)(Read(a) ^ b)); break;                          //!< BTG
+                case 0x8: Write(a, (uint8_t)(Read(a) | b)); break;                          //!< BSF
+                case 0x9: Write(a, (uint8_t)(Read(a) & ~b)); break;                         //!< BCF
+                case 0xA: if(Read(a) & b) cyc += Skip(); break;                             //!< BTFSS
+                default:  if(!(Read(a) & b)) cyc += Skip(); break;                          //!< BTFSC
+            }
+            break;
+        //---------
+        case 0xC:                                                                           //!< MOVFF
+            op2 = Word(Pc);
+            Pc += 2;
+            Write((uint16_t)(op2 & 0x0FFF), Read((uint16_t)(op & 0x0FFF)));
+            cyc = 2;
+            break;
+        //---------
+        case 0xD:
+        {
+            int32_t n = op & 0x07FF;
+            if(n & 0x0400) n -= 0x0800;
+            if(op & 0x0800)                                                                 //!< RCALL
+                Call((uint32_t)(Pc + 2 * n), 0);
+            else                                                                            //!< BRA
+                Pc = (uint32_t)(Pc + 2 * n);
+            cyc = 2;
+            break;
+        }
+        //---------
+        case 0xE:
+            if((op & 0x0800) == 0)                                                          //!< Conditional branches
+            {
+                uint8_t s = Ram[R_STATUS], take = 0;
+                int8_t n = (int8_t)(op & 0xFF);
+                switch((op >> 8) & 0x07)
+                {
+                    case 0: take = (s & S_Z) != 0; break;                                   //!< BZ
+                    case 1: take = (s & S_Z) == 0; break;                                   //!< BNZ
+                    case 2: take = (s & S_C) != 0; break;                                   //!< BC
+                    case 3: take = (s & S_C) == 0; break;                                   //!< BNC
+                    case 4: take = (s & S_OV) != 0; break;                                  //!< BOV
+                    case 5: take = (s & S_OV) == 0; break;                                  //!< BNOV
+                    case 6: take = (s & S_N) != 0; break;                                   //!< BN
+                    default: take = (s & S_N) == 0; break;                                  //!< BNN
+                }
+                if(take)
+                {
+                    Pc = (uint32_t)(Pc + 2 * n);
+                    cyc = 2;
+                }
+            }
+            else
+            {
+                op2 = Word(Pc);
+                Pc += 2;
+                cyc = 2;
+                switch(op & 0xFF00)
+                {
+                    case 0xEC00: case 0xED00:                                               //!< CALL
+                        Call(((uint32_t)(op2 & 0x0FFF) << 9) | ((uint32_t)(op & 0xFF) << 1), (uint8_t)((op >> 8) & 0x01));
+                        break;
+                    case 0xEE00:                                                            //!< LFSR
+                        f = (op >> 4) & 0x03;
+                        if(f < 3)
+                            FsrSet(f, (uint16_t)(((op & 0x0F) << 8) | (op2 & 0xFF)));
+                        break;
+                    case 0xEF00:                                                            //!< GOTO
+                        Pc = ((uint32_t)(op2 & 0x0FFF) << 9) | ((uint32_t)(op & 0xFF) << 1);
+                        break;
+                    default:
+                        break;
+                }
+            }
+            break;
+        //---------
+        default:                                                                            //!< 0xF: NOP (second word)
+            break;
+    }
+    //---------
+    f = FindFunc(pc0);
+    if(f >= 0)
+        Funcs[f].Self += cyc;
+    Tick(cyc);
+    //---------
+}
+//-----------------------------------
+
+//-----------------------------------
+// Files
+//-----------------------------------
+static int LoadHex(const char *file)
+{
+    //---------
+    FILE *fp = fopen(file, "r");
+    char line[600];
+    uint32_t base = 0, addr, i, cnt, type, byte;
+    //---------
+    if(fp == NULL)
+    {
+        perror(file);
+        return 1;
+    }
+    memset(Rom, 0xFF, sizeof(Rom));
+    memset(Config, 0xFF, sizeof(Config));
+    while(fgets(line, sizeof(line), fp))
+    {
+        if(line[0] != ':' || sscanf(line + 1, "%2x%4x%2x", &cnt, &addr, &type) != 3)
+            continue;
+        if(type == 0x01)
+            break;
+        if(type == 0x04 || type == 0x02)
+        {
+            sscanf(line + 9, "%4x", &base);
+            base = (type == 0x04) ? (base << 16) : (base << 4);
+            continue;
+        }
+        if(type != 0x00)
+            continue;
+        for(i = 0; i < cnt; ++i)
+        {
+            if(sscanf(line + 9 + 2 * i, "%2x", &byte) != 1)
+                break;
+            if(base + addr + i < ROM_SIZE)
+                Rom[base + addr + i] = (uint8_t)byte;
+            else if(base + addr + i >= 0x300000 && base + addr + i < 0x300010)
+                Config[base + addr + i - 0x300000] = (uint8_t)byte;
+        }
+    }
+    fclose(fp);
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+static int CompareFuncs(const void *a, const void *b)
+{
+    const FuncType *fa = a, *fb = b;
+    return (fa->Start > fb->Start) - (fa->Start < fb->Start);
+}
+//-----------------------------------
+
+static int LoadSym(const char *file)
+{
+    //---------
+    FILE *fp = fopen(file, "r");
+    static char names[MAX_FUNCS * 2][64];
+    static uint32_t addrs[MAX_FUNCS * 2];
+    char line[256], name[64], cls[16];
+    unsigned addr, size;
+    int n = 0, i, j;
+    //---------
+    if(fp == NULL)
+    {
+        perror(file);
+        return 1;
+    }
+    while(fgets(line, sizeof(line), fp) && n < MAX_FUNCS * 2)
+    {
+        if(sscanf(line, "%63s %x %x %15s", name, &addr, &size, cls) != 4 || strcmp(cls, "CODE") != 0)
+            continue;
+        if(name[0] != '_')
+            continue;
+        strcpy(names[n], name);
+        addrs[n] = addr;
+        ++n;
+    }
+    fclose(fp);
+    //---------
+    for(i = 0; i < n && FuncCnt < MAX_FUNCS; ++i)               //!< Functions are delimited by _name and __end_of_name
+    {
+        if(strncmp(names[i], "__end_of_", 9) != 0)
+            continue;
+        for(j = 0; j < n; ++j)
+        {
+            if(names[j][0] == '_' && strcmp(names[j] + 1, names[i] + 9) == 0)
+            {
+                FuncType *fn = &Funcs[FuncCnt++];
+                memset(fn, 0, sizeof(*fn));
+                snprintf(fn->Name, sizeof(fn->Name), "%s", names[j] + 1);
+                fn->Start = addrs[j];
+                fn->End = addrs[i];
+                break;
+            }
+        }
+    }
+    qsort(Funcs, (size_t)FuncCnt, sizeof(FuncType), CompareFuncs);
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+static void AddEvent(uint64_t cycle, uint8_t level)
+{
+    if(EventCnt < MAX_EVENTS)
+    {
+        Events[EventCnt].Cycle = cycle;
+        Events[EventCnt].Level = level;
+        ++EventCnt;
+    }
+}
+//-----------------------------------
+
+static int CompareEvents(const void *a, const void *b)
+{
+    const EventType *ea = a, *eb = b;
+    return (ea->Cycle > eb->Cycle) - (ea->Cycle < eb->Cycle);
+}
+//-----------------------------------
+
+static int CompareIncl(const void *a, const void *b)
+{
+    const FuncType *fa = a, *fb = b;
+    return (fa->Incl < fb->Incl) - (fa->Incl > fb->Incl);
+}
+//-----------------------------------
+
+static void Usage(void)
+{
+    fprintf(stderr, "usage: pic18sim [-f MHz] [-t ms] [-d ms] [-u text] [-i us] [-s baud:text] [-x] [-n count] [-l file] image.hex [image.sym]\n");
+}
+//-----------------------------------
+
+int main(int argc, char **argv)
+{
+    //---------
+    double mhz = 16, ms = 1000, delay = 10, toggle = 0;
+    const char *hex = NULL, *sym = NULL, *serial = NULL, *log = NULL;
+    uint32_t baud = 0, limit = 0, i, bit, p;
+    uint64_t end, start, period, t;
+    int print = 0, opt;
+    const char *s;
+    char pins[64];
+    //---------
+    for(opt = 1; opt < argc; ++opt)
+    {
+        if(argv[opt][0] != '-')
+        {
+            if(hex == NULL) hex = argv[opt];
+            else sym = argv[opt];
+            continue;
+        }
+        if(argv[opt][1] == 'x') { print = 1; continue; }
+        if(opt + 1 >= argc) { Usage(); return 2; }
+        switch(argv[opt][1])
+        {
+            case 'f': mhz = atof(argv[++opt]); break;
+            case 't': ms = atof(argv[++opt]); break;
+            case 'd': delay = atof(argv[++opt]); break;
+            case 'u': RxText = argv[++opt]; break;
+            case 'i': toggle = atof(argv[++opt]); break;
+            case 's':
+                baud = (uint32_t)strtoul(argv[++opt], (char **)&serial, 10);
+                if(serial == NULL || *serial != ':' || baud == 0) { Usage(); return 2; }
+                ++serial;
+                break;
+            case 'n': limit = (uint32_t)atoi(argv[++opt]); break;
+            case 'l': log = argv[++opt]; break;
+            default: Usage(); return 2;
+        }
+    }
+    if(hex == NULL || mhz <= 0)
+    {
+        Usage();
+        return 2;
+    }
+    if(LoadHex(hex) != 0 || (sym != NULL && LoadSym(sym) != 0))
+        return 1;
+    if(log != NULL && (Log = fopen(log, "w")) == NULL)
+    {
+        perror(log);
+        return 1;
+    }
+    //---------
+    end = (uint64_t)(ms * mhz * 1000 / 4);
+    start = (uint64_t)(delay * mhz * 1000 / 4);
+    if(toggle > 0)                                              //!< RB0 square wave
+    {
+        period = (uint64_t)(toggle * mhz / 4);
+        for(t = start, i = 0; t < end && period > 0; t += period, ++i)
+            AddEvent(t, (uint8_t)(i & 1));
+    }
+    if(serial != NULL)                                          //!< 8N1 frames on RB0
+    {
+        period = (uint64_t)(mhz * 1e6 / 4 / baud);
+        for(s = serial, t = start; *s; ++s)
+        {
+            AddEvent(t, 0);
+            for(bit = 0; bit < 8; ++bit)
+                AddEvent(t + (bit + 1) * period, (uint8_t)((*s >> bit) & 1));
+            AddEvent(t + 9 * period, 1);
+            t += 10 * period;
+        }
+    }
+    qsort(Events, EventCnt, sizeof(EventType), CompareEvents);
+    RxNext = start;
+    //---------
+    memset(Ram, 0, sizeof(Ram));
+    Ram[R_TRISA] = Ram[R_TRISA + 1] = Ram[R_TRISA + 2] = Ram[R_TRISA + 3] = 0xFF;
+    Ram[R_TRISA + 4] = 0x07;
+    Ram[R_INTCON2] = 0xF5;
+    Ram[R_T0CON] = 0xFF;
+    Ram[R_TXSTA] = 0x02;
+    Ram[R_PR2] = 0xFF;
+    Ram[R_RCON] = 0x1C;
+    Pc = 0;
+    //---------
+    while(Cycles < end)
+    {
+        if(Sleeping)
+            Tick(1);
+        else
+            Step();
+        Interrupts();
+    }
+    //---------
+    printf("PIC18 simulation: %s, FOSC %.3f MHz, %.3f ms, %llu instruction cycles, %llu instructions\n",
+           hex, mhz, Cycles * 4 / (mhz * 1000), (unsigned long long)Cycles, (unsigned long long)Instructions);
+    printf("interrupts: %u, %llu cycles (%.2f%% of the CPU time)\n", IsrCount, (unsigned long long)IsrCycles,
+           Cycles ? 100.0 * IsrCycles / Cycles : 0);
+    printf("usart: %u bytes sent, %u bytes lost on reception\n", TxCount, RxLost);
+    for(p = 0; p < 5; ++p)
+    {
+        pins[0] = '\0';
+        for(bit = 0; bit < 8; ++bit)
+            if(PinEdges[p][bit])
+                snprintf(pins + strlen(pins), sizeof(pins) - strlen(pins), " R%c%u:%u", 'A' + p, bit, PinEdges[p][bit]);
+        if(pins[0])
+            printf("output transitions:%s\n", pins);
+    }
+    //---------
+    if(FuncCnt)
+    {
+        qsort(Funcs, (size_t)FuncCnt, sizeof(FuncType), CompareIncl);
+        printf("\n%-28s %8s %12s %9s %9s %11s %12s %7s\n", "function", "calls", "incl.total", "incl.min", "incl.max",
+               "incl.avg", "self", "%cpu");
+        for(i = 0; i < (uint32_t)FuncCnt && (limit == 0 || i < limit); ++i)
+        {
+            FuncType *fn = &Funcs[i];
+            if(fn->Calls == 0 && fn->Self == 0)
+                continue;
+            printf("%-28s %8u %12llu %9llu %9llu %11.1f %12llu %6.2f%%\n", fn->Name, fn->Calls,
+                   (unsigned long long)fn->Incl, (unsigned long long)fn->InclMin, (unsigned long long)fn->InclMax,
+                   fn->Returns ? (double)fn->Incl / fn->Returns : 0, (unsigned long long)fn->Self,
+                   Cycles ? 100.0 * fn->Self / Cycles : 0);
+        }
+    }
+    if(print && TxCount)
+    {
+        TxLine[TxCount < LINE_SIZE ? TxCount : LINE_SIZE - 1] = '\0';
+        printf("\nusart output:\n%s\n", TxLine);
+    }
+    if(Log)
+        fclose(Log);
+    //---------
+    return 0;
+}
+//-----------------------------------
@@ -0,0 +1,405 @@
+/**
+ ******************************************************************************
+ * @file            SuartTiming.c
+ * @author          Maxime
+ * @brief           Software UART bit timing verification
+ * @brief           Prints, for every oscillator frequency and baud rate, the bit
+ *                  timing generated by SoftwareUART.c (See SUART_TIMING in
+ *                  SoftwareUART.h) and fails if a combination documented as
+ *                  supported cannot be generated:
+ *                      - cyc/bit: instruction cycles per bit
+ *                      - err: bit duration error
+ *                      - tx delay: generated delay per transmitted bit
+ *                      - rx start: generated delay from the start bit to the first sample
+ *                      - rx stop: sampling point of the stop bit, in per cent of a bit
+ *                        from its middle (frame error margin)
+ *                      - delay/compare/tick: status of the SUART_MODE_DELAY,
+ *                        SUART_MODE_COMPARE and SUART_MODE_TICK (SUART_OVERSAMPLE
+ *                        ticks per bit) engines
+ *
+ * @note            With -l, it also measures the SUART_MODE_DELAY bit loops of the production
+ *                  image from a pin events log of the instruction set simulator (pic18sim -l, with
+ *                  8N1 frames sent on the RX pin and echoed by the firmware), and fails when a
+ *                  SUART_TIMING constant is outside of the measured range (+/- 1 cycle):
+ *                      - SUART_TX_LOOP_CYCLES: TX edges spacing, minus SUART_TX_BIT_DELAY
+ *                      - SUART_TX_START_CYCLES: start bit length, minus SUART_TX_START_DELAY
+ *                      - SUART_RX_LOOP_CYCLES: PORTB reads spacing, minus SUART_RX_BIT_DELAY
+ *                      - SUART_RX_LATENCY_CYCLES: start edge to first PORTB read, minus
+ *                        SUART_RX_START_DELAY and SUART_RX_LOOP_CYCLES
+ *                      - SUART_RX_TAIL_CYCLES: stop bit read to the return from interrupt
+ *                  The image must be built with the default SUART_MODE, FOSC_MHZ and SUART_BAUD
+ *                  of this check. An image whose symbols (-y) do not come from SoftwareUART.c is
+ *                  reported as not verified and fails the check.
+ *
+ * @note            Usage:
+ @verbatim
+    suart-timing [-l <pic18sim log> -y <image.sym>]
+ @endverbatim
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Inc/SoftwareUART.h"
+//-----------------------------------
+
+/**
+ * @brief   Supported combinations, as documented in SoftwareUART.h
+ *
+ */
+static const struct
+{
+    uint8_t FoscMhz;
+    uint32_t MaxBaud;                               //!< SUART_MODE_DELAY
+    uint32_t CmpMaxBaud;                            //!< SUART_MODE_COMPARE
+    uint32_t TickMaxBaud;                           //!< SUART_MODE_TICK
+}Supported[] =
+{
+    { 4, 9600, 4800, 2400 }, { 8, 19200, 9600, 4800 }, { 10, 38400, 9600, 4800 }, { 12, 38400, 19200, 4800 },
+    { 16, 57600, 19200, 9600 }, { 20, 57600, 19200, 9600 }, { 25, 57600, 38400, 9600 }, { 32, 115200, 38400, 19200 },
+    { 40, 115200, 57600, 19200 },
+};
+static const uint32_t Bauds[] = { 1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200 };
+//-----------------------------------
+
+/**
+ * @brief   Range of a measured constant
+ *
+ */
+typedef struct
+{
+    const char *Name;
+    long Header;                                    //!< Value of the SUART_TIMING constant
+    long Min;
+    long Max;
+    uint32_t Count;                                 //!< Frames measured
+}MeasureType;
+
+/**
+ * @brief   Pin event of the simulator log
+ *
+ */
+typedef struct
+{
+    unsigned long long Cycle;
+    char Type;                                      //!< 'O', 'I', 'R' or 'X'
+    char Port;
+    uint8_t Pin;
+    uint8_t Level;
+}EventType;
+//-----------------------------------
+static EventType *Events = NULL;
+static size_t EventCnt = 0;
+//-----------------------------------
+
+/**
+ * @brief   Status of one engine for one combination, raises fail when a supported one is invalid
+ *
+ */
+static const char *Status(int valid, uint32_t baud, uint32_t maxBaud, int *fail)
+{
+    if(valid)
+        return "ok";
+    if(baud > maxBaud)
+        return "unsupported";
+    *fail = 1;
+    return "FAIL";
+}
+//-----------------------------------
+
+static void MeasureAdd(MeasureType *m, long value)
+{
+    //---------
+    if(m->Count == 0 || value < m->Min)
+        m->Min = value;
+    if(m->Count == 0 || value > m->Max)
+        m->Max = value;
+    ++m->Count;
+    //---------
+}
+//-----------------------------------
+
+static int LoadLog(const char *file)
+{
+    //---------
+    FILE *fp = fopen(file, "r");
+    char line[64], port;
+    unsigned long long cycle;
+    unsigned pin, level;
+    size_t size = 0;
+    EventType *e;
+    //---------
+    if(fp == NULL)
+    {
+        perror(file);
+        return 1;
+    }
+    while(fgets(line, sizeof(line), fp))
+    {
+        if(EventCnt == size)
+        {
+            size = size ? 2 * size : 4096;
+            if((Events = realloc(Events, size * sizeof(EventType))) == NULL)
+            {
+                fclose(fp);
+                return 1;
+            }
+        }
+        e = &Events[EventCnt];
+        memset(e, 0, sizeof(EventType));
+        if(sscanf(line, "%llu %c", &cycle, &e->Type) != 2)
+            continue;
+        e->Cycle = cycle;
+        if(e->Type == 'O' || e->Type == 'I')
+        {
+            if(sscanf(line, "%*u %*c %c%u %u", &port, &pin, &level) != 3)
+                continue;
+            e->Port = port;
+            e->Pin = (uint8_t)pin;
+            e->Level = (uint8_t)level;
+        }
+        else if(e->Type == 'R')
+        {
+            if(sscanf(line, "%*u %*c %c", &port) != 1)
+                continue;
+            e->Port = port;
+        }
+        else if(e->Type != 'X')
+            continue;
+        ++EventCnt;
+    }
+    fclose(fp);
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+/**
+ * @brief   Transmitted frames: falling edge from the idle line, then the data bits edges
+ *
+ */
+static void MeasureTx(MeasureType *loop, MeasureType *start)
+{
+    //---------
+    const long bit = (long)SUART_BIT_CYCLES;
+    unsigned long long t0 = 0, p;
+    long n, first[2], firstN[2], last[2], lastN[2];
+    int inFrame = 0, lvl;
+    size_t i;
+    //---------
+    for(i = 0; i <= EventCnt; ++i)
+    {
+        if(inFrame && (i == EventCnt || Events[i].Cycle >= t0 + (unsigned long long)(bit * 19 / 2)))
+        {
+            for(lvl = 0; lvl < 2; ++lvl)                        //!< Same direction edges: 0 and 1 writes differ
+            {
+                if(firstN[lvl] == 1)
+                    MeasureAdd(start, first[lvl] - (long)SUART_TX_START_DELAY);
+                if(lastN[lvl] > firstN[lvl])
+                    MeasureAdd(loop, (last[lvl] - first[lvl]) / (lastN[lvl] - firstN[lvl]) - (long)SUART_TX_BIT_DELAY);
+            }
+            inFrame = 0;
+        }
+        if(i == EventCnt)
+            break;
+        if(Events[i].Type != 'O' || Events[i].Port != 'A' + SUART_TX_PORT || Events[i].Pin != SUART_TX_PIN)
+            continue;
+        //---------
+        if(!inFrame)
+        {
+            if(Events[i].Level == 0)                            //!< Start bit
+            {
+                t0 = Events[i].Cycle;
+                firstN[0] = firstN[1] = lastN[0] = lastN[1] = 0;
+                inFrame = 1;
+            }
+            continue;
+        }
+        p = Events[i].Cycle - t0;
+        n = (long)((p + (unsigned long long)bit / 2) / (unsigned long long)bit);   //!< Bit boundary: 1 to 8 data bits, 9 stop bit
+        if(n < 1 || n > 8)
+            continue;
+        lvl = Events[i].Level;
+        if(firstN[lvl] == 0)
+        {
+            firstN[lvl] = n;
+            first[lvl] = (long)p;
+        }
+        lastN[lvl] = n;
+        last[lvl] = (long)p;
+    }
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Received frames: start edges on the RX pin, PORTB reads of the interrupt
+ * @retval  frames sampled late (start bit seen after the previous frame or a transmission)
+ *
+ */
+static uint32_t MeasureRx(MeasureType *loop, MeasureType *latency, MeasureType *tail)
+{
+    //---------
+    const long bit = (long)SUART_BIT_CYCLES;
+    unsigned long long t0 = 0, next = 0, reads[9];
+    uint32_t late = 0;
+    long rxLoop;
+    size_t i, j;
+    uint8_t n;
+    //---------
+    for(i = 0; i < EventCnt; ++i)
+    {
+        if(Events[i].Type != 'I' || Events[i].Port != 'B' || Events[i].Pin != SUART_RX_INT
+           || Events[i].Level != 0 || Events[i].Cycle < next)
+            continue;
+        t0 = Events[i].Cycle;                                   //!< Start bit edge
+        next = t0 + (unsigned long long)(bit * 19 / 2);
+        //---------
+        for(j = i + 1, n = 0; j < EventCnt && Events[j].Cycle < t0 + (unsigned long long)(bit * 21 / 2); ++j)
+        {
+            if(Events[j].Type == 'R' && Events[j].Port == 'B' && n < 9)
+                reads[n++] = Events[j].Cycle;
+            else if(Events[j].Type == 'X' && n == 9)
+            {
+                MeasureAdd(tail, (long)(Events[j].Cycle - reads[8]));
+                break;
+            }
+        }
+        if(n != 9 || reads[0] - t0 > (unsigned long long)(2 * bit))
+        {
+            ++late;
+            continue;
+        }
+        rxLoop = (long)(reads[7] - reads[0]) / 7 - (long)SUART_RX_BIT_DELAY;
+        MeasureAdd(loop, rxLoop);
+        MeasureAdd(latency, (long)(reads[0] - t0) - (long)SUART_RX_START_DELAY - rxLoop);
+    }
+    //---------
+    return late;
+}
+//-----------------------------------
+
+/**
+ * @brief   Measure the SUART_MODE_DELAY bit loops of the production image, see the file header
+ * @retval  1 if a constant does not match, or the image does not come from SoftwareUART.c
+ *
+ */
+static int Measure(const char *log, const char *sym)
+{
+    //---------
+    MeasureType m[5] =
+    {
+        { "SUART_TX_LOOP_CYCLES", SUART_TX_LOOP_CYCLES, 0, 0, 0 },
+        { "SUART_TX_START_CYCLES", SUART_TX_START_CYCLES, 0, 0, 0 },
+        { "SUART_RX_LOOP_CYCLES", SUART_RX_LOOP_CYCLES, 0, 0, 0 },
+        { "SUART_RX_LATENCY_CYCLES", SUART_RX_LATENCY_CYCLES, 0, 0, 0 },
+        { "SUART_RX_TAIL_CYCLES", SUART_RX_TAIL_CYCLES, 0, 0, 0 },
+    };
+    char line[256];
+    int source = 0, fail = 0;
+    uint32_t late;
+    FILE *fp;
+    uint8_t i;
+    //---------
+    if(LoadLog(log) != 0)
+        return 1;
+    if(sym != NULL)
+    {
+        if((fp = fopen(sym, "r")) == NULL)
+        {
+            perror(sym);
+            return 1;
+        }
+        while(fgets(line, sizeof(line), fp))
+            if(strncmp(line, "_SoftUARTChTransmitByte ", 24) == 0)
+                source = 1;
+        fclose(fp);
+    }
+    MeasureTx(&m[0], &m[1]);
+    late = MeasureRx(&m[2], &m[3], &m[4]);
+    //---------
+    printf("\nSUART_MODE_DELAY bit loops measured on %s, %u MHz, %u bauds, %u cycles per bit, %u frames received late:\n",
+           log, (unsigned)FOSC_MHZ, (unsigned)SUART_BAUD, (unsigned)SUART_BIT_CYCLES, (unsigned)late);
+    printf("%-24s %7s %9s %7s\n", "constant", "header", "measured", "frames");
+    for(i = 0; i < 5; ++i)
+    {
+        printf("%-24s %7ld %4ld..%-4ld %6u  ", m[i].Name, m[i].Header, m[i].Min, m[i].Max, (unsigned)m[i].Count);
+        if(m[i].Count == 0)
+        {
+            printf("not measured\n");
+            fail |= source;
+        }
+        else if(m[i].Header < m[i].Min - 1 || m[i].Header > m[i].Max + 1)
+        {
+            printf("%s\n", source ? "FAIL" : "differs");
+            fail |= source;
+        }
+        else
+            printf("ok\n");
+    }
+    if(!source)
+    {
+        printf("NOT VERIFIED: %s does not come from SoftwareUART.c (no _SoftUARTChTransmitByte symbol), rebuild the production image\n",
+               sym ? sym : "the image");
+        fail = 1;                                               //!< The header constants are not checked
+    }
+    //---------
+    return fail;
+}
+//-----------------------------------
+
+int main(int argc, char **argv)
+{
+    //---------
+    uint8_t i, j;
+    uint32_t fosc, baud;
+    double ideal, stop;
+    const char *log = NULL, *sym = NULL;
+    int fail = 0, opt;
+    //---------
+    for(opt = 1; opt + 1 < argc; opt += 2)
+    {
+        if(strcmp(argv[opt], "-l") == 0)
+            log = argv[opt + 1];
+        else if(strcmp(argv[opt], "-y") == 0)
+            sym = argv[opt + 1];
+    }
+    if(opt != argc)
+    {
+        fprintf(stderr, "usage: suart-timing [-l <pic18sim log> -y <image.sym>]\n");
+        return 2;
+    }
+    //---------
+    printf("%6s %8s %8s %6s %9s %9s %8s  %-11s %-11s %s\n", "MHz", "baud", "cyc/bit", "err", "tx delay", "rx start", "rx stop", "delay", "compare", "tick");
+    for(i = 0; i < sizeof(Supported) / sizeof(Supported[0]); ++i)
+    {
+        for(j = 0; j < sizeof(Bauds) / sizeof(Bauds[0]); ++j)
+        {
+            fosc = Supported[i].FoscMhz;
+            baud = Bauds[j];
+            ideal = fosc * 250000.0 / baud;
+            stop = 100.0 * 9.5 * (SUART_BIT_CYCLES_OF(fosc, baud) - ideal) / ideal;   //!< Drift at the stop bit sample
+            printf("%6u %8u %8u %3u.%u%% %9ld %9ld %7.1f%%  %-11s ", (unsigned)fosc, (unsigned)baud,
+                   (unsigned)SUART_BIT_CYCLES_OF(fosc, baud), (unsigned)SUART_BIT_ERROR_OF(fosc, baud) / 10,
+                   (unsigned)SUART_BIT_ERROR_OF(fosc, baud) % 10,
+                   SUART_TX_BIT_DELAY_OF(fosc, baud), SUART_RX_START_DELAY_OF(fosc, baud), stop,
+                   Status(SUART_VALID_OF(fosc, baud), baud, Supported[i].MaxBaud, &fail));
+            printf("%-11s ", Status(SUART_CMP_VALID_OF(fosc, baud), baud, Supported[i].CmpMaxBaud, &fail));
+            printf("%s\n", Status(SUART_TICK_VALID_OF(fosc, baud), baud, Supported[i].TickMaxBaud, &fail));
+        }
+    }
+    //---------
+    if(log != NULL && Measure(log, sym) != 0)
+        fail = 1;
+    //---------
+    return fail;
+}
+//-----------------------------------
@@ -0,0 +1,376 @@
+/**
+ ******************************************************************************
+ * @file            TraceDecode.c
+ * @author          Maxime
+ * @brief           Decoder of the binary trace output of the production image
+ * @brief           Reads the bytes sent by the Trace library (See Trace.h) from a capture
+ *                  file or the standard input, and prints one line per event. The event IDs
+ *                  are the program memory addresses of the format strings: they are read from
+ *                  the Intel HEX file of the same build, and the argument sizes are deduced
+ *                  from their conversions (4 bytes with 'l', 2 bytes otherwise).
+ *
+ * @note            A byte that does not start a valid event (its ID does not point to a printable,
+ *                  '\0' terminated string of the image) is printed as "?? <hex>" and skipped: the
+ *                  decoder resynchronizes on the next event after a corrupted one.
+ *
+ * @note            The host benchmark links the decoder without the tool (HOST_BUILD, See
+ *                  TraceDecode.h): it decodes the events sent on the simulated USART.
+ *
+ * @note            Usage:
+ @verbatim
+    tracedecode [options] <image.hex> [capture]
+        -r                  Print the event bytes before each line
+ @endverbatim
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "TraceDecode.h"
+//-----------------------------------
+
+//-----------------------------------
+#define ROM_SIZE                0x8000                          //!< 32KB program memory
+#define ROM_MASK                (ROM_SIZE - 1)                  //!< XC8 may flag program memory pointers above
+#define MAX_FMT                 128                             //!< Longest format string
+#define MAX_CAPTURE             (1024 * 1024)
+#define ID_LOST                 0x0000                          //!< See TRACE_ID_LOST
+//-----------------------------------
+
+#if !defined(HOST_BUILD)
+//-----------------------------------
+static uint8_t Rom[ROM_SIZE];
+static uint8_t Capture[MAX_CAPTURE];
+//-----------------------------------
+
+static void Usage(void)
+{
+    fprintf(stderr, "usage: tracedecode [-r] <image.hex> [capture]\n");
+}
+//-----------------------------------
+
+static int LoadHex(const char *file)
+{
+    //---------
+    FILE *fp = fopen(file, "r");
+    char line[600];
+    uint32_t base = 0, addr, i, cnt, type, byte;
+    //---------
+    if(fp == NULL)
+    {
+        perror(file);
+        return 1;
+    }
+    memset(Rom, 0xFF, sizeof(Rom));
+    while(fgets(line, sizeof(line), fp))
+    {
+        if(line[0] != ':' || sscanf(line + 1, "%2x%4x%2x", &cnt, &addr, &type) != 3)
+            continue;
+        if(type == 0x01)
+            break;
+        if(type == 0x04 || type == 0x02)
+        {
+            sscanf(line + 9, "%4x", &base);
+            base = (type == 0x04) ? (base << 16) : (base << 4);
+            continue;
+        }
+        if(type != 0x00)
+            continue;
+        for(i = 0; i < cnt; ++i)
+        {
+            if(sscanf(line + 9 + 2 * i, "%2x", &byte) != 1)
+                break;
+            if(base + addr + i < ROM_SIZE)
+                Rom[base + addr + i] = (uint8_t)byte;
+        }
+    }
+    fclose(fp);
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+/**
+ * @brief   Format string of an event ID
+ * @retval  string, NULL if the ID does not point to a printable string
+ *
+ */
+static const char *FormatOf(uint16_t id)
+{
+    //---------
+    uint32_t addr = id & ROM_MASK, i;
+    uint8_t c;
+    //---------
+    if(addr == 0)
+        return NULL;
+    for(i = addr; i < ROM_SIZE && i - addr < MAX_FMT; ++i)
+    {
+        c = Rom[i];
+        if(c == '\0')
+            return i != addr ? (const char *)&Rom[addr] : NULL;
+        if((c < 0x20 || c > 0x7E) && c != '\r' && c != '\n' && c != '\t')
+            return NULL;
+    }
+    //---------
+    return NULL;
+}
+//-----------------------------------
+#endif
+
+/**
+ * @brief   Parse a conversion, see Format.h
+ * @retval  end of the conversion
+ *
+ */
+static const char *Conversion(const char *fmt, int *left, int *zero, int *width, int *decimals, int *size, char *type)
+{
+    //---------
+    *left = *zero = *width = *decimals = 0;
+    for(; *fmt == '-' || *fmt == '0'; ++fmt)
+        *(*fmt == '-' ? left : zero) = 1;
+    for(; *fmt >= '0' && *fmt <= '9'; ++fmt)
+        *width = *width * 10 + (*fmt - '0');
+    if(*fmt == '.')
+    {
+        ++fmt;
+        if(*fmt >= '1' && *fmt <= '9')
+            *decimals = *fmt++ - '0';
+    }
+    *size = 2;
+    if(*fmt == 'l')
+    {
+        *size = 4;
+        ++fmt;
+    }
+    *type = *fmt;
+    if(*fmt != '\0')
+        ++fmt;
+    if(*type != 'd' && *type != 'u' && *type != 'x' && *type != 'X' && *type != 'c')
+        *size = 0;                                              //!< "%%", %s and unknown conversions have no argument
+    //---------
+    return fmt;
+}
+//-----------------------------------
+
+/**
+ * @brief   Number of argument bytes of a format string
+ *
+ */
+static uint32_t ArgSize(const char *fmt)
+{
+    //---------
+    int left, zero, width, decimals, size;
+    uint32_t total = 0;
+    char type;
+    //---------
+    while(*fmt)
+    {
+        if(*fmt++ != '%')
+            continue;
+        fmt = Conversion(fmt, &left, &zero, &width, &decimals, &size, &type);
+        total += (uint32_t)size;
+    }
+    //---------
+    return total;
+}
+//-----------------------------------
+
+/**
+ * @brief   Print an event like FormatPrint() would on the device
+ *
+ */
+static void PrintEvent(FILE *out, const char *fmt, const uint8_t *args)
+{
+    //---------
+    int left, zero, width, decimals, size, len, pad;
+    char num[48], sign;
+    uint32_t value;
+    char type;
+    //---------
+    while(*fmt)
+    {
+        if(*fmt != '%')
+        {
+            fputc(*fmt == '\r' ? '\n' : *fmt, out);
+            ++fmt;
+            continue;
+        }
+        fmt = Conversion(fmt + 1, &left, &zero, &width, &decimals, &size, &type);
+        value = 0;
+        if(size == 4)
+            value = (uint32_t)args[0] | (uint32_t)args[1] << 8 | (uint32_t)args[2] << 16 | (uint32_t)args[3] << 24;
+        else if(size == 2)
+            value = (uint32_t)args[0] | (uint32_t)args[1] << 8;
+        args += size;
+        //---------
+        sign = 0;
+        switch(type)
+        {
+            case 'd':
+                if(size == 2 && (value & 0x8000))
+                    value |= 0xFFFF0000UL;                      //!< Sign extended
+                if(value & 0x80000000UL)
+                {
+                    sign = '-';
+                    value = 0 - value;
+                }
+                /* fall through */
+            case 'u':
+                snprintf(num, sizeof(num), "%lu", (unsigned long)value);
+                if(decimals != 0)                               //!< Fixed point
+                {
+                    len = (int)strlen(num);
+                    if(len <= decimals)
+                    {
+                        memmove(num + decimals + 1 - len, num, (size_t)len + 1);
+                        memset(num, '0', (size_t)(decimals + 1 - len));
+                        len = decimals + 1;
+                    }
+                    memmove(num + len - decimals + 1, num + len - decimals, (size_t)decimals + 1);
+                    num[len - decimals] = '.';
+                }
+                break;
+            case 'x':
+            case 'X':
+                snprintf(num, sizeof(num), type == 'x' ? "%lx" : "%lX", (unsigned long)value);
+                break;
+            case 'c':
+                snprintf(num, sizeof(num), "%c", (char)value);
+                zero = 0;
+                break;
+            case 's':
+                snprintf(num, sizeof(num), "<%%s>");
+                zero = 0;
+                break;
+            default:
+                snprintf(num, sizeof(num), "%c", type ? type : '%');
+                left = zero = width = 0;
+                break;
+        }
+        //---------
+        len = (int)strlen(num) + (sign != 0);
+        pad = width > len ? width - len : 0;
+        if(!left && !zero)
+            fprintf(out, "%*s", pad, "");
+        if(sign)
+            fputc(sign, out);
+        if(!left && zero)
+            fprintf(out, "%0*d", pad, 0);
+        fputs(num, out);
+        if(left)
+            fprintf(out, "%*s", pad, "");
+    }
+    //---------
+}
+//-----------------------------------
+
+void TraceDecode(const uint8_t *data, uint32_t n, TraceFormatType format, int raw, FILE *out,
+                 TraceDecodeStatsType *stats)
+{
+    //---------
+    const char *fmt;
+    uint32_t i, j, size;
+    uint16_t id;
+    //---------
+    memset(stats, 0, sizeof(*stats));
+    for(i = 0; i + 2 <= n; i += size)
+    {
+        id = (uint16_t)(data[i] | data[i + 1] << 8);
+        fmt = format(id);
+        if(id == ID_LOST)
+            size = 4;
+        else if(fmt != NULL)
+            size = 2 + ArgSize(fmt);
+        else
+        {
+            fprintf(out, "?? %02X\n", data[i]);
+            ++stats->Skipped;
+            size = 1;
+            continue;
+        }
+        if(i + size > n)
+            break;
+        if(raw)
+        {
+            for(j = 0; j < size; ++j)
+                fprintf(out, "%02X ", data[i + j]);
+            fprintf(out, "| ");
+        }
+        if(id == ID_LOST)
+        {
+            fprintf(out, "<%u events lost>\n", (unsigned)(data[i + 2] | data[i + 3] << 8));
+            stats->Lost += (uint32_t)(data[i + 2] | data[i + 3] << 8);
+            continue;
+        }
+        PrintEvent(out, fmt, &data[i + 2]);
+        j = (uint32_t)strlen(fmt);
+        if(fmt[j - 1] != '\r' && fmt[j - 1] != '\n')
+            fputc('\n', out);
+        ++stats->Events;
+    }
+    if(i < n)
+    {
+        stats->Incomplete = n - i;
+        fprintf(out, "<%u bytes of an incomplete event>\n", (unsigned)(n - i));
+    }
+    //---------
+}
+//-----------------------------------
+
+#if !defined(HOST_BUILD)
+int main(int argc, char **argv)
+{
+    //---------
+    const char *hex = NULL, *capture = NULL;
+    TraceDecodeStatsType stats;
+    FILE *fp = stdin;
+    uint32_t n;
+    int opt, raw = 0;
+    //---------
+    for(opt = 1; opt < argc; ++opt)
+    {
+        if(strcmp(argv[opt], "-r") == 0)
+            raw = 1;
+        else if(argv[opt][0] == '-')
+        {
+            Usage();
+            return 2;
+        }
+        else if(hex == NULL)
+            hex = argv[opt];
+        else
+            capture = argv[opt];
+    }
+    if(hex == NULL)
+    {
+        Usage();
+        return 2;
+    }
+    if(LoadHex(hex) != 0)
+        return 1;
+    if(capture != NULL && (fp = fopen(capture, "rb")) == NULL)
+    {
+        perror(capture);
+        return 1;
+    }
+    n = (uint32_t)fread(Capture, 1, sizeof(Capture), fp);
+    if(fp != stdin)
+        fclose(fp);
+    //---------
+    TraceDecode(Capture, n, FormatOf, raw, stdout, &stats);
+    fprintf(stderr, "%u events, %u lost, %u bytes skipped\n", (unsigned)stats.Events, (unsigned)stats.Lost,
+            (unsigned)stats.Skipped);
+    //---------
+    return 0;
+}
+//-----------------------------------
+#endif
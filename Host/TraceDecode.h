@@ -0,0 +1,66 @@
+/**
+ ******************************************************************************
+ * @file            TraceDecode.h
+ * @author          Maxime
+ * @brief           header file for the decoder of the binary trace output
+ * @brief           The decoder of the tracedecode tool (See TraceDecode.c), for the host
+ *                  programs that check the events sent by the Trace library: the format
+ *                  strings are looked up by a function of the caller instead of the .hex file.
+ *
+ * @note            History:
+ *                  - Oct 17, 2026: Initial release
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+#ifndef TRACEDECODE_H
+#define	TRACEDECODE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------
+#include <stdio.h>
+#include <stdint.h>
+//-----------------------------------
+
+/**
+ * @brief   Format string lookup type: the format string of an event ID, NULL if it is not one
+ *
+ */
+typedef const char *(*TraceFormatType)(uint16_t id);
+
+typedef struct
+{
+    uint32_t Events;                                            //!< Events printed
+    uint32_t Lost;                                              //!< Events reported lost by the loss records
+    uint32_t Skipped;                                           //!< Bytes that start no valid event
+    uint32_t Incomplete;                                        //!< Bytes of the last event, cut by the end of the capture
+}TraceDecodeStatsType;
+
+//-----------------------------------
+/**
+ * @brief   Print the events of a capture, one line per event
+ * @param   data: captured bytes
+ * @param   n: number of bytes
+ * @param   format: format string lookup
+ * @param   raw: 1 to print the event bytes before each line
+ * @param   out: output stream
+ * @param   stats: event and error counts
+ * @retval  none
+ */
+extern void TraceDecode(const uint8_t *data, uint32_t n, TraceFormatType format, int raw, FILE *out,
+                        TraceDecodeStatsType *stats);
+//-----------------------------------
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* TRACEDECODE_H */
@@ -0,0 +1,242 @@
+/**
+ ******************************************************************************
+ * @file            xc.h
+ * @author          Maxime
+ * @brief           Host (gcc) stand-in for the XC8 <xc.h> device header
+ * @brief           This file maps the PIC18F452 Special Function Registers used
+ *                  by the API onto the simulated register file of HostSim.c.
+ *                  Every register access goes through HostSfr(), which counts
+ *                  the access and runs the peripheral models (USART TRMT/TXIF/RCIF
+ *                  timing, interrupt flags) before returning the register address.
+ *
+ * @note            Only used by the host build (make host), it must never be
+ *                  part of the MPLAB project.
+ *
+ * @note            Registers that are not modeled behave like plain RAM.
+ *
+ * @note            History:
+ *                  - Oct 16, 2026: Initial release
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+#ifndef HOST_XC_H
+#define	HOST_XC_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------
+#include <stdint.h>
+//-----------------------------------
+
+#ifndef HOST_BUILD
+#define HOST_BUILD
+#endif
+
+#define _18F452                                                         //!< Simulated device
+
+//-----------------------------------
+/**
+ * @brief   Access a simulated Special Function Register
+ * @param   addr: register address, from 0xF80 to 0xFFF
+ * @retval  register location
+ * @note    See HostSim.c
+ */
+extern volatile uint8_t *HostSfr(uint16_t addr);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Access a simulated Special Function Register through a pointer
+ * @param   reg: register location, as returned by HostSfr()
+ * @retval  register location
+ * @note    Used by SFR_PTR_ACCESS() (See PIC18Types.h), so that accesses through
+ *          register pointers are counted as well.
+ */
+extern volatile uint8_t *HostSfrPtr(volatile uint8_t *reg);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Burn instruction cycles in the simulated device
+ * @param   cycles: number of instruction cycles (FOSC/4)
+ * @retval  none
+ * @note    See HostSim.c
+ */
+extern void HostSimDelay(uint32_t cycles);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Execute the SLEEP instruction in the simulated device
+ * @param   none
+ * @retval  none
+ * @note    See HostSim.c
+ */
+extern void HostSimSleep(void);
+//-----------------------------------
+
+/** @defgroup HOST_XC_COMPILER XC8 keywords and built-ins
+ * @{
+ */
+#define interrupt
+#define high_priority
+#define low_priority
+#define __interrupt(x)
+#define __bit                                       uint8_t
+
+#define di()                                        (INTCONbits.GIE = 0)
+#define ei()                                        (INTCONbits.GIE = 1)
+#define NOP()                                       HostSimDelay(1)
+#define CLRWDT()                                    HostSimDelay(1)
+#define SLEEP()                                     HostSimSleep()
+#define _delay(x)                                   HostSimDelay((uint32_t)(x))
+#define __delay_us(x)                               HostSimDelay((uint32_t)((x) * (uint32_t)FOSC_MHZ / 4))
+#define __delay_ms(x)                               HostSimDelay((uint32_t)((x) * (uint32_t)FOSC_MHZ * 250))
+/**
+  * @}
+  */
+
+/** @defgroup HOST_XC_SFR_ADDRESSES Special Function Registers
+ * @{
+ */
+#define HOST_SFR(addr)                              (*HostSfr(addr))
+#define HOST_SFR16(addr)                            (*(volatile uint16_t *)HostSfr(addr))
+#define HOST_SFR_BITS(type, addr)                   (*(volatile type *)HostSfr(addr))
+
+#define PORTA                                       HOST_SFR(0xF80)
+#define PORTB                                       HOST_SFR(0xF81)
+#define PORTC                                       HOST_SFR(0xF82)
+#define PORTD                                       HOST_SFR(0xF83)
+#define PORTE                                       HOST_SFR(0xF84)
+#define LATA                                        HOST_SFR(0xF89)
+#define LATB                                        HOST_SFR(0xF8A)
+#define LATC                                        HOST_SFR(0xF8B)
+#define LATD                                        HOST_SFR(0xF8C)
+#define LATE                                        HOST_SFR(0xF8D)
+#define TRISA                                       HOST_SFR(0xF92)
+#define TRISB                                       HOST_SFR(0xF93)
+#define TRISC                                       HOST_SFR(0xF94)
+#define TRISD                                       HOST_SFR(0xF95)
+#define TRISE                                       HOST_SFR(0xF96)
+#define PIE1                                        HOST_SFR(0xF9D)
+#define PIR1                                        HOST_SFR(0xF9E)
+#define IPR1                                        HOST_SFR(0xF9F)
+#define PIE2                                        HOST_SFR(0xFA0)
+#define PIR2                                        HOST_SFR(0xFA1)
+#define IPR2                                        HOST_SFR(0xFA2)
+#define EECON1                                      HOST_SFR(0xFA6)
+#define EECON2                                      HOST_SFR(0xFA7)
+#define EEDATA                                      HOST_SFR(0xFA8)
+#define EEADR                                       HOST_SFR(0xFA9)
+#define RCSTA                                       HOST_SFR(0xFAB)
+#define TXSTA                                       HOST_SFR(0xFAC)
+#define TXREG                                       HOST_SFR(0xFAD)
+#define RCREG                                       HOST_SFR(0xFAE)
+#define SPBRG                                       HOST_SFR(0xFAF)
+#define T3CON                                       HOST_SFR(0xFB1)
+#define TMR3L                                       HOST_SFR(0xFB2)
+#define TMR3H                                       HOST_SFR(0xFB3)
+#define TMR3                                        HOST_SFR16(0xFB2)
+#define CCP2CON                                     HOST_SFR(0xFBA)
+#define CCPR2L                                      HOST_SFR(0xFBB)
+#define CCPR2H                                      HOST_SFR(0xFBC)
+#define CCPR2                                       HOST_SFR16(0xFBB)
+#define CCP1CON                                     HOST_SFR(0xFBD)
+#define CCPR1L                                      HOST_SFR(0xFBE)
+#define CCPR1H                                      HOST_SFR(0xFBF)
+#define CCPR1                                       HOST_SFR16(0xFBE)
+#define ADCON1                                      HOST_SFR(0xFC1)
+#define ADCON0                                      HOST_SFR(0xFC2)
+#define ADRESL                                      HOST_SFR(0xFC3)
+#define ADRESH                                      HOST_SFR(0xFC4)
+#define T2CON                                       HOST_SFR(0xFCA)
+#define PR2                                         HOST_SFR(0xFCB)
+#define TMR2                                        HOST_SFR(0xFCC)
+#define T1CON                                       HOST_SFR(0xFCD)
+#define TMR1L                                       HOST_SFR(0xFCE)
+#define TMR1H                                       HOST_SFR(0xFCF)
+#define TMR1                                        HOST_SFR16(0xFCE)
+#define RCON                                        HOST_SFR(0xFD0)
+#define WDTCON                                      HOST_SFR(0xFD1)
+#define LVDCON                                      HOST_SFR(0xFD2)
+#define OSCCON                                      HOST_SFR(0xFD3)
+#define T0CON                                       HOST_SFR(0xFD5)
+#define TMR0L                                       HOST_SFR(0xFD6)
+#define TMR0H                                       HOST_SFR(0xFD7)
+#define TMR0                                        HOST_SFR16(0xFD6)
+#define STATUS                                      HOST_SFR(0xFD8)
+#define WREG                                        HOST_SFR(0xFE8)
+#define INTCON3                                     HOST_SFR(0xFF0)
+#define INTCON2                                     HOST_SFR(0xFF1)
+#define INTCON                                      HOST_SFR(0xFF2)
+#define TABLAT                                      HOST_SFR(0xFF5)
+#define TBLPTRL                                     HOST_SFR(0xFF6)
+#define TBLPTRH                                     HOST_SFR(0xFF7)
+#define TBLPTRU                                     HOST_SFR(0xFF8)
+#define STKPTR                                      HOST_SFR(0xFFC)
+/**
+  * @}
+  */
+
+/** @defgroup HOST_XC_SFR_BITS Special Function Registers bit fields
+ * @{
+ */
+typedef struct { uint8_t TX9D:1, TRMT:1, BRGH:1, :1, SYNC:1, TXEN:1, TX9:1, CSRC:1; } TXSTAbits_t;
+typedef struct { uint8_t RX9D:1, OERR:1, FERR:1, ADDEN:1, CREN:1, SREN:1, RX9:1, SPEN:1; } RCSTAbits_t;
+typedef struct { uint8_t TMR1IF:1, TMR2IF:1, CCP1IF:1, SSPIF:1, TXIF:1, RCIF:1, ADIF:1, PSPIF:1; } PIR1bits_t;
+typedef struct { uint8_t TMR1IE:1, TMR2IE:1, CCP1IE:1, SSPIE:1, TXIE:1, RCIE:1, ADIE:1, PSPIE:1; } PIE1bits_t;
+typedef struct { uint8_t TMR1IP:1, TMR2IP:1, CCP1IP:1, SSPIP:1, TXIP:1, RCIP:1, ADIP:1, PSPIP:1; } IPR1bits_t;
+typedef struct { uint8_t CCP2IF:1, TMR3IF:1, LVDIF:1, BCLIF:1, EEIF:1, :3; } PIR2bits_t;
+typedef struct { uint8_t CCP2IE:1, TMR3IE:1, LVDIE:1, BCLIE:1, EEIE:1, :3; } PIE2bits_t;
+typedef struct { uint8_t CCP2IP:1, TMR3IP:1, LVDIP:1, BCLIP:1, EEIP:1, :3; } IPR2bits_t;
+typedef struct { uint8_t RBIF:1, INT0IF:1, TMR0IF:1, RBIE:1, INT0IE:1, TMR0IE:1, PEIE:1, GIE:1; } INTCONbits_t;
+typedef struct { uint8_t RBIP:1, :1, TMR0IP:1, :1, INTEDG2:1, INTEDG1:1, INTEDG0:1, RBPU:1; } INTCON2bits_t;
+typedef struct { uint8_t INT1IF:1, INT2IF:1, :1, INT1IE:1, INT2IE:1, :1, INT1IP:1, INT2IP:1; } INTCON3bits_t;
+typedef struct { uint8_t POR:1, BOR:1, PD:1, TO:1, RI:1, :2, IPEN:1; } RCONbits_t;
+typedef struct { uint8_t T0PS:3, PSA:1, T0SE:1, T0CS:1, T08BIT:1, TMR0ON:1; } T0CONbits_t;
+typedef struct { uint8_t TMR1ON:1, TMR1CS:1, T1SYNC:1, T1OSCEN:1, T1CKPS:2, :1, RD16:1; } T1CONbits_t;
+typedef struct { uint8_t T2CKPS:2, TMR2ON:1, TOUTPS:4, :1; } T2CONbits_t;
+typedef struct { uint8_t TMR3ON:1, TMR3CS:1, T3SYNC:1, T3CCP1:1, T3CKPS:2, T3CCP2:1, RD16:1; } T3CONbits_t;
+typedef struct { uint8_t CCP1M:4, DC1B:2, :2; } CCP1CONbits_t;
+typedef struct { uint8_t CCP2M:4, DC2B:2, :2; } CCP2CONbits_t;
+typedef struct { uint8_t SP:5, :1, STKUNF:1, STKFUL:1; } STKPTRbits_t;
+typedef struct { uint8_t SCS:1, :7; } OSCCONbits_t;
+typedef struct { uint8_t R0:1, R1:1, R2:1, R3:1, R4:1, R5:1, R6:1, R7:1; } HostPortbits_t;
+
+#define TXSTAbits                                   HOST_SFR_BITS(TXSTAbits_t, 0xFAC)
+#define RCSTAbits                                   HOST_SFR_BITS(RCSTAbits_t, 0xFAB)
+#define PIR1bits                                    HOST_SFR_BITS(PIR1bits_t, 0xF9E)
+#define PIE1bits                                    HOST_SFR_BITS(PIE1bits_t, 0xF9D)
+#define IPR1bits                                    HOST_SFR_BITS(IPR1bits_t, 0xF9F)
+#define PIR2bits                                    HOST_SFR_BITS(PIR2bits_t, 0xFA1)
+#define PIE2bits                                    HOST_SFR_BITS(PIE2bits_t, 0xFA0)
+#define IPR2bits                                    HOST_SFR_BITS(IPR2bits_t, 0xFA2)
+#define INTCONbits                                  HOST_SFR_BITS(INTCONbits_t, 0xFF2)
+#define INTCON2bits                                 HOST_SFR_BITS(INTCON2bits_t, 0xFF1)
+#define INTCON3bits                                 HOST_SFR_BITS(INTCON3bits_t, 0xFF0)
+#define RCONbits                                    HOST_SFR_BITS(RCONbits_t, 0xFD0)
+#define T0CONbits                                   HOST_SFR_BITS(T0CONbits_t, 0xFD5)
+#define T1CONbits                                   HOST_SFR_BITS(T1CONbits_t, 0xFCD)
+#define T2CONbits                                   HOST_SFR_BITS(T2CONbits_t, 0xFCA)
+#define T3CONbits                                   HOST_SFR_BITS(T3CONbits_t, 0xFB1)
+#define CCP1CONbits                                 HOST_SFR_BITS(CCP1CONbits_t, 0xFBD)
+#define CCP2CONbits                                 HOST_SFR_BITS(CCP2CONbits_t, 0xFBA)
+#define STKPTRbits                                  HOST_SFR_BITS(STKPTRbits_t, 0xFFC)
+#define OSCCONbits                                  HOST_SFR_BITS(OSCCONbits_t, 0xFD3)
+/**
+  * @}
+  */
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* HOST_XC_H */
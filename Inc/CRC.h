@@ -0,0 +1,318 @@
+/**
+ ******************************************************************************
+ * @file            CRC.h
+ * @author          Maxime
+ * @brief           header file for PIC18 CRC library
+ * @brief           This library computes the CRC-8, CRC-16 and CRC-32 of data
+ *                  streams, one byte at a time (CRCxxUpdate()) or by blocks
+ *                  (CRCxxBlock()):
+ *                      - CRC-8: polynomial 0x07, initial value 0x00 (CRC-8/SMBUS)
+ *                      - CRC-16: polynomial 0x1021, initial value 0xFFFF (CRC-16/CCITT-FALSE)
+ *                      - CRC-32: polynomial 0x04C11DB7 reflected, initial value 0xFFFFFFFF,
+ *                        final XOR 0xFFFFFFFF (CRC-32 of Ethernet, zip, PNG)
+ *                  The CRC of "123456789" is 0xF4, 0x29B1 and 0xCBF43926.
+ *
+ * @note            Each CRC has 3 implementations, selected per product with CRCxx_METHOD
+ *                  for the CRCxxUpdate() and CRCxxBlock() functions:
+ *                      - CRC_METHOD_BITWISE: no table, 8 shift/XOR steps per byte
+ *                      - CRC_METHOD_NIBBLE: 16 entries table, 2 lookups per byte
+ *                      - CRC_METHOD_TABLE: 256 entries table, 1 lookup per byte
+ *                  The tables are const: XC8 places them in program memory and reads
+ *                  them with TBLRD. The implementations that are not called are not
+ *                  linked, nor are their tables. CRCBenchmark() measures the cycles
+ *                  per byte of each of them on the target.
+ *
+ * @note            The update functions keep no state: they can be called from the interrupt
+ *                  service routines (XC8 duplicates the functions called from both contexts).
+ *
+ * @note            Usage:
+ @verbatim
+                    uint16_t crc = CRC16_INIT;
+                    crc = CRC16Block(crc, header, sizeof(header));
+                    crc = CRC16Update(crc, data);
+                    ...
+                    uint32_t crc32 = CRC32Final(CRC32Block(CRC32_INIT, data, len));
+ @endverbatim
+ *
+ * @brief           Written for the PIC 18F452 with XC8, not compiled by it yet: the host build
+ *                  checks the 9 implementations and the block functions against the CRC of
+ *                  "123456789", and the bitwise, nibble and table implementations against each
+ *                  other (See "make bench", crc_check_123456789). CRCBenchmark() only runs
+ *                  on the target.
+ * @brief           See dependencies in the include section.
+ *
+ *
+ * @note            History:
+ *                  - Oct 16, 2026: Initial release
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+#ifndef CRC_H
+#define	CRC_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------
+#include <xc.h>
+#include <stdint.h>
+//-----------------------------------
+
+/** @defgroup CRC_METHOD_CONSTANTS CRC implementations
+ * @{
+ */
+#define CRC_METHOD_BITWISE                          0                   //!< No table
+#define CRC_METHOD_NIBBLE                           1                   //!< 16 entries table: 16, 32 or 64 bytes of flash
+#define CRC_METHOD_TABLE                            2                   //!< 256 entries table: 256, 512 or 1024 bytes of flash
+/**
+  * @}
+  */
+
+/** @defgroup CRC_CONFIG CRC settings
+ * @{
+ * @brief They can be overridden from the project settings (XC8 Global Options -> Define macros).
+ */
+#ifndef CRC8_METHOD
+#define CRC8_METHOD                                 CRC_METHOD_NIBBLE   //!< Implementation of CRC8Update() and CRC8Block(), See CRC_METHOD_CONSTANTS
+#endif
+#ifndef CRC16_METHOD
+#define CRC16_METHOD                                CRC_METHOD_NIBBLE   //!< Implementation of CRC16Update() and CRC16Block(), See CRC_METHOD_CONSTANTS
+#endif
+#ifndef CRC32_METHOD
+#define CRC32_METHOD                                CRC_METHOD_NIBBLE   //!< Implementation of CRC32Update() and CRC32Block(), See CRC_METHOD_CONSTANTS
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup CRC_INIT_CONSTANTS CRC initial values
+ * @{
+ */
+#define CRC8_INIT                                   0x00
+#define CRC16_INIT                                  0xFFFF
+#define CRC32_INIT                                  0xFFFFFFFFUL
+/**
+  * @}
+  */
+
+//-----------------------------------
+/**
+ * @brief   Final value of a CRC-32
+ * @param   crc: CRC after the last byte
+ */
+#define CRC32Final(crc)                             ((uint32_t)~(crc))
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Add a byte to a CRC-8, with the CRC8_METHOD implementation
+ * @param   crc: current CRC, CRC8_INIT for the first byte
+ * @param   data: byte
+ * @retval  updated CRC
+ */
+#if (CRC8_METHOD == CRC_METHOD_TABLE)
+#define CRC8Update(crc, data)               CRC8TableUpdate((crc), (data))
+#elif (CRC8_METHOD == CRC_METHOD_NIBBLE)
+#define CRC8Update(crc, data)               CRC8NibbleUpdate((crc), (data))
+#else
+#define CRC8Update(crc, data)               CRC8BitUpdate((crc), (data))
+#endif
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Add a byte to a CRC-16, with the CRC16_METHOD implementation
+ * @param   crc: current CRC, CRC16_INIT for the first byte
+ * @param   data: byte
+ * @retval  updated CRC
+ */
+#if (CRC16_METHOD == CRC_METHOD_TABLE)
+#define CRC16Update(crc, data)              CRC16TableUpdate((crc), (data))
+#elif (CRC16_METHOD == CRC_METHOD_NIBBLE)
+#define CRC16Update(crc, data)              CRC16NibbleUpdate((crc), (data))
+#else
+#define CRC16Update(crc, data)              CRC16BitUpdate((crc), (data))
+#endif
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Add a byte to a CRC-32, with the CRC32_METHOD implementation
+ * @param   crc: current CRC, CRC32_INIT for the first byte
+ * @param   data: byte
+ * @retval  updated CRC
+ */
+#if (CRC32_METHOD == CRC_METHOD_TABLE)
+#define CRC32Update(crc, data)              CRC32TableUpdate((crc), (data))
+#elif (CRC32_METHOD == CRC_METHOD_NIBBLE)
+#define CRC32Update(crc, data)              CRC32NibbleUpdate((crc), (data))
+#else
+#define CRC32Update(crc, data)              CRC32BitUpdate((crc), (data))
+#endif
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Add a byte to a CRC-8, without table
+ * @param       crc: current CRC
+ * @param       data: byte
+ * @retval      updated CRC
+ *
+ */
+extern uint8_t CRC8BitUpdate(uint8_t crc, uint8_t data);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Add a byte to a CRC-8, with the 16 entries table
+ * @param       crc: current CRC
+ * @param       data: byte
+ * @retval      updated CRC
+ *
+ */
+extern uint8_t CRC8NibbleUpdate(uint8_t crc, uint8_t data);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Add a byte to a CRC-8, with the 256 entries table
+ * @param       crc: current CRC
+ * @param       data: byte
+ * @retval      updated CRC
+ *
+ */
+extern uint8_t CRC8TableUpdate(uint8_t crc, uint8_t data);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Add a block of bytes to a CRC-8, with the CRC8_METHOD implementation
+ * @param       crc: current CRC, CRC8_INIT for the first block
+ * @param       data: bytes
+ * @param       len: number of bytes
+ * @retval      updated CRC
+ *
+ */
+extern uint8_t CRC8Block(uint8_t crc, const uint8_t *data, uint16_t len);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Add a byte to a CRC-16, without table
+ * @param       crc: current CRC
+ * @param       data: byte
+ * @retval      updated CRC
+ *
+ */
+extern uint16_t CRC16BitUpdate(uint16_t crc, uint8_t data);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Add a byte to a CRC-16, with the 16 entries table
+ * @param       crc: current CRC
+ * @param       data: byte
+ * @retval      updated CRC
+ *
+ */
+extern uint16_t CRC16NibbleUpdate(uint16_t crc, uint8_t data);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Add a byte to a CRC-16, with the 256 entries table
+ * @param       crc: current CRC
+ * @param       data: byte
+ * @retval      updated CRC
+ *
+ */
+extern uint16_t CRC16TableUpdate(uint16_t crc, uint8_t data);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Add a block of bytes to a CRC-16, with the CRC16_METHOD implementation
+ * @param       crc: current CRC, CRC16_INIT for the first block
+ * @param       data: bytes
+ * @param       len: number of bytes
+ * @retval      updated CRC
+ *
+ */
+extern uint16_t CRC16Block(uint16_t crc, const uint8_t *data, uint16_t len);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Add a byte to a CRC-32, without table
+ * @param       crc: current CRC
+ * @param       data: byte
+ * @retval      updated CRC
+ *
+ */
+extern uint32_t CRC32BitUpdate(uint32_t crc, uint8_t data);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Add a byte to a CRC-32, with the 16 entries table
+ * @param       crc: current CRC
+ * @param       data: byte
+ * @retval      updated CRC
+ *
+ */
+extern uint32_t CRC32NibbleUpdate(uint32_t crc, uint8_t data);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Add a byte to a CRC-32, with the 256 entries table
+ * @param       crc: current CRC
+ * @param       data: byte
+ * @retval      updated CRC
+ *
+ */
+extern uint32_t CRC32TableUpdate(uint32_t crc, uint8_t data);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Add a block of bytes to a CRC-32, with the CRC32_METHOD implementation
+ * @param       crc: current CRC, CRC32_INIT for the first block
+ * @param       data: bytes
+ * @param       len: number of bytes
+ * @retval      updated CRC
+ *
+ */
+extern uint32_t CRC32Block(uint32_t crc, const uint8_t *data, uint16_t len);
+//-----------------------------------
+
+#if defined(USE_PROFILE)
+//-----------------------------------
+/**
+ * @brief       Measure the cycles per byte of every implementation, with the profiler time base
+ * @param       print: string output function, e.g. USARTPrint or SoftUARTPrint
+ * @retval      none
+ * @note        Line format, the loop overhead is included:
+ @verbatim
+                <crc>_<method> <cycles> cycles/byte, <table size> bytes of table\r
+ @endverbatim
+ * @note        The profiler must be initialized (See ProfileInit()), all the tables are linked.
+ *
+ */
+extern void CRCBenchmark(void (*print)(const char *str));
+//-----------------------------------
+#endif
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* CRC_H */
+
@@ -0,0 +1,132 @@
+/**
+ ******************************************************************************
+ * @file            Format.h
+ * @author          Maxime
+ * @brief           header file for PIC18 formatted output library
+ * @brief           This library is a small printf(): the characters are written one at a time
+ *                  to a sink function (USARTPutByte(), SoftUARTTransmitByte() or a buffer with
+ *                  FormatString()), without a line buffer. Conversions:
+ @verbatim
+                    %[-][0][width][.decimals][l]<d|u|x|X|c|s|%>
+
+                    d, u        signed, unsigned decimal
+                    x, X        hexadecimal, lower or upper case
+                    c, s        character, string
+                    -           left aligned in width, right aligned otherwise
+                    0           padded with zeros instead of spaces (d, u, x, X)
+                    width       minimum number of characters, up to 255
+                    .decimals   fixed point (d, u), 1 to 9: the value is printed with a decimal
+                                point before its last <decimals> digits, 1234 with %.2u is 12.34
+                    l           long (32 bits) argument, int (16 bits) otherwise
+ @endverbatim
+ *
+ * @note            The numbers are converted without division: each digit is the number of times
+ *                  its power of ten can be subtracted (9 subtractions at most), with 16 bits
+ *                  arithmetic below 65536. XC8 printf() divides by 10 on 32 bits for every digit.
+ *
+ * @note            The flash used by this library and by the XC8 printf() are reported by
+ *                  "make footprint". FormatBenchmark() measures both on the target.
+ *
+ * @note            Usage:
+ @verbatim
+                    FormatPrint(USARTPutByte, "T=%.1d C, rx=%u/%lu %s\r", temp, ok, total, name);
+                    FormatPrint(SoftUARTTransmitByte, "status=%02X\r", status);
+                    len = FormatString(line, sizeof(line), "%-8s%5u\r", name, count);
+ @endverbatim
+ *
+ * @brief           Written for the PIC 18F452 with XC8, not compiled by it yet: the host build
+ *                  checks FormatString() against known answers (signs, padding, fixed point,
+ *                  long and hexadecimal conversions, truncation) and the log lines sent on the
+ *                  simulated USART (See "make bench", format_string_known_answers and
+ *                  log_text_100_events_9600). FormatBenchmark() only runs on the target.
+ * @brief           See dependencies in the include section.
+ *
+ *
+ * @note            History:
+ *                  - Oct 16, 2026: Initial release
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+#ifndef FORMAT_H
+#define	FORMAT_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------
+#include <xc.h>
+#include <stdint.h>
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Output function type: writes one character
+ *
+ */
+typedef void (*FormatSinkType)(uint8_t data);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Write a formatted string to a sink
+ * @param       sink: output function, called once per character
+ * @param       fmt: format string, see the conversions above
+ * @param       ...: arguments
+ * @retval      none
+ *
+ */
+extern void FormatPrint(FormatSinkType sink, const char *fmt, ...);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Write a formatted string to a buffer
+ * @param       buf: destination, always terminated by '\0'
+ * @param       size: buffer size, the output is truncated to size - 1 characters
+ * @param       fmt: format string, see the conversions above
+ * @param       ...: arguments
+ * @retval      number of characters written, without the '\0'
+ * @note        Not reentrant: it must not be called from both the interrupts and the main loop.
+ *
+ */
+extern uint8_t FormatString(char *buf, uint8_t size, const char *fmt, ...);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Append the decimal value of a number to a string
+ * @param       str: destination, not terminated
+ * @param       value: number
+ * @retval      end of the string
+ *
+ */
+extern char *FormatDec(char *str, uint32_t value);
+//-----------------------------------
+
+#if defined(USE_PROFILE)
+//-----------------------------------
+/**
+ * @brief       Measure the cycles used by FormatString() and the XC8 sprintf() on the same lines
+ * @param       print: output function, USARTPrint() or SoftUARTPrint() for instance
+ * @retval      none
+ * @note        Prints "<format> sprintf=<cycles> format=<cycles>" for each test line.
+ *              The timings include the Timer3 overflows, run it with interrupts enabled.
+ *
+ */
+extern void FormatBenchmark(void (*print)(const char *str));
+//-----------------------------------
+#endif
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* FORMAT_H */
+
@@ -9,14 +9,11 @@
  * 
  * @note            History:
  *                  - Jan 24, 2023: Initial release
+ *                  - Oct 16, 2026: Pin descriptors, masked multi-pin writes and port compare
  * 
- * @note            It has been successfully tested with:
- *                  - IDEs: 
- *                      * MPLAB X IDE v5.30
- *                  - Compilers: 
- *                      * XC8 V1.45
- *                  - Devices: 
- *                      * PIC 18F452
+ * @note            The Jan 24, 2023 release was tested with MPLAB X IDE v5.30 and XC8 V1.45 on a
+ *                  PIC 18F452. The pin descriptors and multi-pin writes were not compiled by XC8
+ *                  yet: only the host build runs them (See "make bench", gpio_*).
  ******************************************************************************
  * @attention
  *
@@ -173,6 +170,130 @@ extern "C" {
  */    
 #define GPIORBPUDisable()                       (INTCON2 = INTCON2 | 0x80)
 //-----------------------------------    
+
+/** @defgroup GPIO_PIN_DESCRIPTORS I/O pin descriptors
+ * @{
+ * @brief   A descriptor names one or several pins of a port: it expands to the port constant
+ *          and the pins mask, both resolved at compile time. The GPIOPinxxx() macros take a
+ *          descriptor as their single argument:
+ @verbatim
+            #define LED                 GPIO_PIN(GPIOA, 0)
+            #define DATA_BUS            GPIO_PINS(GPIOD, 0x0F)
+
+            GPIOPinOutput(LED);
+            GPIOPinSet(LED);                            // BSF LATA, 0
+            GPIOPinWrite(DATA_BUS, nibble);             // RD0 to RD3 updated at once
+ @endverbatim
+ * @note    With a constant single pin descriptor, GPIOPinSet(), GPIOPinClear() and GPIOPinToggle()
+ *          compile to one BSF, BCF or BTG instruction: they cannot be disturbed by an interrupt
+ *          writing to the same LAT register. GPIOPinWrite() ends with one XORWF on the LAT register,
+ *          which only flips the pins of the mask: the other pins of the port may be driven from an
+ *          interrupt service routine meanwhile.
+ */
+#define GPIO_PIN(PORT, PIN)                     PORT, (uint8_t)(1 << (PIN))     //!< Descriptor of one pin, PIN from 0 to 7
+#define GPIO_PINS(PORT, MASK)                   PORT, (uint8_t)(MASK)           //!< Descriptor of the pins of a port set in MASK
+/**
+  * @}
+  */
+
+//-----------------------------------
+/**
+ * @brief   Descriptor expansion helpers, not to be used directly
+ */
+#define GPIO_DESC_OUTPUT(PORT, MASK)            (GPIO.Bytes[(PORT) + IO_TRIS_OFFSET] &= (uint8_t)~(MASK))
+#define GPIO_DESC_INPUT(PORT, MASK)             (GPIO.Bytes[(PORT) + IO_TRIS_OFFSET] |= (MASK))
+#define GPIO_DESC_SET(PORT, MASK)               (GPIO.Bytes[(PORT) + IO_LATCH_OFFSET] |= (MASK))
+#define GPIO_DESC_CLEAR(PORT, MASK)             (GPIO.Bytes[(PORT) + IO_LATCH_OFFSET] &= (uint8_t)~(MASK))
+#define GPIO_DESC_TOGGLE(PORT, MASK)            (GPIO.Bytes[(PORT) + IO_LATCH_OFFSET] ^= (MASK))
+#define GPIO_DESC_WRITE(PORT, MASK, VALUE)      (GPIO.Bytes[(PORT) + IO_LATCH_OFFSET] ^= (uint8_t)((GPIO.Bytes[(PORT) + IO_LATCH_OFFSET] ^ (VALUE)) & (MASK)))
+#define GPIO_DESC_READ(PORT, MASK)              (uint8_t)(GPIO.Bytes[(PORT) + IO_PORT_OFFSET] & (MASK))
+#define GPIO_DESC_GET(PORT, MASK)               (uint8_t)((GPIO.Bytes[(PORT) + IO_PORT_OFFSET] & (MASK)) != 0)
+#define GPIO_DESC_EQUAL(PORT, MASK, VALUE)      (uint8_t)(((GPIO.Bytes[(PORT) + IO_PORT_OFFSET] ^ (VALUE)) & (MASK)) == 0)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Configures the pins of a descriptor as outputs
+ * @param   DESC: pin descriptor (See GPIO_PIN_DESCRIPTORS)
+ * @retval  None
+ */
+#define GPIOPinOutput(DESC)                     GPIO_DESC_OUTPUT(DESC)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Configures the pins of a descriptor as inputs
+ * @param   DESC: pin descriptor (See GPIO_PIN_DESCRIPTORS)
+ * @retval  None
+ */
+#define GPIOPinInput(DESC)                      GPIO_DESC_INPUT(DESC)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Sets the pins of a descriptor to logic '1'
+ * @param   DESC: pin descriptor (See GPIO_PIN_DESCRIPTORS)
+ * @retval  None
+ */
+#define GPIOPinSet(DESC)                        GPIO_DESC_SET(DESC)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Sets the pins of a descriptor to logic '0'
+ * @param   DESC: pin descriptor (See GPIO_PIN_DESCRIPTORS)
+ * @retval  None
+ */
+#define GPIOPinClear(DESC)                      GPIO_DESC_CLEAR(DESC)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Toggles the pins of a descriptor
+ * @param   DESC: pin descriptor (See GPIO_PIN_DESCRIPTORS)
+ * @retval  None
+ */
+#define GPIOPinToggle(DESC)                     GPIO_DESC_TOGGLE(DESC)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Writes the pins of a descriptor in one LAT register update, the other pins are left as they are
+ * @param   DESC: pin descriptor (See GPIO_PIN_DESCRIPTORS)
+ * @param   VALUE: pins levels, at their port position (bits out of the mask are ignored)
+ * @retval  None
+ * @note    Example: GPIOPinWrite(GPIO_PINS(GPIOB, 0xF0), 0x50);    // RB4 and RB6 to '1', RB5 and RB7 to '0'
+ */
+#define GPIOPinWrite(DESC, VALUE)               GPIO_DESC_WRITE(DESC, VALUE)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Reads the pins of a descriptor
+ * @param   DESC: pin descriptor (See GPIO_PIN_DESCRIPTORS)
+ * @retval  pins levels at their port position, the other bits are 0
+ */
+#define GPIOPinRead(DESC)                       GPIO_DESC_READ(DESC)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Gets the state of a single pin descriptor, or whether any pin of a descriptor is '1'
+ * @param   DESC: pin descriptor (See GPIO_PIN_DESCRIPTORS)
+ * @retval  0 or 1
+ */
+#define GPIOPinGet(DESC)                        GPIO_DESC_GET(DESC)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Compares the pins of a descriptor to a value, in one port read
+ * @param   DESC: pin descriptor (See GPIO_PIN_DESCRIPTORS)
+ * @param   VALUE: expected levels, at their port position (bits out of the mask are ignored)
+ * @retval  1 when all the pins match, 0 otherwise
+ */
+#define GPIOPinEqual(DESC, VALUE)               GPIO_DESC_EQUAL(DESC, VALUE)
+//-----------------------------------
     
 #ifdef	__cplusplus
 }
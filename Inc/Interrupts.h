@@ -9,14 +9,15 @@
  * 
  * @note            History:
  *                   - Jan 28, 2023: Initial release
+ *                   - Oct 16, 2026: Interrupt handlers dispatcher, INT1/INT2/EEPROM constants fixed
+ *                   - Oct 16, 2026: Interrupt handlers latency and duration statistics
+ *                   - Oct 17, 2026: Timer interrupts latency from the timer count, dispatch delay otherwise
+ *                   - Oct 17, 2026: Timer3 time base shared with the profiler, InterruptTimeBaseStart()
  * 
- * @note            It has been successfully tested with:
- *                  IDE: 
- *                      - MPLAB X IDE v5.30
- *                  Compiler: 
- *                      - XC8 V1.45
- *                  Devices: 
- *                      - PIC 18F452
+ * @note            The Jan 28, 2023 release was tested with MPLAB X IDE v5.30 and XC8 V1.45 on a
+ *                  PIC 18F452. The dispatcher, the statistics and the Timer3 time base were not
+ *                  compiled by XC8 yet: only the host build runs them (See "make bench",
+ *                  interrupt_*, and the handlers of the systime_* and usart_* benchmarks).
  ******************************************************************************
  * @attention
  *
@@ -45,6 +46,52 @@ extern "C" {
 /**
   * @}
   */
+
+/** @defgroup INTERRUPT_DISPATCHER_CONFIG Interrupt handlers dispatcher settings
+ * @{
+ * @brief With the dispatcher, the Interrupt Service Routines only call the handlers
+ *        registered with InterruptRegisterHandler() whose interrupt is both enabled and flagged,
+ *        in priority order, instead of calling every driver callback on every interrupt.
+ */
+#define USE_INTERRUPT_DISPATCHER                                        //!< Comment this line to call the drivers callbacks unconditionally from the ISRs (See ISR.c)
+#ifndef INTERRUPT_MAX_HANDLERS
+#define INTERRUPT_MAX_HANDLERS                      8                   //!< Maximum number of registered interrupt handlers, about 12 bytes of RAM each
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup INTERRUPT_STATS_CONFIG Interrupt handlers statistics settings
+ * @{
+ * @brief With the dispatcher and USE_INTERRUPT_STATS, every handler call is timestamped with Timer3
+ *        (free running, one count per instruction cycle) and recorded per interrupt source:
+ *          - latency, timer sources (Timer0, Timer1, Timer3 overflows, Timer2 PR2 match) on the
+ *            instruction clock: from the interrupt flag to the handler call, read from the timer
+ *            count since the overflow (since the match for Timer2) times its prescaler. It includes
+ *            the hardware latency, the interrupts disabled, the higher priority interrupt, the
+ *            context saving and the handlers serviced first. Exact to the prescaler, modulo the
+ *            timer period. A timer reloaded before its handler runs (another handler writing it)
+ *            reads a wrong latency.
+ *          - dispatch delay, other sources: from the dispatcher entry to the handler call, i.e.
+ *            the time spent behind the handlers serviced first only. Their flag time is unknown.
+ *          - duration: handler execution time.
+ *        Both as min/max/mean and as a histogram of INTERRUPT_STATS_BUCKETS buckets: bucket 0 counts
+ *        the values below 2^(INTERRUPT_STATS_SHIFT + 1) cycles, bucket n the values from
+ *        2^(INTERRUPT_STATS_SHIFT + n) to 2^(INTERRUPT_STATS_SHIFT + n + 1) - 1 cycles, the last
+ *        bucket every value above. See InterruptStatsInit(), InterruptGetStats(), InterruptStatsPrint().
+ * @note  Timer3 must not be used by the application with this option. Each handler call costs
+ *        about 60 more instruction cycles, and each handler 23 + 4 * INTERRUPT_STATS_BUCKETS bytes of RAM.
+ */
+//#define USE_INTERRUPT_STATS                                             //!< Uncomment this line to record the interrupt handlers statistics
+#ifndef INTERRUPT_STATS_BUCKETS
+#define INTERRUPT_STATS_BUCKETS                     8                   //!< Histogram buckets, from 2 to 16
+#endif
+#ifndef INTERRUPT_STATS_SHIFT
+#define INTERRUPT_STATS_SHIFT                       4                   //!< Histogram scale: first bucket below 2^(INTERRUPT_STATS_SHIFT + 1) cycles
+#endif
+/**
+  * @}
+  */
     
 /** @defgroup INTERRUPT_EN_DIS_CONSTANTS Interrupt enable/disable constants
  * @{
@@ -71,8 +118,8 @@ extern "C" {
  * @{
  * 
  */          
-#define INT1_INT_ENABLE                             0x80                //!< Enable/disable external interrupt 1   
-#define INT2_INT_ENABLE                             0x01                //!< Enable/disable external interrupt 2
+#define INT1_INT_ENABLE                             0x08                //!< Enable/disable external interrupt 1   
+#define INT2_INT_ENABLE                             0x10                //!< Enable/disable external interrupt 2
 /**
   * @}
   */ 
@@ -97,7 +144,7 @@ extern "C" {
  * @{
  * 
  */          
-#define EE_FLASH_WRITE_INT_ENABLE                   0x01                //!< Enable/disable Data EEPROM/FLASH Write Operation Interrupt  
+#define EE_FLASH_WRITE_INT_ENABLE                   0x10                //!< Enable/disable Data EEPROM/FLASH Write Operation Interrupt  
 #define BCL_INT_ENABLE                              0x08                //!< Enable/disable Bus Collision Interrupt
 #define LVD_INT_ENABLE                              0x04                //!< Enable/disable Low Voltage Detect Interrupt
 #define TMR3_INT_ENABLE                             0x02                //!< Enable/disable Timer 3 overflow interrupt 
@@ -131,8 +178,8 @@ extern "C" {
  * @{
  * @brief These constants could be used as arguments for the GetInterruptFlag() function
  */     
-#define INT1_INT_FLAG                               0x0102          //!< External interrupt 1 flag
-#define INT2_INT_FLAG                               0x0101          //!< External interrupt 2 flag     
+#define INT1_INT_FLAG                               0x0101          //!< External interrupt 1 flag
+#define INT2_INT_FLAG                               0x0102          //!< External interrupt 2 flag     
 /**
   * @}
   */     
@@ -144,7 +191,7 @@ extern "C" {
 #define PSP_RW_INT_FLAG                             0x0280          //!< Paralel Slave Port FLAG   
 #define ADC_INT_FLAG                                0x0240          //!< Analog/Digital Converter FLAG
 #define USART_RX_INT_FLAG                           0x0220          //!< USART receive interrupt flag
-#define UART_TX_INT_FLAG                            0x0201          //!< USART transmit interrupt flag
+#define UART_TX_INT_FLAG                            0x0210          //!< USART transmit interrupt flag
 #define MSSP_INT_FLAG                               0x0208          //!< Master Synchronous Serial Port interrupt flag
 #define CCP1_INT_FLAG                               0x0204          //!< Capture/Compare/PWM 1 interrupt flag
 #define TMR2_PR2_INT_FLAG                           0x0202          //!< Timer 2 to PR2 match interrupt flag
@@ -182,6 +229,20 @@ extern "C" {
   * @}
   */ 
     
+/** @defgroup INTERRUPT_HANDLER_PRIORITY_CONSTANTS Interrupt handler dispatch priority constants
+ * @{
+ * @brief These constants could be used as arguments for the InterruptRegisterHandler() function.
+ *        Any value from 0 (serviced first) to 255 (serviced last) can be used.
+ */
+#define INTERRUPT_HANDLER_PRIORITY_HIGHEST          0                   //!< Serviced first
+#define INTERRUPT_HANDLER_PRIORITY_HIGH             64
+#define INTERRUPT_HANDLER_PRIORITY_NORMAL           128
+#define INTERRUPT_HANDLER_PRIORITY_LOW              192
+#define INTERRUPT_HANDLER_PRIORITY_LOWEST           255                 //!< Serviced last
+/**
+  * @}
+  */
+
 /** @defgroup INTERRUPT_PRIORITY_CONSTANTS Interrupt priority select constants
  * @{
  * @brief These constants could be used as arguments for the SetINTPriorityHigh(), SetINTPriorityLow() functions
@@ -295,7 +356,7 @@ extern "C" {
  * @param   none   
  * @retval  none
  */    
-#define InterruptPriorityDisable()                  (RCON = RCON & 0x80)
+#define InterruptPriorityDisable()                  (RCON = RCON & 0x7F)
 //----------------------------------- 
 
 /**
@@ -461,6 +522,160 @@ extern void InterruptSetPriorityHigh(ConfigType cfg);
 extern void InterruptSetPriorityLow(ConfigType cfg);
 //----------------------------------- 
 
+//-----------------------------------
+/**
+ * @brief   Interrupt handler type, see InterruptRegisterHandler()
+ * @note    The handler is called with the interrupt flag set, it must clear it
+ *          (or remove its cause, e.g. read RCREG) before returning.
+ */
+typedef void (*InterruptHandlerType)(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Register the handler of an interrupt source in the dispatcher
+ * @param   flag: one of @ref INTERRUPT_FLAG_CONSTANTS, the enable and priority registers/bits are derived from it
+ * @param   priority: dispatch order, from 0 (serviced first) to 255. See @ref INTERRUPT_HANDLER_PRIORITY_CONSTANTS
+ * @param   handler: function to call when the interrupt is enabled and flagged
+ * @retval  0: success, 1: handlers table full (See INTERRUPT_MAX_HANDLERS)
+ * @note    Registering a source again replaces its handler and priority. Handlers of the same
+ *          priority are serviced in registration order. The interrupt itself is not enabled.
+ * @note    Usage:
+ @verbatim void main(void)
+            {
+            ...
+            InterruptRegisterHandler(TMR0_OVF_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGHEST, SysTimeCallBack);
+            InterruptRegisterHandler(INT0_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGH, SoftUARTCallBack);
+            SystimeInit();
+            ...
+            }
+ @endverbatim
+ */
+extern uint8_t InterruptRegisterHandler(uint16_t flag, uint8_t priority, InterruptHandlerType handler);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Remove the handler of an interrupt source from the dispatcher
+ * @param   flag: one of @ref INTERRUPT_FLAG_CONSTANTS
+ * @retval  none
+ * @note    The interrupt itself is not disabled.
+ */
+extern void InterruptUnregisterHandler(uint16_t flag);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Call the registered handlers whose interrupt is enabled and flagged, in priority order
+ * @param   none
+ * @retval  none
+ * @note    To be called from the Interrupt Service Routine (See ISR.c). Each handler costs
+ *          two register reads when its interrupt is not pending.
+ */
+extern void InterruptDispatch(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Start Timer3 as the free running time base shared by the interrupt statistics and the
+ *          profiler (See Profile.h): instruction clock, no prescaler, 16 bits reads
+ * @param   none
+ * @retval  none
+ * @note    Nothing is done when Timer3 runs with this setting already: the second user does not
+ *          clear the counter under the first one. CCP1 and CCP2 stay on Timer1.
+ */
+extern void InterruptTimeBaseStart(void);
+//-----------------------------------
+
+#if defined(USE_INTERRUPT_STATS)
+//-----------------------------------
+/**
+ * @brief   Interrupt handler statistics type, see InterruptGetStats()
+ * @note    Times are in instruction cycles. The histograms saturate at 65535.
+ */
+typedef struct
+{
+    uint16_t Flag;                                              //!< Interrupt source, one of @ref INTERRUPT_FLAG_CONSTANTS
+    uint8_t Timer;                                              //!< 1: Latency* from the interrupt flag (timer source), 0: dispatch delay from the dispatcher entry. Set by the last call
+    uint32_t Count;                                             //!< Handler calls
+    uint16_t LatencyMin;
+    uint16_t LatencyMax;
+    uint32_t LatencySum;                                        //!< Mean: LatencySum / Count
+    uint16_t DurationMin;
+    uint16_t DurationMax;
+    uint32_t DurationSum;                                       //!< Mean: DurationSum / Count
+    uint16_t LatencyHist[INTERRUPT_STATS_BUCKETS];
+    uint16_t DurationHist[INTERRUPT_STATS_BUCKETS];
+}InterruptStatsType;
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Start Timer3 as the statistics time base and clear the statistics
+ * @param   none
+ * @retval  none
+ * @note    See InterruptTimeBaseStart(), the profiler shares the time base.
+ */
+extern void InterruptStatsInit(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Clear the statistics of every registered handler
+ * @param   none
+ * @retval  none
+ */
+extern void InterruptStatsClear(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Read the statistics of a registered handler
+ * @param   index: handler index in dispatch order, from 0
+ * @param   stats: statistics copy, taken with the interrupts disabled
+ * @retval  0: success, 1: no handler at this index
+ */
+extern uint8_t InterruptGetStats(uint8_t index, InterruptStatsType *stats);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Print the statistics of every registered handler, one line each
+ * @param   print: string output function, e.g. USARTPrint or SoftUARTPrint
+ * @retval  none
+ * @note    Line format, flag in hexadecimal, times in instruction cycles, histograms from bucket 0:
+ @verbatim
+            <flag> n=<calls> lat=<min>/<mean>/<max> [<hist>] dur=<min>/<mean>/<max> [<hist>]\r
+ @endverbatim
+ *          "dly=" replaces "lat=" for the sources timed from the dispatcher entry.
+ */
+extern void InterruptStatsPrint(void (*print)(const char *str));
+//-----------------------------------
+#endif
+
+#if defined(USE_HIGH_LOW_ISR)
+//-----------------------------------
+/**
+ * @brief   Same as InterruptDispatch(), limited to the high priority interrupt sources
+ * @param   none
+ * @retval  none
+ * @note    To be called from the high priority Interrupt Service Routine (See ISR.c).
+ *          INT0 is always a high priority interrupt source.
+ */
+extern void InterruptDispatchHigh(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Same as InterruptDispatch(), limited to the low priority interrupt sources
+ * @param   none
+ * @retval  none
+ * @note    To be called from the low priority Interrupt Service Routine (See ISR.c).
+ */
+extern void InterruptDispatchLow(void);
+//-----------------------------------
+#endif
+
 #ifdef	__cplusplus
 }
 #endif
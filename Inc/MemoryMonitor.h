@@ -0,0 +1,175 @@
+/**
+ ******************************************************************************
+ * @file            MemoryMonitor.h
+ * @author          Maxime
+ * @brief           header file for PIC18 hardware stack and RAM usage monitor
+ * @brief           This library measures how close the application gets to the
+ *                  memory limits of the device:
+ *                      - Hardware return stack (31 levels): the depth is sampled by
+ *                        MemMonStackSample() on every interrupt (See USE_STACK_MONITOR
+ *                        and ISR.c) and from the main loop, the stack full and underflow
+ *                        events (STKPTR.STKFUL/STKUNF) are counted and cleared.
+ *                      - RAM: buffers registered with MemMonAddRegion() are painted
+ *                        with MEMMON_PAINT_PATTERN, their high water mark is the
+ *                        offset of the last byte no longer holding the pattern.
+ *
+ * @note            With the Stack Full/Underflow Reset enabled (STVR = ON, See FUSE_CONFIG.c),
+ *                  an overflow resets the device and leaves STKFUL or STKUNF set: MemMonInit()
+ *                  reports it as the boot cause (MemMonGetStack()). The power-on reset clears them.
+ *
+ * @note            The samples are taken at the ISR entry: the deepest level reached by the
+ *                  interrupt handlers is the sampled depth plus their own call depth
+ *                  (2 for a handler called by the dispatcher).
+ *
+ * @note            The high water mark fits buffers filled from their start (line, frame and
+ *                  parser buffers, reentrant stacks). A ring buffer wraps around and gets fully
+ *                  painted over after its first turn.
+ *
+ * @brief           Written for the PIC 18F452 with XC8, not compiled by it yet: the host build
+ *                  checks the stack sampling, the boot cause, the high water mark and the
+ *                  MemMonPrint() report against known answers (See "make bench",
+ *                  memmon_stack_sample).
+ * @brief           See dependencies in the include section.
+ *
+ *
+ * @note            History:
+ *                  - Oct 16, 2026: Initial release
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+#ifndef MEMORYMONITOR_H
+#define	MEMORYMONITOR_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------
+#include <xc.h>
+#include <stdint.h>
+//-----------------------------------
+
+/** @defgroup MEMMON_CONFIG Memory monitor settings
+ * @{
+ * @brief They can be overridden from the project settings (XC8 Global Options -> Define macros).
+ */
+//#define USE_STACK_MONITOR                                               //!< Uncomment this line to sample the hardware stack depth on every interrupt (See ISR.c)
+#ifndef MEMMON_REGIONS
+#define MEMMON_REGIONS                              4                   //!< Maximum number of monitored RAM regions, 6 bytes of RAM each
+#endif
+#ifndef MEMMON_PAINT_PATTERN
+#define MEMMON_PAINT_PATTERN                        0xA5                //!< Value painted in the monitored RAM regions
+#endif
+#define MEMMON_STACK_LEVELS                         31                  //!< Hardware return stack levels
+/**
+  * @}
+  */
+
+/** @defgroup MEMMON_BOOT_CONSTANTS Boot cause flags
+ * @{
+ */
+#define MEMMON_BOOT_STACK_FULL                      0x80                //!< STKFUL was set at boot: stack overflow reset
+#define MEMMON_BOOT_STACK_UNDERFLOW                 0x40                //!< STKUNF was set at boot: stack underflow reset
+/**
+  * @}
+  */
+
+//-----------------------------------
+/**
+ * @brief   Hardware stack statistics type, see MemMonGetStack()
+ *
+ */
+typedef struct
+{
+    uint8_t MaxDepth;                                           //!< Deepest sampled level, from 0 to MEMMON_STACK_LEVELS
+    uint8_t Full;                                               //!< Stack full events seen, saturates at 255
+    uint8_t Underflow;                                          //!< Stack underflow events seen, saturates at 255
+    uint8_t Boot;                                               //!< See MEMMON_BOOT_CONSTANTS
+}MemMonStackType;
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Initialize the monitor: record the boot cause and clear the statistics
+ * @param       none
+ * @retval      none
+ * @note        To be called first in main(), before STKFUL/STKUNF can be set by the application.
+ *
+ */
+extern void MemMonInit(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Sample the hardware stack depth and account the stack full/underflow events
+ * @param       none
+ * @retval      none
+ * @note        Called on every interrupt with USE_STACK_MONITOR (See ISR.c), it can also
+ *              be called from any deep point of the main loop.
+ *
+ */
+extern void MemMonStackSample(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Read the hardware stack statistics
+ * @param       stack: statistics copy
+ * @retval      none
+ *
+ */
+extern void MemMonGetStack(MemMonStackType *stack);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Paint a RAM buffer and register it for the high water mark measurement
+ * @param       name: name printed by MemMonPrint()
+ * @param       buf: buffer
+ * @param       size: buffer size in bytes
+ * @retval      0: success, 1: regions table full (See MEMMON_REGIONS)
+ * @note        To be called before the buffer is used.
+ *
+ */
+extern uint8_t MemMonAddRegion(const char *name, void *buf, uint16_t size);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Give the high water mark of a painted buffer
+ * @param       buf: buffer
+ * @param       size: buffer size in bytes
+ * @retval      bytes used: offset after the last byte that does not hold MEMMON_PAINT_PATTERN
+ * @note        A byte written with MEMMON_PAINT_PATTERN is not seen as used.
+ *
+ */
+extern uint16_t MemMonHighWater(const void *buf, uint16_t size);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Print the hardware stack statistics and the high water mark of every region
+ * @param       print: string output function, e.g. USARTPrint or SoftUARTPrint
+ * @retval      none
+ * @note        Line format:
+ @verbatim
+                stack max=<depth>/31 full=<count> underflow=<count> boot=<flags in hexadecimal>\r
+                <name> used=<high water mark>/<size>\r
+ @endverbatim
+ *
+ */
+extern void MemMonPrint(void (*print)(const char *str));
+//-----------------------------------
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* MEMORYMONITOR_H */
+
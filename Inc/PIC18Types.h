@@ -84,7 +84,7 @@ typedef union
         uint8_t PD;                                 //!< I/O PORTD register: address [@ref GPIO_BASE + @ref IO_PORT_OFFSET + 3]
         uint8_t PE;                                 //!< I/O PORTE register: address [@ref GPIO_BASE + @ref IO_PORT_OFFSET + 4]        
         //---------
-        uint32_t;
+        uint8_t Reserved1[4];                         //!< Unimplemented
         //---------
         uint8_t LA;                                 //!< I/O LATCHA register: address [@ref GPIO_BASE + @ref IO_LATCH_OFFSET]
         uint8_t LB;                                 //!< I/O LATCHB register: address [@ref GPIO_BASE + @ref IO_LATCH_OFFSET + 1] 
@@ -92,7 +92,7 @@ typedef union
         uint8_t LD;                                 //!< I/O LATCHD register: address [@ref GPIO_BASE + @ref IO_LATCH_OFFSET + 3]
         uint8_t LE;                                 //!< I/O LATCHE register: address [@ref GPIO_BASE + @ref IO_LATCH_OFFSET + 4]                                         
         //---------
-        uint32_t;
+        uint8_t Reserved2[4];                         //!< Unimplemented
         //---------
         uint8_t TA;                                 //!< I/O TRISA register: address [@ref GPIO_BASE + @ref IO_TRIS_OFFSET]
         uint8_t TB;                                 //!< I/O TRISA register: address [@ref GPIO_BASE + @ref IO_TRIS_OFFSET + 1]
@@ -104,10 +104,24 @@ typedef union
 }IORegistersMapType;
 //----------------------
 
+#if defined(HOST_BUILD)
+#define IO                                  (*(volatile IORegistersMapType *)HostSfr(GPIO_BASE))   //!< Simulated register file, see Host/xc.h
+#else
 volatile IORegistersMapType IO              @GPIO_BASE;
+#endif
 #define GPIO                                IO
 /** @} */
 
+/**
+ * @brief   Access a Special Function Register through a pointer (e.g. volatile uint8_t *reg = &PIR1;)
+ *
+ */
+#if defined(HOST_BUILD)
+#define SFR_PTR_ACCESS(reg)                 (*HostSfrPtr(reg))                                      //!< Simulated register file, see Host/xc.h
+#else
+#define SFR_PTR_ACCESS(reg)                 (*(reg))
+#endif
+
 
 /** @defgroup GENERIC_TYPES 
   * @{
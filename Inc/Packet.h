@@ -0,0 +1,222 @@
+/**
+ ******************************************************************************
+ * @file            Packet.h
+ * @author          Maxime
+ * @brief           header file for PIC18 USART packet layer
+ * @brief           This library sends and receives packets over the USART,
+ *                  framed with SLIP (RFC 1055) and checked with a CRC-16:
+ @verbatim
+                    END <payload> <CRC-16 MSB> <CRC-16 LSB> END
+ @endverbatim
+ *                  END bytes (0xC0) of the payload and CRC are sent as ESC ESC_END
+ *                  (0xDB 0xDC), ESC bytes as ESC ESC_ESC (0xDB 0xDD). The CRC is the
+ *                  CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF) of the payload.
+ *
+ * @note            The encoding, the decoding and the CRC run in the USART interrupts,
+ *                  one byte per interrupt: the main loop only gets complete and valid packets.
+ *                  Received packets are decoded in place in PACKET_RX_SLOTS buffers and handed
+ *                  over by pointer (PacketReceive()), until released (PacketRelease()). The
+ *                  packet to send is read from the application buffer, not copied.
+ *
+ * @note            A receiver resynchronizes on the next END byte after noise: a broken packet
+ *                  fails the CRC and is counted, not delivered (See PacketGetStats()).
+ *
+ * @note            Usage:
+ @verbatim
+                    uint8_t *packet, len;
+
+                    USARTAsyncInitBaud(38400);
+                    PacketInit();
+                    MCUInterruptEnable();
+                    ...
+                    packet = PacketReceive(&len);
+                    if(packet != NULL)
+                    {
+                        ...                                         // Use packet[0] to packet[len - 1]
+                        PacketRelease();
+                    }
+                    if(!PacketTxBusy())
+                        PacketSend(report, sizeof(report));
+ @endverbatim
+ *
+ * @note            The packet layer owns the USART interrupts: the USART ring buffer and transmit
+ *                  queue (USARTRxIntEnable(), USARTTxIntEnable()) must not be used along with it.
+ *
+ * @brief           Written for the PIC 18F452 with XC8, not compiled by it yet: the host build
+ *                  sends 4 packets of 32 bytes, escapes included, through the simulated USART
+ *                  and checks they are received back intact (See "make bench",
+ *                  packet_loopback_4x32B_115200).
+ * @brief           See dependencies in the include section.
+ *
+ *
+ * @note            History:
+ *                  - Oct 16, 2026: Initial release
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+#ifndef PACKET_H
+#define	PACKET_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------
+#include <xc.h>
+#include <stdint.h>
+//-----------------------------------
+
+/** @defgroup PACKET_CONFIG Packet layer settings
+ * @{
+ * @brief They can be overridden from the project settings (XC8 Global Options -> Define macros).
+ */
+//#define USE_PACKET                                                      //!< Uncomment this line to call the packet layer call-backs instead of the USART ones in ISR.c (without USE_INTERRUPT_DISPATCHER)
+#ifndef PACKET_MAX_SIZE
+#define PACKET_MAX_SIZE                             32                  //!< Largest payload received, in bytes, from 1 to 253
+#endif
+#ifndef PACKET_RX_SLOTS
+#define PACKET_RX_SLOTS                             2                   //!< Receive buffers, PACKET_MAX_SIZE + 3 bytes of RAM each. Must be a power of two, from 1 to 8
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup PACKET_SLIP_CONSTANTS SLIP special bytes
+ * @{
+ */
+#define PACKET_END                                  0xC0                //!< Packet delimiter
+#define PACKET_ESC                                  0xDB                //!< Escape
+#define PACKET_ESC_END                              0xDC                //!< Escaped END
+#define PACKET_ESC_ESC                              0xDD                //!< Escaped ESC
+/**
+  * @}
+  */
+
+//-----------------------------------
+/**
+ * @brief   Packet layer counters type, see PacketGetStats()
+ *
+ */
+typedef struct
+{
+    uint16_t Received;                                          //!< Valid packets delivered
+    uint16_t CrcErr;                                            //!< Packets with a wrong CRC, or shorter than the CRC
+    uint16_t FormatErr;                                         //!< Invalid escape sequences and USART framing errors
+    uint16_t Oversize;                                          //!< Packets longer than PACKET_MAX_SIZE
+    uint16_t NoBuffer;                                          //!< Packets dropped because every receive buffer was in use
+    uint16_t HwOverrun;                                         //!< Hardware receive FIFO overruns (OERR)
+}PacketStatsType;
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Start the packet layer on the USART
+ * @param       none
+ * @retval      none
+ * @note        The USART must be initialized in asynchronous 8 bits mode (See USARTAsyncInit()).
+ *              The receive and peripheral interrupts are enabled, global interrupts must be
+ *              enabled by the application (See MCUInterruptEnable()).
+ *              With USE_INTERRUPT_DISPATCHER, PacketRxCallBack() and PacketTxCallBack() replace the
+ *              USART handlers in the dispatcher.
+ *
+ */
+extern void PacketInit(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Start sending a packet
+ * @param       data: payload, it must not be modified until PacketTxBusy() returns 0
+ * @param       len: payload length, from 0 to 255
+ * @retval      0: packet being sent, 1: a packet is being sent already
+ *
+ */
+extern uint8_t PacketSend(const uint8_t *data, uint8_t len);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Check whether a packet is being sent
+ * @param       none
+ * @retval      1: busy, 0: idle
+ * @note        The last byte may still be shifting out when it returns 0.
+ *
+ */
+extern uint8_t PacketTxBusy(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Get the oldest packet received
+ * @param       len: payload length
+ * @retval      payload, or NULL when no packet is waiting
+ * @note        The payload stays valid, and is returned again, until PacketRelease() is called.
+ *
+ */
+extern uint8_t *PacketReceive(uint8_t *len);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Give the buffer of the packet returned by PacketReceive() back to the receiver
+ * @param       none
+ * @retval      none
+ *
+ */
+extern void PacketRelease(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Read the packet layer counters
+ * @param       stats: counters copy
+ * @retval      none
+ *
+ */
+extern void PacketGetStats(PacketStatsType *stats);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Reset the packet layer counters
+ * @param       none
+ * @retval      none
+ *
+ */
+extern void PacketClearStats(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Call-back function of the USART receive interrupt, to be placed inside the interrupt
+ *              service routines without the dispatcher. See ISR.c file.
+ * @param       none
+ * @retval      none
+ *
+ */
+extern void PacketRxCallBack(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Call-back function of the USART transmit interrupt, to be placed inside the interrupt
+ *              service routines without the dispatcher. See ISR.c file.
+ * @param       none
+ * @retval      none
+ *
+ */
+extern void PacketTxCallBack(void);
+//-----------------------------------
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* PACKET_H */
+
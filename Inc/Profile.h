@@ -0,0 +1,220 @@
+/**
+ ******************************************************************************
+ * @file            Profile.h
+ * @author          Maxime
+ * @brief           header file for PIC18 code sections profiler
+ * @brief           This library measures the time spent in code sections of the
+ *                  main loop (e.g. USARTPrint(), SoftUARTPrint(), parsers): each
+ *                  section, identified by a number from 0 to PROFILE_SECTIONS - 1,
+ *                  is enclosed by PROFILE_BEGIN(id) and PROFILE_END(id), and its
+ *                  calls count, total, minimum and maximum durations are accumulated
+ *                  in instruction cycles.
+ *
+ * @note            The time base is Timer3, free running on the instruction clock without
+ *                  prescaler, extended to 32 bits by its overflow interrupt (one interrupt
+ *                  per 65536 instruction cycles). It is the time base of the interrupt
+ *                  statistics too (See USE_INTERRUPT_STATS and InterruptTimeBaseStart() in
+ *                  Interrupts.h): the second one initialized does not clear the counter.
+ *
+ * @note            The durations exclude the cost of the measurement: ProfileInit() measures
+ *                  empty PROFILE_BEGIN()/PROFILE_END() pairs and the shortest one is subtracted
+ *                  from every section.
+ *
+ * @note            Without USE_PROFILE, the PROFILE_xxx() macros compile to nothing.
+ *
+ * @note            Usage:
+ @verbatim
+                    #define PROFILE_PRINT           0               // Section numbers
+                    #define PROFILE_PARSE           1
+
+                    ProfileInit();
+                    ...
+                    PROFILE_BEGIN(PROFILE_PRINT);
+                    USARTPrint(str);
+                    PROFILE_END(PROFILE_PRINT);
+                    ...
+                    PROFILE_PRINT_REPORT(USARTPrint, NULL);     // Or a table of section names
+ @endverbatim
+ *
+ * @note            Sections of different numbers can be nested. The time spent in the
+ *                  interrupt service routines during a section is part of its duration.
+ *
+ * @brief           Written for the PIC 18F452 with XC8, not compiled by it yet: the host build
+ *                  checks the calibration on a 1000 cycles section (See "make bench",
+ *                  profile_begin_end). The host build charges no cycle to the C code: the
+ *                  overhead it calibrates out is only measured on the target.
+ * @brief           See dependencies in the include section.
+ *
+ *
+ * @note            History:
+ *                  - Oct 16, 2026: Initial release
+ *                  - Oct 17, 2026: Overhead calibrated on empty sections, Timer3 shared with the interrupt statistics
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+#ifndef PROFILE_H
+#define	PROFILE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------
+#include <xc.h>
+#include <stdint.h>
+//-----------------------------------
+
+/** @defgroup PROFILE_CONFIG Profiler settings
+ * @{
+ * @brief They can be overridden from the project settings (XC8 Global Options -> Define macros).
+ */
+//#define USE_PROFILE                                                     //!< Uncomment this line to compile the profiler in, Timer3 is then used by the library
+#ifndef PROFILE_SECTIONS
+#define PROFILE_SECTIONS                            8                   //!< Number of sections, 18 bytes of RAM each
+#endif
+/**
+  * @}
+  */
+
+#if defined(USE_PROFILE)
+
+//-----------------------------------
+/**
+ * @brief   Section statistics type, see ProfileGetSection()
+ * @note    Durations are in instruction cycles, the overhead of the measurement is removed.
+ */
+typedef struct
+{
+    uint32_t Start;                                             //!< Time of the last PROFILE_BEGIN()
+    uint32_t Total;                                             //!< Sum of the durations, wraps around after 2^32 cycles
+    uint32_t Min;
+    uint32_t Max;
+    uint16_t Count;                                             //!< Completed sections, saturates at 65535
+}ProfileSectionType;
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Start of a profiled section
+ * @param   id: section number, from 0 to PROFILE_SECTIONS - 1
+ */
+#define PROFILE_BEGIN(id)                           ProfileBegin(id)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   End of a profiled section
+ * @param   id: section number, from 0 to PROFILE_SECTIONS - 1
+ */
+#define PROFILE_END(id)                             ProfileEnd(id)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Print the profiler report, See ProfilePrint()
+ */
+#define PROFILE_PRINT_REPORT(print, names)          ProfilePrint((print), (names))
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Start Timer3 as the profiler time base, register its overflow handler, measure the
+ *              overhead of a section and clear the sections
+ * @param       none
+ * @retval      none
+ * @note        See InterruptTimeBaseStart(). With USE_INTERRUPT_DISPATCHER, ProfileCallBack() is
+ *              registered in the dispatcher.
+ */
+extern void ProfileInit(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Clear the statistics of every section
+ * @param       none
+ * @retval      none
+ */
+extern void ProfileClear(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Give the time of the profiler time base
+ * @param       none
+ * @retval      time in instruction cycles from Timer3 start, it wraps around after 2^32 cycles
+ */
+extern uint32_t ProfileTime(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Record the start of a section, use PROFILE_BEGIN()
+ * @param       id: section number
+ * @retval      none
+ */
+extern void ProfileBegin(uint8_t id);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Record the end of a section, use PROFILE_END()
+ * @param       id: section number
+ * @retval      none
+ */
+extern void ProfileEnd(uint8_t id);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Read the statistics of a section
+ * @param       id: section number
+ * @param       section: statistics copy
+ * @retval      0: success, 1: no such section
+ */
+extern uint8_t ProfileGetSection(uint8_t id, ProfileSectionType *section);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Print the statistics of every section called at least once, one line each
+ * @param       print: string output function, e.g. USARTPrint or SoftUARTPrint
+ * @param       names: table of PROFILE_SECTIONS section names, or NULL to print the section numbers
+ * @retval      none
+ * @note        Line format, durations in instruction cycles:
+ @verbatim
+                <name> n=<count> total=<total> min=<min> mean=<mean> max=<max>\r
+ @endverbatim
+ */
+extern void ProfilePrint(void (*print)(const char *str), const char *const *names);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Call-back function of the Timer3 overflow interrupt, to be placed inside the interrupt
+ *              service routines without the dispatcher. See ISR.c file.
+ * @param       none
+ * @retval      none
+ */
+extern void ProfileCallBack(void);
+//-----------------------------------
+
+#else
+
+#define PROFILE_BEGIN(id)                           ((void)0)
+#define PROFILE_END(id)                             ((void)0)
+#define PROFILE_PRINT_REPORT(print, names)          ((void)0)
+
+#endif
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* PROFILE_H */
+
@@ -0,0 +1,286 @@
+/**
+ ******************************************************************************
+ * @file            Scheduler.h
+ * @author          Maxime
+ * @brief           header file for PIC18 cooperative task scheduler
+ * @brief           This library runs several stackless tasks (protothreads) on
+ *                  one core: a task is a function that returns to the scheduler
+ *                  whenever it waits, and resumes after the wait on its next
+ *                  call. Waits yield the CPU instead of spinning like Wait_ms():
+ *                      - TASK_WAIT_MS(): the task sleeps on a software timer
+ *                        (See SoftTimer.h) and is not called until it expires.
+ *                      - TASK_SUSPEND_UNTIL(): the task sleeps until an interrupt
+ *                        handler calls SchedulerWake(), then checks its condition.
+ *                      - TASK_WAIT_UNTIL(): the task stays in the run queue and
+ *                        checks its condition once per turn.
+ *                      - TASK_YIELD(): the task lets the other ready tasks run.
+ *
+ * @note            Tasks share the one hardware stack, so their local variables are
+ *                  lost across a wait: use static variables or the task structure
+ *                  for the state kept over the waits. A wait cannot be placed inside a switch
+ *                  statement of the task, nor in a function called by the task.
+ *
+ * @note            Usage:
+ @verbatim
+                    static TaskType Blink;
+
+                    static uint8_t BlinkTask(TaskType *task)
+                    {
+                        TASK_BEGIN(task);
+                        while(1)
+                        {
+                            GPIOTogglePin(GPIOA, 0);
+                            TASK_WAIT_MS(task, 500);
+                        }
+                        TASK_END(task);
+                    }
+
+                    SystimeInit();
+                    SoftTimerInit();
+                    SchedulerInit();
+                    SchedulerAddTask(&Blink, BlinkTask);
+                    SchedulerRun();
+ @endverbatim
+ *
+ * @note            Only SchedulerWake() can be called from interrupt service routines: the
+ *                  request is queued with the interrupts disabled, and the task is put back in
+ *                  the run queue by the next SchedulerStep(). A task waiting on an interrupt
+ *                  with TASK_SUSPEND_UNTIL() is out of the run queue, so SchedulerRun() idles
+ *                  while nothing else is ready. TASK_WAIT_UNTIL() keeps the task ready: the
+ *                  CPU never idles while it waits, keep it for conditions no interrupt signals.
+ @verbatim
+                    static void EchoRxHook(uint8_t ch)          Interrupt context
+                    {
+                        SchedulerWake(&Echo);
+                    }
+                    ...
+                    TASK_SUSPEND_UNTIL(task, SoftUARTRxAvailable());
+ @endverbatim
+ *
+ * @brief           Written for the PIC 18F452 with XC8, not compiled by it yet: the host build
+ *                  runs 8 tasks for one simulated second (See "make bench",
+ *                  scheduler_step_8_tasks_1s).
+ * @brief           See dependencies in the include section.
+ *
+ *
+ * @note            History:
+ *                  - Oct 16, 2026: Initial release
+ *                  - Oct 17, 2026: SchedulerWake() from the interrupts, TASK_SUSPEND_UNTIL()
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+#ifndef SCHEDULER_H
+#define	SCHEDULER_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------
+#include <xc.h>
+#include <stdint.h>
+#include "SoftTimer.h"
+//-----------------------------------
+
+/** @defgroup TASK_RETURN_CONSTANTS Task function return values
+ * @{
+ * @brief Returned by the task functions through the TASK_xxx() macros only.
+ */
+#define TASK_YIELDED                                0                   //!< Ready, to be called again on the next turn
+#define TASK_WAITING                                1                   //!< Sleeping, called again on its timer expiry or SchedulerWake()
+#define TASK_ENDED                                  2                   //!< Removed from the scheduler
+/**
+  * @}
+  */
+
+/** @defgroup TASK_STATE_CONSTANTS Task states
+ * @{
+ */
+#define TASK_STATE_ENDED                            0                   //!< Not scheduled
+#define TASK_STATE_READY                            1                   //!< In the run queue
+#define TASK_STATE_WAITING                          2                   //!< Out of the run queue
+/**
+  * @}
+  */
+
+//-----------------------------------
+typedef struct TaskStruct TaskType;
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Task function type
+ * @param   task: the task being run
+ * @retval  TASK_YIELDED, TASK_WAITING or TASK_ENDED
+ *
+ */
+typedef uint8_t (*TaskFunctionType)(TaskType *task);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Task type, to be allocated by the application (static or global).
+ *          Its members are private to the library.
+ *
+ */
+struct TaskStruct
+{
+    TaskType *Next;                                             //!< Next task in the run queue
+    TaskFunctionType Function;                                  //!< Task function
+    SoftTimerType Timer;                                        //!< TASK_WAIT_MS() wake up timer
+    uint16_t Resume;                                            //!< Line of the last wait, 0 to start from TASK_BEGIN()
+    uint8_t State;                                              //!< See TASK_STATE_CONSTANTS
+    TaskType *WakeNext;                                         //!< Next SchedulerWake() request
+    volatile uint8_t WakePending;                               //!< In the SchedulerWake() requests
+};
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Start the body of a task function
+ * @param       task: the task function argument
+ *
+ */
+#define TASK_BEGIN(task)                            switch((task)->Resume) { case 0:
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       End the body of a task function, the task is removed from the scheduler when it gets there
+ * @param       task: the task function argument
+ *
+ */
+#define TASK_END(task)                              } (task)->Resume = 0; return TASK_ENDED
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Let the other ready tasks run, the task goes on from here on its next turn
+ * @param       task: the task function argument
+ *
+ */
+#define TASK_YIELD(task)                            do { (task)->Resume = __LINE__; return TASK_YIELDED; case __LINE__:; } while(0)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Yield until a condition is true, it is checked once per turn of the run queue.
+ *              The task stays ready: SchedulerRun() does not idle while it waits.
+ * @param       task: the task function argument
+ * @param       cond: the condition
+ *
+ */
+#define TASK_WAIT_UNTIL(task, cond)                 do { (task)->Resume = __LINE__; case __LINE__: if(!(cond)) return TASK_YIELDED; } while(0)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Sleep for a time, the task is not called until it elapses (or SchedulerWake())
+ * @param       task: the task function argument
+ * @param       ms: time in milliseconds, rounded up to SOFTTIMER_TICK_MS
+ *
+ */
+#define TASK_WAIT_MS(task, ms)                      do { SchedulerSleep((task), (ms)); (task)->Resume = __LINE__; return TASK_WAITING; case __LINE__:; } while(0)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Sleep until SchedulerWake() is called for the task
+ * @param       task: the task function argument
+ *
+ */
+#define TASK_SUSPEND(task)                          do { (task)->Resume = __LINE__; return TASK_WAITING; case __LINE__:; } while(0)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Sleep until a condition is true, it is checked when SchedulerWake() is called for the task
+ * @param       task: the task function argument
+ * @param       cond: the condition, to be signaled by a SchedulerWake() call when it becomes true
+ *
+ */
+#define TASK_SUSPEND_UNTIL(task, cond)              do { (task)->Resume = __LINE__; case __LINE__: if(!(cond)) return TASK_WAITING; } while(0)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Initialize the scheduler, with no task
+ * @param       none
+ * @retval      none
+ * @note        The software timers library must be initialized (See SoftTimerInit()).
+ *
+ */
+extern void SchedulerInit(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Add a task at the end of the run queue, started from TASK_BEGIN()
+ * @param       task: the task
+ * @param       function: the task function
+ * @retval      none
+ * @note        The task must not be scheduled already (TASK_STATE_ENDED). It can be called from a task.
+ *
+ */
+extern void SchedulerAddTask(TaskType *task, TaskFunctionType function);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Wake a waiting task up: it is put back in the run queue by the next SchedulerStep()
+ * @param       task: the task
+ * @retval      none
+ * @note        Can be called from the interrupts. A request made while the task runs wakes it
+ *              from the wait it returns with, so a condition signaled between its check and the
+ *              wait is not lost. Nothing is done for a task that is ready when the request is
+ *              handled.
+ *
+ */
+extern void SchedulerWake(TaskType *task);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Arm the wake up timer of a task, used by TASK_WAIT_MS()
+ * @param       task: the task
+ * @param       ms: time in milliseconds
+ * @retval      none
+ *
+ */
+extern void SchedulerSleep(TaskType *task, uint16_t ms);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Run the software timers, then every task that is ready, once
+ * @param       none
+ * @retval      number of tasks run
+ * @note        To be called from the main loop, along with the non cooperative code.
+ *
+ */
+extern uint8_t SchedulerStep(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Run the scheduler forever
+ * @param       none
+ * @retval      none
+ * @note        The CPU idles (See SysTimeIdle()) whenever no task is ready.
+ *
+ */
+extern void SchedulerRun(void);
+//-----------------------------------
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SCHEDULER_H */
+
@@ -0,0 +1,163 @@
+/**
+ ******************************************************************************
+ * @file            SoftTimer.h
+ * @author          Maxime
+ * @brief           header file for PIC18 software timers library
+ * @brief           This library provides any number of one-shot and periodic
+ *                  software timers on top of the System Time library, with
+ *                  their callbacks called from the main loop instead of
+ *                  "Tick_ms() - start >= timeout" polling in every module.
+ *
+ * @note            The timers are kept in a hashed timing wheel of SOFTTIMER_WHEEL_SIZE
+ *                  slots, one slot per tick: a timer expiring in n ticks is linked in the
+ *                  slot (now + n) % SOFTTIMER_WHEEL_SIZE with n / SOFTTIMER_WHEEL_SIZE
+ *                  remaining turns of the wheel.
+ *                      - SoftTimerStart() and SoftTimerStop() are O(1) (doubly linked slots).
+ *                      - Every tick only visits the timers of one slot: about
+ *                        timers / SOFTTIMER_WHEEL_SIZE nodes instead of every timer.
+ *                      - Nothing is added to the Timer0 interrupt: SoftTimerTask() catches up
+ *                        with the ticks elapsed on Tick_ms() (See SysTimeCallBack()) and
+ *                        calls the expired timers callbacks in the main context.
+ *
+ * @note            The timers memory (SoftTimerType) is provided by the application.
+ *                  The library functions must not be called from interrupt service routines.
+ *
+ * @brief           Written for the PIC 18F452 with XC8, not compiled by it yet: the host build
+ *                  runs the wheel with 256 periodic timers for one simulated second (See
+ *                  "make bench", softtimer_task_256_timers_1s).
+ * @brief           See dependencies in the include section.
+ *
+ *
+ * @note            History:
+ *                  - Oct 16, 2026: Initial release
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+#ifndef SOFTTIMER_H
+#define	SOFTTIMER_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------
+#include <xc.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "SystemTime.h"
+//-----------------------------------
+
+/** @defgroup SOFTTIMER_CONFIG Software timers settings
+ * @{
+ * @brief They can be overridden from the project settings (XC8 Global Options -> Define macros).
+ */
+#ifndef SOFTTIMER_TICK_MS
+#define SOFTTIMER_TICK_MS                           1                   //!< Timers resolution in milliseconds
+#endif
+#ifndef SOFTTIMER_WHEEL_SIZE
+#define SOFTTIMER_WHEEL_SIZE                        32                  //!< Wheel slots, a power of 2 from 2 to 128, 2 bytes of RAM each
+#endif
+/**
+  * @}
+  */
+
+//-----------------------------------
+/**
+ * @brief   Software timer callback type
+ * @param   arg: the argument given to SoftTimerStart()
+ *
+ */
+typedef void (*SoftTimerHandlerType)(void *arg);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Software timer type, to be allocated by the application (static or global).
+ *          Its members are private to the library.
+ *
+ */
+typedef struct SoftTimerStruct
+{
+    struct SoftTimerStruct *Next;                               //!< Next timer in the wheel slot
+    struct SoftTimerStruct *Prev;                               //!< Previous timer in the wheel slot, NULL for the first one
+    SoftTimerHandlerType Handler;                               //!< Callback, NULL when the timer is stopped
+    void *Arg;                                                  //!< Callback argument
+    uint16_t Period;                                            //!< Reload value in ticks, 0 for one-shot timers
+    uint16_t Rounds;                                            //!< Remaining turns of the wheel before expiry
+    uint8_t Slot;                                               //!< Wheel slot the timer is linked in
+}SoftTimerType;
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Initialize the software timers library
+ * @param       none
+ * @retval      none
+ * @note        The System Time library must be initialized (See SystimeInit()).
+ *              Any running timer is forgotten.
+ *
+ */
+extern void SoftTimerInit(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Start, or restart, a software timer
+ * @param       timer: the timer
+ * @param       timeout: delay before the first expiry in ticks of SOFTTIMER_TICK_MS, 0 is handled as 1
+ * @param       period: delay between two next expiries in ticks, 0 for a one-shot timer
+ * @param       handler: function called by SoftTimerTask() on expiry
+ * @param       arg: argument given to the handler
+ * @retval      none
+ * @note        The timeout counts from the last tick processed by SoftTimerTask().
+ * @note        It can be called from a timer handler, including for the expired timer itself.
+ *
+ */
+extern void SoftTimerStart(SoftTimerType *timer, uint16_t timeout, uint16_t period, SoftTimerHandlerType handler, void *arg);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Stop a software timer, nothing is done if it is not running
+ * @param       timer: the timer
+ * @retval      none
+ * @note        It can be called from a timer handler, including for any other timer of the same slot.
+ *
+ */
+extern void SoftTimerStop(SoftTimerType *timer);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Tell whether a software timer is running
+ * @param       timer: the timer
+ * @retval      1 if running (one-shot timer not expired yet or periodic timer), 0 otherwise
+ *
+ */
+#define SoftTimerIsRunning(timer)                   ((timer)->Handler != NULL)
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Process the ticks elapsed since the last call and call the handlers of the expired timers
+ * @param       none
+ * @retval      none
+ * @note        To be called from the main loop, as often as the timers resolution requires.
+ *              A late call catches up every tick in order: no expiry is lost.
+ *
+ */
+extern void SoftTimerTask(void);
+//-----------------------------------
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SOFTTIMER_H */
+
@@ -6,75 +6,85 @@
  * @brief           This file provides macros, functions and types definitions 
  *                  for the PIC18 UART bit banging library. 
  * 
- * @note            The current version of this driver has the following characteristics:
- * @note            Supported Oscillator frequencies (in HZ)                  
- *                      - 4000000
- *                      - 8000000
- *                      - 12000000 
- *                      - 16000000
- *                      - 20000000
- *                      - 25000000
- *                      - 40000000                      
- * 
- * @note            Supported baud rates for transmission are:
- *                      - 9600
- *                      - 19200
- *                      - 38400
- *                      - 57600
- *                      - 115200
- *                      - 128000
- * @note            Supported baud rates for reception are:
- *                      - 9600
- *                      - 19200
- *                      - 38400
- *                      - 57600
+ * @note            The driver is compiled from source (SoftwareUART.c), its settings are
+ *                  build time parameters (See @ref SUART_CONFIG):
+ *                      - Oscillator frequency: FOSC_MHZ global macro
+ *                      - Baud rate: @ref SUART_BAUD
+ *                      - Transmission pin: any I/O pin, @ref SUART_TX_PORT and @ref SUART_TX_PIN
+ *                      - Reception pin: RB0, RB1 or RB2 (INT0, INT1 or INT2), @ref SUART_RX_INT
+ *                        (SUART_MODE_TICK: any I/O pin, @ref SUART_CH0_RX_PORT and @ref SUART_CH0_RX_PIN)
+ * 
+ * @note            Bit timing engines (See @ref SUART_MODE):
+ *                      - SUART_MODE_DELAY: the bit delays are generated by the compiler (_delay())
+ *                        from the number of instruction cycles per bit, minus the cycles of the bit
+ *                        loops. Global interrupts are disabled during each frame.
+ *                      - SUART_MODE_COMPARE: each bit is clocked by a compare interrupt on the
+ *                        free running Timer1 (CCP1 for transmission, CCP2 for reception). Interrupts
+ *                        stay enabled, a frame costs one short interrupt per bit, and transmission
+ *                        is queued in a buffer of @ref SUART_TX_BUFFER_SIZE bytes.
+ *                      - SUART_MODE_TICK: full duplex. A Timer2 periodic interrupt runs at
+ *                        @ref SUART_OVERSAMPLE times the baud rate, drives the transmitted bits and
+ *                        samples the reception pin, so both directions run at the same time with
+ *                        their own buffers. The tick runs continuously, even when the line is idle.
+ * 
+ * @note            The build fails when the settings cannot be met within @ref SUART_BAUD_ERROR_MAX.
+ *                  "make suart-check" prints and verifies the timing of every supported
+ *                  combination (See Host/SuartTiming.c).
+ * 
+ * @note            Supported combinations (transmission and reception, 2% error max):
+ @verbatim
+            FOSC (MHz)      SUART_MODE_DELAY        SUART_MODE_COMPARE      SUART_MODE_TICK (3 ticks per bit)
+            4               1200 to 9600            1200 to 4800            1200 to 2400
+            8               1200 to 19200           1200 to 9600            1200 to 4800
+            10              1200 to 38400           1200 to 9600            1200 to 4800
+            12              1200 to 38400           1200 to 19200           1200 to 4800
+            16, 20          1200 to 57600           1200 to 19200           1200 to 9600
+            25              1200 to 57600           1200 to 38400           1200 to 9600
+            32              1200 to 115200          1200 to 38400           1200 to 19200
+            40              1200 to 115200          1200 to 57600           1200 to 19200
+ @endverbatim
  * 
  * @note            Communication settings:
  *                      - 8 bits data transmission/reception
  *                      - 1 start, 1 stop bit
  *                      - No parity
  * 
- * @note            At least 100 bytes of RAM used for operation.
- * 
  * @note            Global, peripheral and external interrupts (INTx) are all
- *                  enable to for data reception.
+ *                  enabled by SoftUARTInit() for data reception.
  * 
  * @note            To use the reception functionality, make sure to include the 
- *                  @ref suart_isr() function in the interrupts file (ISR.c).
+ *                  SoftUARTCallBack() function in the interrupts file (ISR.c), or
+ *                  to use the interrupt dispatcher (See USE_INTERRUPT_DISPATCHER).
  * 
- * @attention       Global interrupts are disabled during transmission/reception
+ * @note            Channels (SUART_MODE_TICK): up to 4 software UARTs (@ref SUART_CHANNELS) on any I/O
+ *                  pins share the Timer2 tick interrupt. The ports are read and the transmission
+ *                  latches written once per tick for all the channels, a channel adds about
+ *                  @ref SUART_TICK_CH_CYCLES cycles to the tick interrupt. The supported baud
+ *                  rates of the table below are for one channel. The SoftUARTCh...() functions
+ *                  take the channel number (0 to SUART_CHANNELS - 1); the other functions work
+ *                  on channel 0.
  * 
- * @attention       Maximum receive buffer size is 100 bytes, so avoid receiving more 
- *                  than 100 bytes before reading data out to prevent loss.
+ * @note            With SUART_MODE_TICK, Timer2 is used by the driver and the sampling point
+ *                  moves by up to one tick (1/SUART_OVERSAMPLE bit) around the middle of the bits.
+ * 
+ * @attention       With SUART_MODE_DELAY, global interrupts are disabled during transmission/reception
+ * 
+ * @attention       Received bytes are stored in a ring buffer of @ref SUART_RX_BUFFER_SIZE
+ *                  bytes, read data out in time to prevent loss.
  * 
  * @brief           Supported devices are listed below.
  * @brief           See dependencies in the include section.
  * 
-@verbatim
- Library file description:
- 
-                             --1--  --2-- --3-- --4--  -5-  -6-
-                file layout: SUART - v10 - 16 - 9600 - B0 - B1.a
-                             
-                    1. SUART: Software UART library
-                    2. v10: Software version 1.0
-                    3. 16: Oscillator frequency  = 16MHZ
-                    4. 9600: Baud Rate = 9600
-                    5. B0: Reception is configured on PORTB[0] (INT0)
-                    6. B3: Transmission is configured on PORTB[3] 
-  
-@endverbatim
- * 
  * @note            History:
  *                  - Feb 11, 2023: Initial release
+ *                  - Oct 16, 2026: Source implementation, build time FOSC, baud rate and pins
+ *                  - Oct 17, 2026: Reception hook (See SoftUARTSetRxHook())
  * 
- * @note            It has been successfully tested with:
- *                  - IDEs: 
- *                      * MPLAB X IDE v5.30
- *                  - Compilers: 
- *                      * XC8 V2.36, V1.45
- *                  - Devices: 
- *                      * PIC 18F452
+ * @note            The Feb 11, 2023 library build was tested with MPLAB X IDE v5.30, XC8 V2.36 and
+ *                  V1.45 on a PIC 18F452. This source implementation was not compiled by XC8 yet:
+ *                  the host build runs it against the simulated pins (See "make bench"), and the
+ *                  bit timing is checked by "make suart-check", which fails until the production
+ *                  image is rebuilt from it (See @ref SUART_TIMING).
  ******************************************************************************
  * @attention
  *
@@ -91,9 +101,148 @@ extern "C" {
 #endif
 
 //-----------------------------------
-#include "../../../M8M_APIs/PIC18.X/Inc/GPIO.h"
+#include "GPIO.h"
 //-----------------------------------        
 
+/** @defgroup SUART_CONFIG Software UART settings
+ * @{
+ * @brief They can be overridden from the project settings (XC8 Global Options -> Define macros).
+ */
+#define SUART_MODE_DELAY                            0                   //!< Cycle counted bit loops, interrupts disabled during frames
+#define SUART_MODE_COMPARE                          1                   //!< Bits clocked by Timer1 compare interrupts (CCP1, CCP2), interrupts enabled
+#define SUART_MODE_TICK                             2                   //!< Full duplex, bits sampled and driven from a Timer2 periodic interrupt
+#ifndef SUART_MODE
+#define SUART_MODE                                  SUART_MODE_DELAY    //!< Bit timing engine
+#endif
+#ifndef SUART_BAUD
+#define SUART_BAUD                                  9600                //!< Baud rate in bits/s
+#endif
+#ifndef SUART_TX_PORT
+#define SUART_TX_PORT                               GPIOB               //!< Transmission I/O port (See IO_PORT_CONSTANTS in PIC18Types.h)
+#endif
+#ifndef SUART_TX_PIN
+#define SUART_TX_PIN                                3                   //!< Transmission pin number on SUART_TX_PORT, from 0 to 7
+#endif
+#ifndef SUART_RX_INT
+#define SUART_RX_INT                                0                   //!< Reception external interrupt: 0 (RB0/INT0), 1 (RB1/INT1) or 2 (RB2/INT2)
+#endif
+#ifndef SUART_RX_BUFFER_SIZE
+#define SUART_RX_BUFFER_SIZE                        64                  //!< Receive ring buffer size in bytes. Must be a power of two, from 2 to 128
+#endif
+#define SUART_RX_BUFFER_MASK                        (SUART_RX_BUFFER_SIZE - 1)
+#ifndef SUART_TX_BUFFER_SIZE
+#define SUART_TX_BUFFER_SIZE                        16                  //!< Transmit queue size in bytes (SUART_MODE_COMPARE, SUART_MODE_TICK). Must be a power of two, from 2 to 128
+#endif
+#define SUART_TX_BUFFER_MASK                        (SUART_TX_BUFFER_SIZE - 1)
+#ifndef SUART_CHANNELS
+#define SUART_CHANNELS                              1                   //!< Number of channels, from 1 to 4. Several channels require SUART_MODE_TICK
+#endif
+#ifndef SUART_CH0_TX_PORT
+#define SUART_CH0_TX_PORT                           SUART_TX_PORT       //!< Channel 0 pins (SUART_MODE_TICK): any I/O pin
+#endif
+#ifndef SUART_CH0_TX_PIN
+#define SUART_CH0_TX_PIN                            SUART_TX_PIN
+#endif
+#ifndef SUART_CH0_RX_PORT
+#define SUART_CH0_RX_PORT                           GPIOB
+#endif
+#ifndef SUART_CH0_RX_PIN
+#define SUART_CH0_RX_PIN                            SUART_RX_INT        //!< RBx pin of INTx
+#endif
+#ifndef SUART_CH1_TX_PORT
+#define SUART_CH1_TX_PORT                           GPIOD               //!< Channel 1 pins (SUART_CHANNELS > 1)
+#define SUART_CH1_TX_PIN                            0
+#define SUART_CH1_RX_PORT                           GPIOD
+#define SUART_CH1_RX_PIN                            1
+#endif
+#ifndef SUART_CH2_TX_PORT
+#define SUART_CH2_TX_PORT                           GPIOD               //!< Channel 2 pins (SUART_CHANNELS > 2)
+#define SUART_CH2_TX_PIN                            2
+#define SUART_CH2_RX_PORT                           GPIOD
+#define SUART_CH2_RX_PIN                            3
+#endif
+#ifndef SUART_CH3_TX_PORT
+#define SUART_CH3_TX_PORT                           GPIOD               //!< Channel 3 pins (SUART_CHANNELS > 3)
+#define SUART_CH3_TX_PIN                            4
+#define SUART_CH3_RX_PORT                           GPIOD
+#define SUART_CH3_RX_PIN                            5
+#endif
+#ifndef SUART_OVERSAMPLE
+#define SUART_OVERSAMPLE                            3                   //!< Ticks per bit (SUART_MODE_TICK): 3 or 4
+#endif
+#ifndef SUART_BAUD_ERROR_MAX
+#define SUART_BAUD_ERROR_MAX                        20                  //!< Highest bit duration error accepted at build time, in per mille
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup SUART_TIMING Software UART bit timing
+ * @{
+ * @brief Instruction cycles of the bit loops, outside of the generated delays. They depend on the
+ * code generated for SoftwareUART.c: "make suart-check" runs the production image on the instruction
+ * set simulator, measures the SUART_MODE_DELAY ones (TX/RX loops, TX start, RX latency and tail) and
+ * fails when they are more than 1 cycle outside of the measured range. Update them from its output
+ * after changing the bit loops or the compiler settings.
+ * @note The values below are estimates of the XC8 -O1 output, not measurements: the committed
+ * image predates SoftwareUART.c, "make suart-check" fails with NOT VERIFIED until the image is
+ * rebuilt and these constants are set from its output. The SUART_MODE_COMPARE and SUART_MODE_TICK
+ * interrupt cycles are not measured, check the SoftUARTCallBack() incl.max column of "make sim".
+ */
+#define SUART_TX_LOOP_CYCLES                        10                  //!< Transmission: cycles per bit outside of the delay
+#define SUART_TX_START_CYCLES                       8                   //!< Transmission: cycles from the start bit edge to the bit loop, outside of the delay
+#define SUART_RX_LOOP_CYCLES                        10                  //!< Reception: cycles per bit outside of the delay
+#define SUART_RX_LATENCY_CYCLES                     60                  //!< Reception: cycles from the start bit edge to the first delay (interrupt latency, context saving, dispatching)
+#define SUART_RX_TAIL_CYCLES                        40                  //!< Reception: cycles from the stop bit sample to the end of the interrupt
+#define SUART_CMP_ISR_CYCLES                        70                  //!< Compare mode: cycles of one bit interrupt, entry to exit, dispatching included
+#define SUART_TICK_ISR_CYCLES                       80                  //!< Tick mode: cycles of one tick interrupt (transmission and reception bits), dispatching included
+#define SUART_TICK_CH_CYCLES                        45                  //!< Tick mode: cycles added to the tick interrupt by each channel after the first one
+#define SUART_TICK_LOAD_CYCLES                      (SUART_TICK_ISR_CYCLES + (SUART_CHANNELS - 1) * SUART_TICK_CH_CYCLES)
+
+#define SUART_BIT_CYCLES_OF(fosc_mhz, baud)         (((uint32_t)(fosc_mhz) * 250000UL + (baud) / 2) / (baud))                 //!< Instruction cycles per bit, rounded
+#define SUART_CYCLES_ERROR_OF(fosc_mhz, baud, cyc)  ((((uint32_t)(cyc) * 4UL * (baud) > (uint32_t)(fosc_mhz) * 1000000UL) \
+                                                        ? ((uint32_t)(cyc) * 4UL * (baud) - (uint32_t)(fosc_mhz) * 1000000UL) \
+                                                        : ((uint32_t)(fosc_mhz) * 1000000UL - (uint32_t)(cyc) * 4UL * (baud))) \
+                                                        / ((uint32_t)(fosc_mhz) * 1000UL))                                    //!< Error of a bit lasting cyc instruction cycles, in per mille
+#define SUART_BIT_ERROR_OF(fosc_mhz, baud)          SUART_CYCLES_ERROR_OF(fosc_mhz, baud, SUART_BIT_CYCLES_OF(fosc_mhz, baud))   //!< Bit duration error, in per mille
+#define SUART_TX_BIT_DELAY_OF(fosc_mhz, baud)       ((long)SUART_BIT_CYCLES_OF(fosc_mhz, baud) - SUART_TX_LOOP_CYCLES)
+#define SUART_TX_START_DELAY_OF(fosc_mhz, baud)     ((long)SUART_BIT_CYCLES_OF(fosc_mhz, baud) - SUART_TX_START_CYCLES)
+#define SUART_RX_TAIL_LATE_OF(fosc_mhz, baud)       ((SUART_RX_TAIL_CYCLES > (long)SUART_BIT_CYCLES_OF(fosc_mhz, baud) / 2) \
+                                                        ? (SUART_RX_TAIL_CYCLES - (long)SUART_BIT_CYCLES_OF(fosc_mhz, baud) / 2) : 0L)   //!< Late detection of back to back start bits
+#define SUART_RX_START_DELAY_OF(fosc_mhz, baud)     ((long)SUART_BIT_CYCLES_OF(fosc_mhz, baud) * 3 / 2 - SUART_RX_LATENCY_CYCLES \
+                                                        - SUART_RX_LOOP_CYCLES - SUART_RX_TAIL_LATE_OF(fosc_mhz, baud))            //!< Delay to the middle of the first data bit
+#define SUART_RX_BIT_DELAY_OF(fosc_mhz, baud)       ((long)SUART_BIT_CYCLES_OF(fosc_mhz, baud) - SUART_RX_LOOP_CYCLES)
+#define SUART_VALID_OF(fosc_mhz, baud)              ((SUART_BIT_ERROR_OF(fosc_mhz, baud) <= SUART_BAUD_ERROR_MAX) \
+                                                        && (SUART_TX_BIT_DELAY_OF(fosc_mhz, baud) >= 1) \
+                                                        && (SUART_TX_START_DELAY_OF(fosc_mhz, baud) >= 1) \
+                                                        && (SUART_RX_BIT_DELAY_OF(fosc_mhz, baud) >= 1) \
+                                                        && (SUART_RX_START_DELAY_OF(fosc_mhz, baud) >= 1))                    //!< 1 if the combination can be generated (SUART_MODE_DELAY)
+#define SUART_CMP_VALID_OF(fosc_mhz, baud)          ((SUART_BIT_ERROR_OF(fosc_mhz, baud) <= SUART_BAUD_ERROR_MAX) \
+                                                        && (SUART_BIT_CYCLES_OF(fosc_mhz, baud) <= 65535UL) \
+                                                        && (SUART_BIT_CYCLES_OF(fosc_mhz, baud) >= 2UL * SUART_CMP_ISR_CYCLES))   //!< 1 if the combination can be generated (SUART_MODE_COMPARE): TX and RX interrupts fit in a bit
+#define SUART_TICK_IDEAL_OF(fosc_mhz, baud)         (((uint32_t)(fosc_mhz) * 250000UL + (baud) * SUART_OVERSAMPLE / 2) / ((uint32_t)(baud) * SUART_OVERSAMPLE))   //!< Instruction cycles per tick, rounded
+#define SUART_TICK_PRESCALE_OF(fosc_mhz, baud)      ((SUART_TICK_IDEAL_OF(fosc_mhz, baud) <= 256UL) ? 1UL : (SUART_TICK_IDEAL_OF(fosc_mhz, baud) <= 1024UL) ? 4UL : 16UL)   //!< Timer2 prescaler
+#define SUART_TICK_PR2_OF(fosc_mhz, baud)           ((SUART_TICK_IDEAL_OF(fosc_mhz, baud) + SUART_TICK_PRESCALE_OF(fosc_mhz, baud) / 2) \
+                                                        / SUART_TICK_PRESCALE_OF(fosc_mhz, baud) - 1UL)                       //!< Timer2 period register
+#define SUART_TICK_CYCLES_OF(fosc_mhz, baud)        (SUART_TICK_PRESCALE_OF(fosc_mhz, baud) * (SUART_TICK_PR2_OF(fosc_mhz, baud) + 1UL))   //!< Generated instruction cycles per tick
+#define SUART_TICK_VALID_OF(fosc_mhz, baud)         ((SUART_CYCLES_ERROR_OF(fosc_mhz, baud, SUART_TICK_CYCLES_OF(fosc_mhz, baud) * SUART_OVERSAMPLE) <= SUART_BAUD_ERROR_MAX) \
+                                                        && (SUART_TICK_PR2_OF(fosc_mhz, baud) <= 255UL) \
+                                                        && (SUART_TICK_CYCLES_OF(fosc_mhz, baud) * 2UL >= 3UL * SUART_TICK_LOAD_CYCLES))   //!< 1 if the combination can be generated (SUART_MODE_TICK): the tick interrupt takes 2/3 of the CPU at most
+
+#define SUART_BIT_CYCLES                            SUART_BIT_CYCLES_OF(FOSC_MHZ, SUART_BAUD)
+#define SUART_TX_BIT_DELAY                          SUART_TX_BIT_DELAY_OF(FOSC_MHZ, SUART_BAUD)
+#define SUART_TX_START_DELAY                        SUART_TX_START_DELAY_OF(FOSC_MHZ, SUART_BAUD)
+#define SUART_RX_START_DELAY                        SUART_RX_START_DELAY_OF(FOSC_MHZ, SUART_BAUD)
+#define SUART_RX_BIT_DELAY                          SUART_RX_BIT_DELAY_OF(FOSC_MHZ, SUART_BAUD)
+#define SUART_CMP_RX_START                          ((uint16_t)(SUART_BIT_CYCLES * 3 / 2 - SUART_RX_LATENCY_CYCLES))   //!< Compare mode: Timer1 cycles from the start bit interrupt to the first sample
+#define SUART_TICK_PRESCALE                         SUART_TICK_PRESCALE_OF(FOSC_MHZ, SUART_BAUD)
+#define SUART_TICK_PR2                              ((uint8_t)SUART_TICK_PR2_OF(FOSC_MHZ, SUART_BAUD))
+#define SUART_TICK_T2CON                            ((SUART_TICK_PRESCALE == 1UL) ? 0x04 : (SUART_TICK_PRESCALE == 4UL) ? 0x05 : 0x06)   //!< Timer2 on, postscaler 1:1, prescaler
+#define SUART_TICK_RX_FIRST                         ((3 * SUART_OVERSAMPLE - 1) / 2)   //!< Tick mode: ticks from the start bit detection to the first sample
+/**
+  * @}
+  */
+
 /**
  * @brief   Software UART status type
  * 
@@ -107,6 +256,13 @@ typedef union{
     };
 }SoftUARTStatusType;
 
+/**
+ * @brief   Reception hook type, See SoftUARTSetRxHook()
+ * @param   ch: channel of the byte received
+ * 
+ */    
+typedef void (*SoftUARTRxHookType)(uint8_t ch);
+
 //-----------------------------------    
 /**
  * @brief	Initialize the software UART driver
@@ -182,6 +338,16 @@ extern uint16_t SoftUARTReceiveBytes(uint8_t *data, uint16_t cnt, uint32_t tout)
 extern void SoftUARTPrint(const char *str);
 //-----------------------------------
 
+//-----------------------------------    
+/**
+ * @brief   Get and clear the software UART reception status
+ * @param   none 
+ * @retval  status flags raised since the last call (buffer overflow, frame error)
+ * 
+ */    
+extern SoftUARTStatusType SoftUARTGetStatus(void);
+//-----------------------------------
+
 //-----------------------------------    
 /**
  * @brief   Suspend software UART driver operations
@@ -212,8 +378,52 @@ extern void SoftUARTResume(void);
 extern void SoftUARTFlushRx(void);
 //-----------------------------------
 
-#pragma intrinsic(_SoftUARTCallBack)                                            //!< Inline directive
+//-----------------------------------    
+/**
+ * @brief   Set the function called when a byte is stored in a receive buffer
+ * @param   hook: the function, NULL for none
+ * @retval  none
+ * @note    It runs in the interrupt context, to wake the task reading the bytes up for
+ *          instance (See SchedulerWake()). Keep it short: with SUART_MODE_COMPARE and
+ *          SUART_MODE_TICK, it runs inside the bit interrupt. With SUART_MODE_DELAY, it runs
+ *          after the stop bit sample and delays the detection of a back to back start bit:
+ *          add its cycles to SUART_RX_TAIL_CYCLES.
+ * 
+ */    
+extern void SoftUARTSetRxHook(SoftUARTRxHookType hook);
+//-----------------------------------
+
+//-----------------------------------    
+/**
+ * @brief   Channel functions: same as the functions above, for channel ch (0 to SUART_CHANNELS - 1)
+ * 
+ */    
+extern uint8_t SoftUARTChRxAvailable(uint8_t ch);
+extern void SoftUARTChTransmitByte(uint8_t ch, uint8_t data);
+extern int SoftUARTChReceiveByte(uint8_t ch);
+extern void SoftUARTChTransmitBytes(uint8_t ch, uint8_t *data, uint16_t cnt);
+extern uint16_t SoftUARTChReceiveBytes(uint8_t ch, uint8_t *data, uint16_t cnt, uint32_t tout);
+extern void SoftUARTChPrint(uint8_t ch, const char *str);
+extern SoftUARTStatusType SoftUARTChGetStatus(uint8_t ch);
+extern void SoftUARTChSuspend(uint8_t ch);
+extern void SoftUARTChResume(uint8_t ch);
+extern void SoftUARTChFlushRx(uint8_t ch);
+//-----------------------------------
+
+//-----------------------------------    
+/**
+ * @brief   Call-back function for the software UART reception, to be placed inside the interrupt service routines.
+ *          See ISR.c file.
+ * @param   none
+ * @retval  none
+ * @note    SUART_MODE_DELAY: a whole frame is received inside the call-back, from the start bit edge to the stop bit.
+ *          SUART_MODE_COMPARE: one bit per interrupt (CCP1, CCP2, INTx).
+ *          SUART_MODE_TICK: one Timer2 interrupt per tick, for all the channels.
+ * @note    With USE_INTERRUPT_DISPATCHER, SoftUARTInit() registers it in the dispatcher.
+ *
+ */
 extern void SoftUARTCallBack(void);
+//-----------------------------------
 
 
 #ifdef	__cplusplus
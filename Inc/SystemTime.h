@@ -12,8 +12,58 @@
  *                  the same timer must not be used when this library is in operation,  
  *                  to prevent unpredictable behaviors.
  * 
- * @note            Device oscillator frequency can be adjusted depending on the 
- *                  application, by modifying the @ref OSC_FREQ constant value.
+ * @note            The library is compiled from source (SystemTime.c), the device oscillator
+ *                  frequency is the FOSC_MHZ global macro (XC8 Global Options -> Define macros).
+ * 
+ * @note            Time generation modes (See @ref SYSTIME_MODE):
+ *                      - SYSTIME_MODE_OVERFLOW (default): Timer0 runs freely on 16 bits without
+ *                        prescaler and interrupts once every 65536 instruction cycles (16.4 ms at
+ *                        16 MHz). Tick_ms() and Tick_us() are composed from the time accumulated by
+ *                        the overflows plus a live read of TMR0H:TMR0L: Timer0 is never written, the
+ *                        time is exact as long as the interrupts are not disabled for a whole overflow
+ *                        period, and Tick_us() resolves one instruction cycle.
+ *                      - SYSTIME_MODE_1MS: Timer0 interrupts once per millisecond, Tick_ms() is the
+ *                        interrupt counter. On every overflow, the interrupt reads the counts made
+ *                        since the overflow (interrupt latency, interrupts disabled), catches up
+ *                        the milliseconds missed and writes back the count of the next millisecond,
+ *                        compensated by @ref SYSTIME_1MS_LOST. The time does not drift with the
+ *                        interrupts disabled (up to 65536 cycles), the only error is a wrong
+ *                        SYSTIME_1MS_LOST: 1 cycle per millisecond, 250 ppm at 16 MHz.
+ * 
+ * @note            Idle (See @ref SYSTIME_IDLE): Wait_ms() and the application idle loop call
+ *                  SysTimeIdle(), which waits for the next interrupt and measures the share of
+ *                  every SYSTIME_LOAD_WINDOW_MS window spent idle (SysTimeIdleLoad()). The CPU load
+ *                  is the time spent outside SysTimeIdle() and in the interrupts (SysTimeCpuLoad(),
+ *                  SysTimeCpuLoadPeak()): the interrupts serviced during an idle wait are left out
+ *                  of the idle time.
+ *                      - SYSTIME_IDLE_SLEEP: the CPU executes SLEEP with OSCCON.IDLEN set, the
+ *                        peripherals and Timer0 keep running and any interrupt wakes it up. Default
+ *                        on the devices with power managed modes, in SYSTIME_MODE_1MS.
+ *                      - SYSTIME_IDLE_T1OSC: the CPU executes SLEEP for about one millisecond
+ *                        (@ref SYSTIME_T1OSC_SLEEP_TICKS), the oscillator and Timer0 stop. Timer1
+ *                        counts the time asleep on its 32.768 kHz crystal (T1OSO/T1OSI pins,
+ *                        T1OSCEN) and its overflow wakes the CPU up, any other enabled interrupt
+ *                        too. Timer0 is stopped on a Timer1 increment before the SLEEP and started
+ *                        again on an increment after the wake up, and the Timer1 counts in between
+ *                        are added to the time: Tick_ms() and Tick_us() stay exact over the sleeps
+ *                        (the crystal tolerance), the timing of Wait_ms() and the software timers
+ *                        does not change. SYSTIME_MODE_OVERFLOW only.
+ *                      - SYSTIME_IDLE_SPIN: the CPU polls the time until the next millisecond.
+ *                        The idle time is the number of polls times their cost, timed by
+ *                        SystimeInit(): the interrupts serviced between two polls add no poll.
+ *                        Default otherwise: the PIC18F452 has no idle mode and its SLEEP stops
+ *                        the oscillator, hence Timer0. SYSTIME_IDLE_T1OSC needs the crystal.
+ * 
+ * @attention       SYSTIME_IDLE_T1OSC on the PIC18F452: in SLEEP, only Timer1 (asynchronous
+ *                  counter) and the external interrupts (INT0 to INT2, RB port change) run. The
+ *                  USART, Timer2, Timer3 on the internal clock and the CCP modules stop. A wake
+ *                  up takes the oscillator start-up timer (1024 oscillator periods, 64 us at
+ *                  16 MHz in HS mode) plus up to 2 Timer1 periods (61 us) with the interrupts
+ *                  disabled, to catch the Timer1 increments: the software UART reception is
+ *                  late by that much on a start bit and does not work in any mode
+ *                  (SUART_MODE_COMPARE uses Timer1, SUART_MODE_TICK Timer2). Timer1 is used by
+ *                  the library, the crystal takes up to 2 s to start after the power up:
+ *                  SysTimeIdle() waits for the first Timer1 increments meanwhile.
  *                
  * @brief           Supported devices are listed below.
  * @brief           See dependencies in the include section.
@@ -21,14 +71,17 @@
  * 
  * @note            History:
  *                  - Feb 3, 2023: Initial release
+ *                  - Oct 16, 2026: Source implementation, 16 bits overflow mode
+ *                  - Oct 16, 2026: Idle waits, idle hook and idle time measurement
+ *                  - Oct 16, 2026: CPU load meter
+ *                  - Oct 17, 2026: SYSTIME_MODE_OVERFLOW by default, SYSTIME_MODE_1MS reload compensated
+ *                  - Oct 17, 2026: SYSTIME_IDLE_T1OSC: PIC18F452 SLEEP timed by the Timer1 oscillator
+ *                  - Oct 17, 2026: Interrupts serviced during the idle waits counted as CPU load
  * 
- * @note            It has been successfully tested with:
- *                  - IDEs: 
- *                      * MPLAB X IDE v5.30
- *                  - Compilers: 
- *                      * XC8 V2.36
- *                  - Devices: 
- *                      * PIC 18F452
+ * @note            The Feb 3, 2023 library build was tested with MPLAB X IDE v5.30 and XC8 V2.36 on
+ *                  a PIC 18F452. This source implementation was not compiled by XC8 yet: the host
+ *                  build runs it against the simulated Timer0 and Timer1 (See "make bench",
+ *                  systime_*), SYSTIME_IDLE_SLEEP does not build there (no OSCCON.IDLEN).
  ******************************************************************************
  * @attention
  *
@@ -50,10 +103,68 @@ extern "C" {
 #include <stdint.h>
 //-----------------------------------  
     
-//-----------------------------------
-const uint8_t OSC_FREQ = 16;                                            //!< Change this value to the device oscillator frequency in megahertz. Maximum value is 40
-//-----------------------------------   
+/** @defgroup SYSTIME_CONFIG System Time settings
+ * @{
+ * @brief They can be overridden from the project settings (XC8 Global Options -> Define macros).
+ */
+#define SYSTIME_MODE_1MS                            0                   //!< Timer0 reloaded every millisecond, one interrupt per millisecond
+#define SYSTIME_MODE_OVERFLOW                       1                   //!< Timer0 free running on 16 bits, one interrupt per 65536 instruction cycles
+#ifndef SYSTIME_MODE
+#define SYSTIME_MODE                                SYSTIME_MODE_OVERFLOW   //!< Time generation mode
+#endif
+#ifndef SYSTIME_1MS_LOST
+#define SYSTIME_1MS_LOST                            19                  //!< SYSTIME_MODE_1MS: instruction cycles from the TMR0L read to the TMR0L write in SysTimeCallBack() (XC8 -O1), plus the 2 cycles of increment inhibit after the write. Check the drift with "make sim"
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup SYSTIME_IDLE_CONFIG System Time idle settings
+ * @{
+ * @brief They can be overridden from the project settings (XC8 Global Options -> Define macros).
+ */
+#define SYSTIME_IDLE_SPIN                           0                   //!< Idle waits poll the time
+#define SYSTIME_IDLE_SLEEP                          1                   //!< Idle waits execute SLEEP in idle mode (OSCCON.IDLEN), SYSTIME_MODE_1MS only
+#define SYSTIME_IDLE_T1OSC                          2                   //!< Idle waits execute SLEEP, timed by Timer1 on its 32.768 kHz oscillator, SYSTIME_MODE_OVERFLOW only
+#ifndef SYSTIME_IDLE
+#if defined(_OSCCON_IDLEN_POSN) && (SYSTIME_MODE == SYSTIME_MODE_1MS)
+#define SYSTIME_IDLE                                SYSTIME_IDLE_SLEEP  //!< Idle wait method
+#else
+#define SYSTIME_IDLE                                SYSTIME_IDLE_SPIN
+#endif
+#endif
+#ifndef SYSTIME_T1OSC_SLEEP_TICKS
+#define SYSTIME_T1OSC_SLEEP_TICKS                   33                  //!< SYSTIME_IDLE_T1OSC: Timer1 periods per sleep at most, 1.007 ms. From 2 to 65535
+#endif
+#ifndef SYSTIME_LOAD_WINDOW_MS
+#define SYSTIME_LOAD_WINDOW_MS                      1000                //!< Idle time and CPU load measurement window, from 10 to 60000 ms
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup SYSTIME_TIMING System Time Timer0 settings
+ * @{
+ */
+#define OSC_FREQ                                    FOSC_MHZ            //!< Device oscillator frequency in megahertz. Maximum value is 40
+#define SYSTIME_CYCLES_PER_MS                       ((uint16_t)(FOSC_MHZ * 250U))                    //!< Instruction cycles per millisecond
+#define SYSTIME_OVF_CYCLES                          65536UL                                           //!< SYSTIME_MODE_OVERFLOW: instruction cycles per overflow
+#define SYSTIME_OVF_MS                              ((uint16_t)(SYSTIME_OVF_CYCLES / SYSTIME_CYCLES_PER_MS))   //!< Whole milliseconds per overflow
+#define SYSTIME_OVF_REM                             ((uint16_t)(SYSTIME_OVF_CYCLES % SYSTIME_CYCLES_PER_MS))   //!< Instruction cycles per overflow, left over the whole milliseconds
+#define SYSTIME_T1OSC_HZ                            32768UL                                           //!< SYSTIME_IDLE_T1OSC: Timer1 crystal frequency
+#define SYSTIME_T1OSC_CYCLES_PER_16                 ((uint32_t)FOSC_MHZ * 15625UL)                    //!< SYSTIME_IDLE_T1OSC: instruction cycles per 2048 Timer1 periods (1/16 s)
+/**
+  * @}
+  */
     
+//-----------------------------------
+/**
+ * @brief   Idle hook type, See SysTimeSetIdleHook()
+ *
+ */
+typedef void (*SysTimeIdleHookType)(void);
+//-----------------------------------
+
 //-----------------------------------
 /**
  * @brief        Initialize the System Time library  
@@ -63,8 +174,11 @@ const uint8_t OSC_FREQ = 16;                                            //!< Cha
  * 
  * @note         The timer 0 is configured as follow:
  *                  - The timer increment on every internal clock cycle
- *                  - Timer prescaler is assigned to timer 0
+ *                  - No prescaler, 16 bits
  *                  - "Timer mode" of operation is selected
+ * @note         With SYSTIME_IDLE_T1OSC, Timer1 counts its crystal oscillator (asynchronous
+ *               counter, no prescaler, 16 bits) and the peripheral interrupts are enabled.
+ * @note         With USE_INTERRUPT_DISPATCHER, SysTimeCallBack() is registered in the dispatcher.
  * 
  */    
 extern void SystimeInit(void);
@@ -85,6 +199,7 @@ extern uint32_t Tick_ms(void);
  * @brief       Give the amount of time elapsed, in microseconds, since the last hardware reset  
  * @param       none
  * @retval      amount of time elapsed in microseconds.
+ * @note        The value wraps around every 71 minutes, compute time differences with unsigned subtractions.
  * 
  */    
 extern uint32_t Tick_us(void);
@@ -95,11 +210,72 @@ extern uint32_t Tick_us(void);
  * @brief       Blocks the program for a given time in milliseconds 
  * @param       none
  * @retval      none
+ * @note        The CPU idles between the interrupts (See SysTimeIdle()), the interrupts are still serviced.
  * 
  */    
 extern void Wait_ms(uint32_t value);
 //-----------------------------------
 
+//-----------------------------------
+/**
+ * @brief       Idle until the next interrupt (SYSTIME_IDLE_SLEEP), the next interrupt or SYSTIME_T1OSC_SLEEP_TICKS
+ *              (SYSTIME_IDLE_T1OSC), or the next millisecond (SYSTIME_IDLE_SPIN)
+ * @param       none
+ * @retval      none
+ * @note        To be called by the application main loop when it has nothing to do: the idle hook
+ *              is called first, then the time spent idle is added to the idle time measurement.
+ * 
+ */    
+extern void SysTimeIdle(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Set the function called by SysTimeIdle() before idling
+ * @param       hook: the function, NULL for none
+ * @retval      none
+ * @note        It runs in the main context, for background work such as clearing the watchdog.
+ * 
+ */    
+extern void SysTimeSetIdleHook(SysTimeIdleHookType hook);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Give the share of time spent idle in SysTimeIdle()
+ * @param       none
+ * @retval      idle time in per mille, over the last measurement window
+ * @note        The window is closed by the first SysTimeIdle() or load reading call after
+ *              SYSTIME_LOAD_WINDOW_MS: a busier window is a longer one. The interrupts serviced
+ *              while idle do not count as idle time: SYSTIME_IDLE_SLEEP services them once the
+ *              idle time is read, SYSTIME_IDLE_T1OSC subtracts their Timer1 periods (30.5 us
+ *              resolution, right on average), SYSTIME_IDLE_SPIN counts polls instead of time.
+ * 
+ */    
+extern uint16_t SysTimeIdleLoad(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Give the CPU load: the share of time spent outside SysTimeIdle()
+ * @param       none
+ * @retval      CPU load in per cent, over the last measurement window (See SysTimeIdleLoad())
+ * @note        A saturated main loop, which never calls SysTimeIdle(), reads 100.
+ * 
+ */    
+extern uint8_t SysTimeCpuLoad(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Give the highest CPU load of the measurement windows since the last reset of the peak
+ * @param       clear: 1 to restart the peak tracking from the next window, 0 to keep it
+ * @retval      CPU load peak in per cent
+ * 
+ */    
+extern uint8_t SysTimeCpuLoadPeak(uint8_t clear);
+//-----------------------------------
+
 //-----------------------------------
 /**
  * @brief       Call-back function for the System Time library, to be place inside the interrupt service routines.
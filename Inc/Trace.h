@@ -0,0 +1,240 @@
+/**
+ ******************************************************************************
+ * @file            Trace.h
+ * @author          Maxime
+ * @brief           header file for PIC18 binary trace library
+ * @brief           This library logs events over the USART in binary: a trace call writes
+ *                  the ID of its format string and its arguments in a RAM ring buffer, the
+ *                  USART transmit interrupt sends them in the background. The format strings
+ *                  are never sent nor formatted on the device, the host decoder prints them:
+ @verbatim
+                    TRACE2("rx=%u err=%u", rx, err);        6 bytes on the line, instead of 14 as text
+ @endverbatim
+ *
+ * @note            Event format, little endian:
+ @verbatim
+                    <ID low> <ID high> [argument bytes]
+ @endverbatim
+ *                  The ID is the program memory address of the format string: the host decoder
+ *                  reads the string from the .hex file of the build. The argument sizes follow
+ *                  the format string: 4 bytes for the 'l' conversions (%lu, %ld, %lx), 2 bytes
+ *                  for the other ones (%d, %u, %x, %X, %c). %s is not supported, the strings
+ *                  are not copied. ID 0 is a loss record, followed by the 16 bits number of
+ *                  events dropped because the buffer was full.
+ *
+ * @note            Decoding (See Host/TraceDecode.c):
+ @verbatim
+                    make trace TRACE_CAPTURE=capture.bin
+ @endverbatim
+ *
+ * @note            Usage:
+ @verbatim
+                    USARTAsyncInitBaud(9600);
+                    TraceInit();
+                    MCUInterruptEnable();
+                    ...
+                    TRACE("boot");
+                    TRACE2("rx=%u err=%u", rx, err);
+                    TRACE32("uptime=%lu ms", Tick_ms());
+ @endverbatim
+ *
+ * @note            The trace calls can be made from the interrupts and the main loop: an event
+ *                  is written with the interrupts disabled, as a whole or not at all.
+ *                  The library owns the USART transmitter: USARTTxIntEnable() and the text
+ *                  output functions must not be used along with it.
+ *
+ * @note            Without USE_TRACE, the TRACExx() macros compile to nothing.
+ *
+ * @brief           Written for the PIC 18F452 with XC8, not compiled by it yet: the host build
+ *                  sends 100 events on the simulated USART and decodes them back with the
+ *                  decoder of Host/TraceDecode.c, the format strings looked up by the benchmark
+ *                  instead of the .hex file (See "make bench", log_trace_100_events_9600).
+ * @brief           See dependencies in the include section.
+ *
+ *
+ * @note            History:
+ *                  - Oct 16, 2026: Initial release
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+#ifndef TRACE_H
+#define	TRACE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------
+#include <xc.h>
+#include <stdint.h>
+//-----------------------------------
+
+/** @defgroup TRACE_CONFIG Trace settings
+ * @{
+ * @brief They can be overridden from the project settings (XC8 Global Options -> Define macros).
+ */
+//#define USE_TRACE                                                       //!< Uncomment this line to compile the trace calls in, the USART transmit interrupt is then used by the library
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE                           64                  //!< Ring buffer size in bytes. Must be a power of two, from 8 to 128
+#endif
+/**
+  * @}
+  */
+
+#define TRACE_ID_LOST                               0x0000              //!< Loss record ID
+
+#if defined(USE_TRACE)
+
+//-----------------------------------
+/**
+ * @brief   Format string ID: its program memory address
+ * @param   fmt: format string literal
+ * @param   size: argument bytes written by the macro, checked against fmt in the host build
+ */
+#if defined(HOST_BUILD)
+#define TRACE_ID(fmt, size)                         TraceCheckFormat((fmt), (size))    //!< Host pointers are 64 bits, the ID only sizes the events
+#else
+#define TRACE_ID(fmt, size)                         ((uint16_t)(fmt))
+#endif
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Log an event with 0 to 3 arguments of 16 bits
+ * @param   fmt: format string literal, with one 16 bits conversion per argument: a %lu, %ld or %lx
+ *          conversion makes the decoder read 2 bytes more than written and lose the next events
+ *          (See TRACE32()). The host build counts these format strings (See TraceCheckFormat()).
+ */
+#define TRACE(fmt)                                  TraceWrite(TRACE_ID(fmt, 0), 0, 0, 0, 0)
+#define TRACE1(fmt, a)                              TraceWrite(TRACE_ID(fmt, 2), 1, (uint16_t)(a), 0, 0)
+#define TRACE2(fmt, a, b)                           TraceWrite(TRACE_ID(fmt, 4), 2, (uint16_t)(a), (uint16_t)(b), 0)
+#define TRACE3(fmt, a, b, c)                        TraceWrite(TRACE_ID(fmt, 6), 3, (uint16_t)(a), (uint16_t)(b), (uint16_t)(c))
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Log an event with 1 argument of 32 bits
+ * @param   fmt: format string literal, with a %lu, %ld or %lx conversion
+ */
+#define TRACE32(fmt, a)                             TraceWrite32(TRACE_ID(fmt, 4), (uint32_t)(a))
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Start the trace output on the USART
+ * @param       none
+ * @retval      none
+ * @note        The USART must be initialized in asynchronous 8 bits mode (See USARTAsyncInit()).
+ *              The peripheral interrupts are enabled, global interrupts must be enabled by the
+ *              application (See MCUInterruptEnable()).
+ *              With USE_INTERRUPT_DISPATCHER, TraceTxCallBack() replaces the USART transmit handler
+ *              in the dispatcher.
+ *
+ */
+extern void TraceInit(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Write an event in the ring buffer, see the TRACExx() macros
+ * @param       id: format string ID
+ * @param       argc: number of arguments, from 0 to 3
+ * @param       a, b, c: arguments
+ * @retval      none
+ * @note        The event is dropped and counted when the buffer is full.
+ *
+ */
+extern void TraceWrite(uint16_t id, uint8_t argc, uint16_t a, uint16_t b, uint16_t c);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Write an event with a 32 bits argument in the ring buffer, see TRACE32()
+ * @param       id: format string ID
+ * @param       a: argument
+ * @retval      none
+ *
+ */
+extern void TraceWrite32(uint16_t id, uint32_t a);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Wait until the ring buffer is sent
+ * @param       none
+ * @retval      none
+ * @note        Drains the buffer itself when the global interrupts are disabled.
+ *
+ */
+extern void TraceFlush(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Get the number of events dropped since TraceInit()
+ * @param       none
+ * @retval      events dropped, saturates at 65535
+ *
+ */
+extern uint16_t TraceGetDropped(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Call-back function of the USART transmit interrupt, to be placed inside the interrupt
+ *              service routines without the dispatcher. See ISR.c file.
+ * @param       none
+ * @retval      none
+ *
+ */
+extern void TraceTxCallBack(void);
+//-----------------------------------
+
+#if defined(HOST_BUILD)
+//-----------------------------------
+/**
+ * @brief       Check the argument bytes of a format string against the ones written by a TRACExx()
+ *              macro, host build only
+ * @param       fmt: format string
+ * @param       size: argument bytes written
+ * @retval      format string ID
+ * @note        The format strings with other argument sizes, or with a %s conversion, are counted
+ *              (See TraceGetFormatErrors()): their events would not be decoded.
+ *
+ */
+extern uint16_t TraceCheckFormat(const char *fmt, uint8_t size);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief       Get the number of TRACExx() calls made with a wrong format string, host build only
+ * @param       none
+ * @retval      calls, saturates at 65535
+ *
+ */
+extern uint16_t TraceGetFormatErrors(void);
+//-----------------------------------
+#endif
+
+#else
+
+#define TRACE(fmt)
+#define TRACE1(fmt, a)
+#define TRACE2(fmt, a, b)
+#define TRACE3(fmt, a, b, c)
+#define TRACE32(fmt, a)
+
+#endif
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* TRACE_H */
+
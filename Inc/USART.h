@@ -12,14 +12,13 @@
  * 
  * @note            History:
  *                  - Feb 3, 2023: Initial release
+ *                  - Oct 16, 2026: 9 bits multi-drop frames with hardware address filtering
+ *                  - Oct 16, 2026: USARTPutByte(), output function of the Format library
  * 
- * @note            It has been successfully tested with:
- *                  - IDEs: 
- *                      * MPLAB X IDE v5.30
- *                  - Compilers: 
- *                      * XC8 V2.36, V1.45
- *                  - Devices: 
- *                      * PIC 18F452
+ * @note            The Feb 3, 2023 release was tested with MPLAB X IDE v5.30, XC8 V2.36 and V1.45
+ *                  on a PIC 18F452. The interrupt driven reception ring buffer, transmit queue
+ *                  and multi-drop frames added since were not compiled by XC8 yet: they only run
+ *                  in the host build, against the simulated USART (See "make bench", usart_*).
  ******************************************************************************
  * @attention
  *
@@ -83,13 +82,95 @@ extern "C" {
     
 /**
   * @}
-  */ 
-               
+  */
+
 /**
   * @}
   */
 
-//-----------------------------------    
+/** @defgroup USART_RX_BUFFER_CONFIG USART interrupt driven reception settings
+ * @{
+ * @brief These settings apply once the interrupt driven reception is enabled with USARTRxIntEnable().
+ * They can be overridden from the project settings (XC8 Global Options -> Define macros).
+ */
+#ifndef USART_RX_BUFFER_SIZE
+#define USART_RX_BUFFER_SIZE                        32                  //!< Receive ring buffer size in bytes. Must be a power of two, from 2 to 128
+#endif
+#define USART_RX_BUFFER_MASK                        (USART_RX_BUFFER_SIZE - 1)
+/**
+  * @}
+  */
+
+/** @defgroup USART_TX_QUEUE_CONFIG USART interrupt driven transmission settings
+ * @{
+ * @brief These settings apply once the interrupt driven transmission is enabled with USARTTxIntEnable().
+ * They can be overridden from the project settings (XC8 Global Options -> Define macros).
+ */
+#ifndef USART_TX_BUFFER_SIZE
+#define USART_TX_BUFFER_SIZE                        64                  //!< Transmit queue size in bytes. Must be a power of two, from 2 to 128
+#endif
+#define USART_TX_BUFFER_MASK                        (USART_TX_BUFFER_SIZE - 1)
+
+#ifndef USART_TX_BLOCK_ON_FULL
+#define USART_TX_BLOCK_ON_FULL                      1                   //!< 1: wait for free space when the transmit queue is full. 0: drop the data and count it
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup USART_MULTIDROP_CONFIG USART 9 bits multi-drop settings
+ * @{
+ * @brief These settings apply once the multi-drop mode is started with USARTMultidropInit().
+ * They can be overridden from the project settings (XC8 Global Options -> Define macros).
+ */
+#ifndef USART_MD_FRAME_SIZE
+#define USART_MD_FRAME_SIZE                         16                  //!< Largest payload received, in bytes, from 1 to 255
+#endif
+#define USART_MD_BROADCAST                          0xFF                //!< Address received by every node
+//#define USART_MD_DE_PIN                             GPIO_PIN(GPIOC, 5)  //!< Uncomment this line to drive a RS-485 transceiver enable pin (See GPIO_PIN_DESCRIPTORS in GPIO.h) high while transmitting
+/**
+  * @}
+  */
+
+/** @defgroup USART_BAUD_RATE_CONFIG USART compile-time baud rate settings
+ * @{
+ * @brief These macros compute the Baud Rate Generator settings of an asynchronous baud rate from FOSC_MHZ
+ * at build time. They are used by USARTSetBaudRateConst() and USARTAsyncInitBaud(), and can also be used
+ * as arguments of USARTSetBGR() and USARTAsyncInit() (e.g. USARTAsyncInit(USART_BRG(9600))).
+ * @note The high speed mode (BRGH = 1) is selected whenever the BRG value fits in 8 bits, as it gives the
+ * smallest error. The BRG value is rounded to the nearest integer.
+ */
+#ifndef USART_BAUD_ERROR_MAX
+#define USART_BAUD_ERROR_MAX                        20                  //!< Highest baud rate error accepted at build time, in per mille of the requested baud rate
+#endif
+
+#define USART_FOSC_HZ                               ((uint32_t)FOSC_MHZ * 1000000UL)
+#define USART_BRG_DIV(div, baud)                    ((USART_FOSC_HZ + (uint32_t)(div) * (baud) / 2) / ((uint32_t)(div) * (baud)))   //!< Rounded (BRG + 1) value
+#define USART_BRGH(baud)                            ((USART_BRG_DIV(16, baud) <= 256UL) ? 1 : 0)                                    //!< BRGH bit for the baud rate
+#define USART_BRG_CLK_DIV(baud)                     (USART_BRGH(baud) ? 16UL : 64UL)                                            //!< FOSC to bit rate divider for the baud rate
+#define USART_BRG(baud)                             (USART_BRG_DIV(USART_BRG_CLK_DIV(baud), baud) - 1)                          //!< SPBRG value for the baud rate
+#define USART_BAUD_ACTUAL(baud)                     (USART_FOSC_HZ / (USART_BRG_CLK_DIV(baud) * (USART_BRG(baud) + 1)))        //!< Baud rate actually generated
+#define USART_BAUD_ERROR(baud)                      (((USART_BAUD_ACTUAL(baud) > (baud)) ? (USART_BAUD_ACTUAL(baud) - (baud)) \
+                                                        : ((baud) - USART_BAUD_ACTUAL(baud))) * 1000UL / (baud))              //!< Baud rate error in per mille
+#define USART_BAUD_VALID(baud)                      ((USART_BRG_DIV(USART_BRG_CLK_DIV(baud), baud) >= 1UL) \
+                                                        && (USART_BRG(baud) <= 255UL) \
+                                                        && (USART_BAUD_ERROR(baud) <= USART_BAUD_ERROR_MAX))                  //!< 1 if the baud rate can be generated within the error threshold
+/**
+  * @}
+  */
+
+/**
+ * @brief   USART reception error counters type
+ *
+ */
+typedef struct
+{
+    uint16_t SwOverrun;                             //!< Bytes dropped because the receive ring buffer was full
+    uint16_t HwOverrun;                             //!< Hardware receive FIFO overruns (OERR)
+    uint16_t FrameErr;                              //!< Framing errors (FERR)
+}USARTRxStatsType;
+
+//-----------------------------------
 /**
  * @brief   Enable USART module
  * @param   none   
@@ -150,7 +231,7 @@ extern "C" {
  * @retval  - 0: No data received
  *          - 1: Data received
  */    
-#define USARTRxAvailable()                          (PIR1,RCIF)
+#define USARTRxAvailable()                          (PIR1bits.RCIF)
 //-----------------------------------    
 
 //-----------------------------------    
@@ -160,8 +241,8 @@ extern "C" {
  * @retval  none
  * 
  */    
-#define USARTTransmitByte(data)                     while(TXSTAbits.TRMT == 0);\
-                                                        TXREG = data;
+#define USARTTransmitByte(data)                     do{ while(TXSTAbits.TRMT == 0){}\
+                                                        TXREG = (data); }while(0)
 //-----------------------------------
     
 //-----------------------------------    
@@ -202,6 +283,8 @@ extern void USARTSetBGR(uint8_t bgr);
  * @retval  none
  * @note    Prior to using this function, make sure to define the global macro FOSC_MHZ, with the MCU crystal frequency in megahertz, in the project settings.
  * @note    In MPLAB X, go to project properties -> XC8 Global Options -> XC8 Compiler -> Define macros.
+ * @note    The BRG value is computed with a 32 bits division at runtime, and the BRGH bit is not changed.
+ *          For constant baud rates, prefer USARTSetBaudRateConst().
  * @note    Usage:
  @verbatim void main(void)
             {
@@ -219,6 +302,30 @@ extern void USARTSetBGR(uint8_t bgr);
 extern void USARTSetBaudRate(uint32_t baud);
 //----------------------------------- 
 
+//-----------------------------------    
+/**
+ * @brief   Set USART Baud Rate, computed at build time (asynchronous mode)
+ * @param   baud: Baud Rate value in bits/s, must be a constant expression
+ * @retval  none
+ * @note    The compilation fails (negative array size) when the baud rate cannot be generated
+ *          from FOSC_MHZ within @ref USART_BAUD_ERROR_MAX. See @ref USART_BAUD_RATE_CONFIG.
+ * @note    Unlike USARTSetBaudRate(), this macro also selects the high/low speed mode,
+ *          and only emits the BRGH and SPBRG writes: there is no runtime arithmetic.
+ * @note    Usage:
+ @verbatim void main(void)
+            {
+            ...
+            USARTSetBaudRateConst(19200);
+            ...
+            }
+ @endverbatim
+ * 
+ */    
+#define USARTSetBaudRateConst(baud)                 do{ (void)sizeof(char[USART_BAUD_VALID(baud) ? 1 : -1]);\
+                                                        TXSTAbits.BRGH = USART_BRGH(baud);\
+                                                        SPBRG = (uint8_t)USART_BRG(baud); }while(0)
+//----------------------------------- 
+
 //-----------------------------------    
 /**
  * @brief   Initialize the USART module with the specified configurations.
@@ -261,7 +368,7 @@ extern void USARTInit(ConfigType cfg);
  @verbatim void main(void)
             {
             ...
-            USARTAsyncInit(19200);
+            USARTAsyncInit(USART_BRG(19200));                             // BRGH must be 1, see USART_BRGH()
             ...
             USARTRxEnable();
             USARTTxEnable();
@@ -277,6 +384,28 @@ extern void USARTInit(ConfigType cfg);
 extern void USARTAsyncInit(uint8_t bgr);
 //-----------------------------------
 
+//-----------------------------------    
+/**
+ * @brief   Same as USARTAsyncInit(), with the baud rate settings computed at build time
+ * @param   baud: Baud Rate value in bits/s, must be a constant expression
+ * @retval  none
+ * @note    The high/low speed mode is selected by @ref USART_BRGH. See USARTSetBaudRateConst().
+ * @note    Usage:
+ @verbatim void main(void)
+            {
+            ...
+            USARTAsyncInitBaud(9600);                                       // 57600 and above are not within USART_BAUD_ERROR_MAX at 16MHz
+            ...
+            }
+ @endverbatim
+ * 
+ */    
+#define USARTAsyncInitBaud(baud)                    do{ (void)sizeof(char[USART_BAUD_VALID(baud) ? 1 : -1]);\
+                                                        TXSTA = (uint8_t)(0x20 | (USART_BRGH(baud) << 2));\
+                                                        RCSTA = 0x90;\
+                                                        SPBRG = (uint8_t)USART_BRG(baud); }while(0)
+//-----------------------------------
+
 //-----------------------------------    
 /**
  * @brief   Transmit data in 9 bits mode over the USART module
@@ -309,6 +438,17 @@ extern void USARTTransmitBytes(uint8_t *data, uint16_t cnt);
 extern void USARTTransmitBytes9(uint16_t *data, uint16_t cnt);
 //-----------------------------------
 
+//-----------------------------------
+/**
+ * @brief   Transmit a byte, through the transmit queue when it is enabled
+ * @param   data: byte to be transmitted
+ * @retval  none
+ * @note    Function form of USARTTransmitByte(), it can be passed to FormatPrint().
+ *
+ */
+extern void USARTPutByte(uint8_t data);
+//-----------------------------------
+
 //-----------------------------------    
 /**
  * @brief   Sends a char array through the USART module
@@ -363,6 +503,317 @@ extern uint16_t USARTReceiveBytes(uint8_t *data, uint16_t cnt, uint32_t tout);
 extern uint16_t USARTReceiveBytes9(uint16_t *data, uint16_t cnt, uint32_t tout);
 //-----------------------------------
 
+//-----------------------------------
+/**
+ * @brief   Enable interrupt driven reception
+ * @param   none
+ * @retval  none
+ * @note    Received bytes are drained from RCREG into a ring buffer of @ref USART_RX_BUFFER_SIZE bytes
+ *          by USARTRxCallBack(), which must be placed in the interrupt service routine (See ISR.c).
+ *          With USE_INTERRUPT_DISPATCHER, it is registered in the dispatcher by this function.
+ * @note    It ends the multi-drop mode started by USARTMultidropInit().
+ * @note    The USART receive and peripheral interrupts are enabled by this function,
+ *          global interrupts must be enabled by the application (See MCUInterruptEnable()).
+ * @note    Once enabled, USARTReceiveBytes() reads from the ring buffer.
+ *          USARTReceiveByte() and USARTReceiveByte9() must not be used anymore.
+ * @note    Usage:
+ @verbatim void main(void)
+            {
+            ...
+            USARTAsyncInit(103);                                            // 9600 bauds at 16MHz
+            USARTRxIntEnable();
+            MCUInterruptEnable();
+            ...
+            while(1)
+            {
+                if(USARTRxBufferAvailable())
+                {
+                    uint8_t c = (uint8_t)USARTRxBufferRead();
+                    ...
+                }
+                ...
+            }
+            }
+ @endverbatim
+ *
+ */
+extern void USARTRxIntEnable(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Disable interrupt driven reception
+ * @param   none
+ * @retval  none
+ * @note    Data left in the ring buffer can still be read.
+ *
+ */
+extern void USARTRxIntDisable(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Get the number of bytes waiting in the receive ring buffer
+ * @param   none
+ * @retval  number of bytes available
+ *
+ */
+extern uint8_t USARTRxBufferAvailable(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Get a byte from the receive ring buffer
+ * @param   none
+ * @retval      - byte received
+ *              - -1: Buffer empty, no data available
+ *
+ */
+extern int USARTRxBufferRead(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Get the next byte from the receive ring buffer without removing it
+ * @param   none
+ * @retval      - next byte in the buffer
+ *              - -1: Buffer empty, no data available
+ *
+ */
+extern int USARTRxBufferPeek(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Discard all the data in the receive ring buffer
+ * @param   none
+ * @retval  none
+ *
+ */
+extern void USARTRxBufferFlush(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Get the reception error counters
+ * @param   stats: structure to copy the counters into
+ * @retval  none
+ *
+ */
+extern void USARTRxGetStats(USARTRxStatsType *stats);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Reset the reception error counters
+ * @param   none
+ * @retval  none
+ *
+ */
+extern void USARTRxClearStats(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Enable interrupt driven transmission
+ * @param   none
+ * @retval  none
+ * @note    Data is written into a transmit queue of @ref USART_TX_BUFFER_SIZE bytes and sent
+ *          by USARTTxCallBack(), which must be placed in the interrupt service routine (See ISR.c).
+ * @note    Once enabled, USARTTransmitBytes() and USARTPrint() return as soon as the data is queued.
+ *          The USARTTransmitByte() macro and the 9 bits functions write TXREG directly and must not
+ *          be mixed with queued data.
+ * @note    When the queue is full, the behavior is selected by @ref USART_TX_BLOCK_ON_FULL.
+ * @note    Global interrupts must be enabled by the application (See MCUInterruptEnable()).
+ *          If they are not, the queue is drained by the function waiting for free space.
+ * @note    Usage:
+ @verbatim void main(void)
+            {
+            ...
+            USARTAsyncInit(103);                                            // 9600 bauds at 16MHz
+            USARTTxIntEnable();
+            MCUInterruptEnable();
+            ...
+            while(1)
+            {
+                USARTPrint("Telemetry...\r");                               // Returns immediately
+                ...
+            }
+            }
+ @endverbatim
+ *
+ */
+extern void USARTTxIntEnable(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Disable interrupt driven transmission
+ * @param   none
+ * @retval  none
+ * @note    The transmit queue is drained before returning, see USARTTxFlush().
+ *
+ */
+extern void USARTTxIntDisable(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Write a byte into the transmit queue
+ * @param   data: byte to be transmitted
+ * @retval      - 1: Byte queued
+ *              - 0: Queue full, byte dropped (@ref USART_TX_BLOCK_ON_FULL set to 0 only)
+ *
+ */
+extern uint8_t USARTTxQueueByte(uint8_t data);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Write an array of bytes into the transmit queue
+ * @param   data: byte array to be transmitted
+ * @param   cnt: number of byte to transmit
+ * @retval  number of bytes queued
+ *
+ */
+extern uint16_t USARTTxQueueBytes(const uint8_t *data, uint16_t cnt);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Get the free space in the transmit queue
+ * @param   none
+ * @retval  number of bytes that can be queued without waiting
+ *
+ */
+extern uint8_t USARTTxFree(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Wait until all the queued data has been transmitted
+ * @param   none
+ * @retval  none
+ *
+ */
+extern void USARTTxFlush(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Get the number of bytes dropped because the transmit queue was full
+ * @param   none
+ * @retval  number of bytes dropped
+ *
+ */
+extern uint16_t USARTTxGetDropped(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Start the 9 bits multi-drop mode, asynchronous, with the hardware address detection
+ * @param   bgr: Baud Rate Generator value, high speed mode (See USART_BRG())
+ * @param   address: node address, from 0 to 254
+ * @retval  none
+ * @note    Frame format, sent by USARTMultidropSend():
+ @verbatim
+            <address, 9th bit set> <payload length> <payload bytes>
+ @endverbatim
+ * @note    While no frame is being received, the receiver runs with ADDEN set: bytes with the 9th
+ *          bit clear do not even raise RCIF, only the address bytes interrupt the node. When the
+ *          address is the node or @ref USART_MD_BROADCAST one, ADDEN is cleared for the payload and
+ *          set back at the end of the frame. The CPU load of a node then depends on its own traffic,
+ *          one interrupt per address byte of the others.
+ * @note    Frames are received by USARTRxCallBack() (See ISR.c), the receive interrupt is enabled
+ *          by this function (and registered with USE_INTERRUPT_DISPATCHER). The ring buffer of
+ *          USARTRxIntEnable() is not used in this mode.
+ * @note    One frame is held until it is read: the frames addressed to the node meanwhile are dropped,
+ *          see USARTMultidropGetDropped().
+ *
+ */
+extern void USARTMultidropInit(uint8_t bgr, uint8_t address);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Change the node address
+ * @param   address: node address, from 0 to 254
+ * @retval  none
+ *
+ */
+extern void USARTMultidropSetAddress(uint8_t address);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Send a frame to a node, or to all of them
+ * @param   address: destination node address, or @ref USART_MD_BROADCAST
+ * @param   data: payload
+ * @param   len: payload length, up to the USART_MD_FRAME_SIZE of the destination
+ * @retval  none
+ * @note    The bytes are written to TXREG directly, it returns once the last one is shifted out
+ *          (and the transceiver released, See USART_MD_DE_PIN).
+ *
+ */
+extern void USARTMultidropSend(uint8_t address, const uint8_t *data, uint8_t len);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Check whether a frame has been received
+ * @param   none
+ * @retval  1: a frame is waiting, 0: none
+ *
+ */
+extern uint8_t USARTMultidropFrameReady(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Get the received frame and wait for the next one
+ * @param   data: buffer of @ref USART_MD_FRAME_SIZE bytes for the payload
+ * @retval      - payload length
+ *              - -1: no frame received
+ *
+ */
+extern int USARTMultidropRead(uint8_t *data);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Get the number of frames addressed to the node that were dropped: received before the
+ *          previous one was read, or longer than @ref USART_MD_FRAME_SIZE
+ * @param   none
+ * @retval  number of frames dropped
+ *
+ */
+extern uint16_t USARTMultidropGetDropped(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Call-back function for the USART interrupt driven transmission, to be placed inside the interrupt service routines.
+ *          See ISR.c file.
+ * @param   none
+ * @retval  none
+ * @note    With USE_INTERRUPT_DISPATCHER, USARTTxIntEnable() registers it in the dispatcher.
+ *
+ */
+extern void USARTTxCallBack(void);
+//-----------------------------------
+
+//-----------------------------------
+/**
+ * @brief   Call-back function for the USART interrupt driven reception, to be placed inside the interrupt service routines.
+ *          See ISR.c file.
+ * @param   none
+ * @retval  none
+ * @note    With USE_INTERRUPT_DISPATCHER, USARTRxIntEnable() and USARTMultidropInit() register it in the dispatcher.
+ *
+ */
+extern void USARTRxCallBack(void);
+//-----------------------------------
+
 #ifdef	__cplusplus
 }
 #endif
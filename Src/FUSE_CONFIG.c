@@ -17,7 +17,7 @@
 #pragma config CCP2MUX  = ON            //!< CCP2 Mux bit (CCP2 input/output is multiplexed with RC1)
 
 // CONFIG4L
-#pragma config STVR     = OFF           //!< Stack Full/Underflow Reset Enable bit (Stack Full/Underflow will not cause RESET)
+#pragma config STVR     = ON            //!< Stack Full/Underflow Reset Enable bit (Stack Full/Underflow will cause RESET, reported by MemMonInit())
 #pragma config LVP      = OFF           //!< Low Voltage ICSP Enable bit (Low Voltage ICSP disabled)
 
 // CONFIG5L
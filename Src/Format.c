@@ -0,0 +1,319 @@
+/**
+ ******************************************************************************
+ * @file            Format.c
+ * @author          Maxime
+ * @brief           Source file for PIC18 formatted output library
+ * @brief           See Format.h
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include <stdarg.h>
+#include "../Inc/Format.h"
+#if defined(USE_PROFILE)
+#include <stdio.h>
+#include "../Inc/Profile.h"
+#endif
+//-----------------------------------
+
+//-----------------------------------
+#define FORMAT_LEFT                 0x01                        //!< '-' flag
+#define FORMAT_ZERO                 0x02                        //!< '0' flag
+#define FORMAT_LONG                 0x04                        //!< 'l' modifier
+//-----------------------------------
+static const uint32_t FormatPow32[6] = { 1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 10000UL };
+static const uint16_t FormatPow16[5] = { 10000, 1000, 100, 10, 1 };
+static const char FormatHexLower[] = "0123456789abcdef";
+static const char FormatHexUpper[] = "0123456789ABCDEF";
+//-----------------------------------
+static char *FormatBufPtr;                                      //!< FormatString() destination
+static uint8_t FormatBufFree;
+//-----------------------------------
+
+/**
+ * @brief   Write the decimal digits of a number, without division
+ * @retval  number of digits, from 1 to 10
+ *
+ */
+static uint8_t FormatDigits(char *buf, uint32_t value)
+{
+    //---------
+    uint16_t low;
+    uint8_t i = 0, n = 0;
+    char d;
+    //---------
+    if(value > 0xFFFF)
+    {
+        for(i = 0; i < 6; ++i)                                  //!< Down to the 10000s, the rest fits in 16 bits
+        {
+            d = '0';
+            while(value >= FormatPow32[i])
+            {
+                value -= FormatPow32[i];
+                ++d;
+            }
+            if(d != '0' || n != 0)
+                buf[n++] = d;
+        }
+        i = 1;
+    }
+    //---------
+    low = (uint16_t)value;
+    for(; i < 5; ++i)
+    {
+        d = '0';
+        while(low >= FormatPow16[i])
+        {
+            low -= FormatPow16[i];
+            ++d;
+        }
+        if(d != '0' || n != 0 || i == 4)
+            buf[n++] = d;
+    }
+    //---------
+    return n;
+}
+//-----------------------------------
+
+/**
+ * @brief   Write a character several times
+ *
+ */
+static void FormatRepeat(FormatSinkType sink, char c, uint8_t cnt)
+{
+    //---------
+    while(cnt != 0)
+    {
+        sink((uint8_t)c);
+        --cnt;
+    }
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Format engine, shared by FormatPrint() and FormatString()
+ *
+ */
+static void FormatOutput(FormatSinkType sink, const char *fmt, va_list ap)
+{
+    //---------
+    char buf[10];
+    const char *digits;
+    const char *hex;
+    uint32_t value;
+    uint8_t flags, width, decimals, lead, n, i, len;
+    char c, sign;
+    //---------
+    while((c = *fmt++) != '\0')
+    {
+        if(c != '%')
+        {
+            sink((uint8_t)c);
+            continue;
+        }
+        //---------
+        flags = 0;
+        width = 0;
+        decimals = 0;
+        for(c = *fmt++; c == '-' || c == '0'; c = *fmt++)
+            flags |= c == '-' ? FORMAT_LEFT : FORMAT_ZERO;
+        for(; c >= '0' && c <= '9'; c = *fmt++)
+            width = (uint8_t)(width * 10 + (c - '0'));
+        if(c == '.')
+        {
+            c = *fmt++;
+            if(c >= '1' && c <= '9')
+            {
+                decimals = (uint8_t)(c - '0');
+                c = *fmt++;
+            }
+        }
+        if(c == 'l')
+        {
+            flags |= FORMAT_LONG;
+            c = *fmt++;
+        }
+        if(c == '\0')
+            return;
+        //---------
+        sign = 0;
+        digits = buf;
+        switch(c)
+        {
+            case 'd':
+            case 'u':
+                if(flags & FORMAT_LONG)
+                    value = (uint32_t)va_arg(ap, unsigned long);
+                else if(c == 'd')
+                    value = (uint32_t)(int32_t)(int16_t)va_arg(ap, int);    //!< Sign extended
+                else
+                    value = (uint16_t)va_arg(ap, unsigned int);
+                if(c == 'd' && (int32_t)value < 0)
+                {
+                    sign = '-';
+                    value = 0 - value;
+                }
+                n = FormatDigits(buf, value);
+                break;
+            case 'x':
+            case 'X':
+                if(flags & FORMAT_LONG)
+                    value = (uint32_t)va_arg(ap, unsigned long);
+                else
+                    value = (uint16_t)va_arg(ap, unsigned int);
+                hex = c == 'x' ? FormatHexLower : FormatHexUpper;
+                n = 0;
+                do
+                {
+                    buf[sizeof(buf) - 1 - n] = hex[(uint8_t)value & 0x0F];
+                    ++n;
+                    value >>= 4;
+                }while(value != 0);
+                digits = buf + sizeof(buf) - n;
+                decimals = 0;
+                break;
+            case 'c':
+                buf[0] = (char)va_arg(ap, int);
+                n = 1;
+                flags &= (uint8_t)~FORMAT_ZERO;
+                decimals = 0;
+                break;
+            case 's':
+                digits = va_arg(ap, const char *);
+                for(n = 0; digits[n] != '\0' && n != 0xFF; ++n);
+                flags &= (uint8_t)~FORMAT_ZERO;
+                decimals = 0;
+                break;
+            default:                                            //!< "%%", and unknown conversions printed as is
+                buf[0] = c;
+                n = 1;
+                flags = 0;
+                width = 0;
+                decimals = 0;
+                break;
+        }
+        //---------
+        lead = 0;                                               //!< Zeros of a fixed point value below 1
+        len = n;
+        if(decimals != 0)
+        {
+            if(n <= decimals)
+                lead = (uint8_t)(decimals + 1 - n);
+            len = (uint8_t)(n + lead + 1);
+        }
+        if(sign)
+            ++len;
+        width = width > len ? (uint8_t)(width - len) : 0;       //!< Padding
+        //---------
+        if(!(flags & (FORMAT_LEFT | FORMAT_ZERO)))
+            FormatRepeat(sink, ' ', width);
+        if(sign)
+            sink((uint8_t)sign);
+        if((flags & (FORMAT_LEFT | FORMAT_ZERO)) == FORMAT_ZERO)
+            FormatRepeat(sink, '0', width);
+        for(i = (uint8_t)(n + lead); i != 0; --i)               //!< Digits left to write
+        {
+            if(i == decimals)
+                sink('.');
+            sink(i > n ? '0' : (uint8_t)*digits++);
+        }
+        if(flags & FORMAT_LEFT)
+            FormatRepeat(sink, ' ', width);
+    }
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   FormatString() output function
+ *
+ */
+static void FormatBufferSink(uint8_t data)
+{
+    //---------
+    if(FormatBufFree > 1)                                       //!< Room kept for the '\0'
+    {
+        *FormatBufPtr++ = (char)data;
+        --FormatBufFree;
+    }
+    //---------
+}
+//-----------------------------------
+
+void FormatPrint(FormatSinkType sink, const char *fmt, ...)
+{
+    //---------
+    va_list ap;
+    //---------
+    va_start(ap, fmt);
+    FormatOutput(sink, fmt, ap);
+    va_end(ap);
+    //---------
+}
+//-----------------------------------
+
+uint8_t FormatString(char *buf, uint8_t size, const char *fmt, ...)
+{
+    //---------
+    va_list ap;
+    //---------
+    if(size == 0)
+        return 0;
+    //---------
+    FormatBufPtr = buf;
+    FormatBufFree = size;
+    va_start(ap, fmt);
+    FormatOutput(FormatBufferSink, fmt, ap);
+    va_end(ap);
+    *FormatBufPtr = '\0';
+    //---------
+    return (uint8_t)(FormatBufPtr - buf);
+}
+//-----------------------------------
+
+char *FormatDec(char *str, uint32_t value)
+{
+    return str + FormatDigits(str, value);
+}
+//-----------------------------------
+
+#if defined(USE_PROFILE)
+
+//-----------------------------------
+#define FORMAT_BENCH_RUN(i, f, a, b)    { t = ProfileTime(); sprintf(buf, f, a, b); \
+                                          cycles[i][0] = ProfileTime() - t; \
+                                          t = ProfileTime(); FormatString(buf, sizeof(buf), f, a, b); \
+                                          cycles[i][1] = ProfileTime() - t; }
+//-----------------------------------
+
+void FormatBenchmark(void (*print)(const char *str))
+{
+    //---------
+    static const char *const names[3] = { "%u %u", "%d %04X", "%lu %s" };
+    uint32_t cycles[3][2], t;
+    char buf[24];
+    char line[48];
+    uint8_t i;
+    //---------
+    FORMAT_BENCH_RUN(0, "%u %u", 65535u, 42u);
+    FORMAT_BENCH_RUN(1, "%d %04X", -12345, 0xBEEFu);
+    FORMAT_BENCH_RUN(2, "%lu %s", 4000000000UL, "ok");
+    //---------
+    for(i = 0; i < 3; ++i)
+    {
+        FormatString(line, sizeof(line), "%-8s sprintf=%lu format=%lu\r", names[i],
+                     (unsigned long)cycles[i][0], (unsigned long)cycles[i][1]);
+        print(line);
+    }
+    //---------
+}
+//-----------------------------------
+
+#endif
@@ -22,6 +22,11 @@
 #include "../Inc/GPIO.h"
 #include "../Inc/SystemTime.h"
 #include "../Inc/SoftwareUART.h"
+#include "../Inc/USART.h"
+#include "../Inc/Profile.h"
+#include "../Inc/MemoryMonitor.h"
+#include "../Inc/Packet.h"
+#include "../Inc/Trace.h"
 //#include "../../../WWM_APIs/SIMCOM/SIM800x.X/Inc/SIM800x_SDM.h"
 //-----------------------------------
 
@@ -36,7 +41,12 @@
  */
 void high_priority interrupt HighIsr(void)
 {
-    
+#if defined(USE_STACK_MONITOR)
+    MemMonStackSample();
+#endif
+#if defined(USE_INTERRUPT_DISPATCHER)
+    InterruptDispatchHigh();
+#endif
 }
 //-----------------------------------
 
@@ -49,7 +59,12 @@ void high_priority interrupt HighIsr(void)
  */
 void low_priority interrupt LowIsr(void)
 {
-    
+#if defined(USE_STACK_MONITOR)
+    MemMonStackSample();
+#endif
+#if defined(USE_INTERRUPT_DISPATCHER)
+    InterruptDispatchLow();
+#endif
 }
 //-----------------------------------
 
@@ -64,10 +79,32 @@ void low_priority interrupt LowIsr(void)
  */
 void interrupt Isr(void)
 {
+#if defined(USE_STACK_MONITOR)
+    MemMonStackSample();
+#endif
+#if defined(USE_INTERRUPT_DISPATCHER)
+    InterruptDispatch();                        //!< Handlers registered with InterruptRegisterHandler() (See main.c)
+#else
     SysTimeCallBack();
     //---------
     SoftUARTCallBack();
+    //---------
+#if defined(USE_PACKET)
+    PacketRxCallBack();
+    PacketTxCallBack();
+#else
+    USARTRxCallBack();
+#if defined(USE_TRACE)
+    TraceTxCallBack();
+#else
+    USARTTxCallBack();
+#endif
+#endif
+#if defined(USE_PROFILE)
+    ProfileCallBack();
+#endif
     //SIM800xSDMCallBack();
+#endif
 }
 //-----------------------------------
 
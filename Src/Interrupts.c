@@ -15,6 +15,7 @@
 
 //-----------------------------------
 #include "../Inc/Interrupts.h"
+#include "../Inc/Format.h"
 //-----------------------------------
 void InterruptEnable(ConfigType cfg)
 {
@@ -83,4 +84,480 @@ void InterruptSetPriorityLow(ConfigType cfg)
     IPR2 &= (uint8_t)(~cfg.grp4);
     //---------     
 }
-//-----------------------------------
\ No newline at end of file
+//-----------------------------------
+
+void InterruptTimeBaseStart(void)
+{
+    //---------
+    if((T3CON & 0xB3) == 0x81)                      //!< Running already: the other user's times stay valid
+        return;
+    //---------
+    T3CON = 0x00;                                   //!< Stopped to load the counter
+    TMR3H = 0;
+    TMR3L = 0;
+    PIR2bits.TMR3IF = 0;
+    T3CON = 0x81;                                   //!< 16 bits reads, CCP1/CCP2 on Timer1, prescaler 1:1, internal clock, on
+    //---------
+}
+//-----------------------------------
+//-----------------------------------
+// Interrupt handlers dispatcher
+//-----------------------------------
+/**
+ * @brief   Registered interrupt handler type
+ *
+ */
+typedef struct
+{
+    volatile uint8_t *Flag;                         //!< Flag register (INTCON, INTCON3, PIR1, PIR2)
+    volatile uint8_t *Enable;                       //!< Enable register (INTCON, INTCON3, PIE1, PIE2)
+    volatile uint8_t *Level;                        //!< Priority register (INTCON2, INTCON3, IPR1, IPR2), NULL: always high priority
+    uint8_t FlagMask;
+    uint8_t EnableMask;
+    uint8_t LevelMask;
+    uint8_t Priority;                               //!< Dispatch order
+    InterruptHandlerType Handler;
+#if defined(USE_INTERRUPT_STATS)
+    InterruptStatsType Stats;
+#endif
+}InterruptHandlerEntryType;
+//-----------------------------------
+#if defined(USE_INTERRUPT_STATS) && !defined(USE_INTERRUPT_DISPATCHER)
+#error "USE_INTERRUPT_STATS requires USE_INTERRUPT_DISPATCHER"
+#endif
+#if defined(USE_INTERRUPT_STATS) && ((INTERRUPT_STATS_BUCKETS < 2) || (INTERRUPT_STATS_BUCKETS > 16))
+#error "INTERRUPT_STATS_BUCKETS must be from 2 to 16"
+#endif
+//-----------------------------------
+static InterruptHandlerEntryType InterruptHandlers[INTERRUPT_MAX_HANDLERS];
+static uint8_t InterruptHandlerCnt = 0;
+//-----------------------------------
+
+static uint8_t InterruptFindHandler(uint16_t flag)
+{
+    //---------
+    uint8_t i;
+    volatile uint8_t *reg;
+    //---------
+    switch((uint8_t)(flag >> 8))
+    {
+        case 0: reg = &INTCON; break;
+        case 1: reg = &INTCON3; break;
+        case 2: reg = &PIR1; break;
+        default: reg = &PIR2; break;
+    }
+    for(i = 0; i < InterruptHandlerCnt; ++i)
+    {
+        if(InterruptHandlers[i].Flag == reg && InterruptHandlers[i].FlagMask == (uint8_t)flag)
+            break;
+    }
+    //---------
+    return i;
+}
+//-----------------------------------
+
+#if defined(USE_INTERRUPT_STATS)
+
+/**
+ * @brief   Timer3 count, TMR3L read first: it latches TMR3H (RD16)
+ *
+ */
+static uint16_t InterruptStatsTime(void)
+{
+    //---------
+    uint16_t t = TMR3L;
+    //---------
+    return t | ((uint16_t)TMR3H << 8);
+}
+//-----------------------------------
+
+static void InterruptStatsReset(InterruptStatsType *stats, uint16_t flag)
+{
+    //---------
+    uint8_t i;
+    //---------
+    stats->Flag = flag;
+    stats->Timer = 0;
+    stats->Count = 0;
+    stats->LatencyMin = stats->DurationMin = 0xFFFF;
+    stats->LatencyMax = stats->DurationMax = 0;
+    stats->LatencySum = stats->DurationSum = 0;
+    for(i = 0; i < INTERRUPT_STATS_BUCKETS; ++i)
+        stats->LatencyHist[i] = stats->DurationHist[i] = 0;
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Count a value in its histogram bucket, See INTERRUPT_STATS_CONFIG
+ *
+ */
+static void InterruptStatsBucket(uint16_t *hist, uint16_t value)
+{
+    //---------
+    uint8_t b = 0;
+    //---------
+    value >>= INTERRUPT_STATS_SHIFT + 1;
+    while(value != 0 && b < INTERRUPT_STATS_BUCKETS - 1)
+    {
+        value >>= 1;
+        ++b;
+    }
+    if(hist[b] != 0xFFFF)
+        ++hist[b];
+}
+//-----------------------------------
+
+/**
+ * @brief   Latency of a timer interrupt: the timer counts since its overflow (since its PR2 match
+ *          for Timer2), times its prescaler
+ * @param   flag: interrupt source
+ * @param   latency: instruction cycles, saturated at 65535
+ * @retval  1: timer source on the instruction clock, 0: latency unknown
+ *
+ */
+static uint8_t InterruptStatsTimerLatency(uint16_t flag, uint16_t *latency)
+{
+    //---------
+    uint16_t t;
+    uint8_t con, shift;
+    //---------
+    switch(flag)
+    {
+        case TMR0_OVF_INT_FLAG:
+            con = T0CON;
+            if(con & 0x20)                                      //!< T0CKI
+                return 0;
+            t = TMR0L;                                          //!< Latches TMR0H
+            if(!(con & 0x40))
+                t |= (uint16_t)TMR0H << 8;
+            shift = (con & 0x08) ? 0 : (uint8_t)((con & 0x07) + 1);
+            break;
+        case TMR1_OVF_INT_FLAG:
+            con = T1CON;
+            if(con & 0x02)                                      //!< T13CKI or Timer1 oscillator
+                return 0;
+            t = TMR1L;
+            t |= (uint16_t)TMR1H << 8;
+            shift = (uint8_t)((con >> 4) & 0x03);
+            break;
+        case TMR2_PR2_INT_FLAG:
+            con = T2CON;
+            t = TMR2;                                           //!< Cleared by the match
+            shift = (con & 0x03) == 0 ? 0 : ((con & 0x03) == 1 ? 2 : 4);
+            break;
+        case TMR3_INT_FLAG:
+            con = T3CON;
+            if(con & 0x02)
+                return 0;
+            t = TMR3L;
+            t |= (uint16_t)TMR3H << 8;
+            shift = (uint8_t)((con >> 4) & 0x03);
+            break;
+        default:
+            return 0;
+    }
+    //---------
+    *latency = (t > (0xFFFF >> shift)) ? 0xFFFF : (uint16_t)(t << shift);
+    return 1;
+}
+//-----------------------------------
+
+/**
+ * @brief   Call a handler and record its latency and its duration
+ *
+ */
+static void InterruptStatsCall(InterruptHandlerEntryType *entry, uint16_t entered)
+{
+    //---------
+    InterruptStatsType *stats = &entry->Stats;
+    uint16_t start, latency, duration;
+    uint8_t timer;
+    //---------
+    timer = InterruptStatsTimerLatency(stats->Flag, &latency);  //!< Read last before the call
+    start = InterruptStatsTime();
+    entry->Handler();
+    duration = InterruptStatsTime() - start;
+    if(!timer)
+        latency = start - entered;                              //!< Dispatch delay
+    //---------
+    stats->Timer = timer;
+    ++stats->Count;
+    if(latency < stats->LatencyMin)
+        stats->LatencyMin = latency;
+    if(latency > stats->LatencyMax)
+        stats->LatencyMax = latency;
+    stats->LatencySum += latency;
+    InterruptStatsBucket(stats->LatencyHist, latency);
+    if(duration < stats->DurationMin)
+        stats->DurationMin = duration;
+    if(duration > stats->DurationMax)
+        stats->DurationMax = duration;
+    stats->DurationSum += duration;
+    InterruptStatsBucket(stats->DurationHist, duration);
+    //---------
+}
+//-----------------------------------
+
+#endif
+
+uint8_t InterruptRegisterHandler(uint16_t flag, uint8_t priority, InterruptHandlerType handler)
+{
+    //---------
+    InterruptHandlerEntryType entry;
+    uint8_t mask = (uint8_t)(flag & 0xFF);
+    uint8_t gie = INTCONbits.GIE;
+    uint8_t i;
+    //---------
+    switch((uint8_t)(flag >> 8))                    //!< Same register codes as InterruptGetFlag()
+    {
+        case 0:                                     //!< INTCON: TMR0IE/INT0IE/RBIE are 3 bits above the flags
+            entry.Flag = &INTCON;
+            entry.Enable = &INTCON;
+            entry.EnableMask = (uint8_t)(mask << 3);
+            entry.Level = (mask == INT0_INT_FLAG) ? (volatile uint8_t *)0 : &INTCON2;
+            entry.LevelMask = mask;                 //!< TMR0IP/RBIP have the same position as the flags
+            break;
+        case 1:                                     //!< INTCON3: INT1IE/INT2IE 3 bits above, INT1IP/INT2IP 6 bits above the flags
+            entry.Flag = &INTCON3;
+            entry.Enable = &INTCON3;
+            entry.EnableMask = (uint8_t)(mask << 3);
+            entry.Level = &INTCON3;
+            entry.LevelMask = (uint8_t)(mask << 6);
+            break;
+        case 2:
+            entry.Flag = &PIR1;
+            entry.Enable = &PIE1;
+            entry.EnableMask = mask;
+            entry.Level = &IPR1;
+            entry.LevelMask = mask;
+            break;
+        default:
+            entry.Flag = &PIR2;
+            entry.Enable = &PIE2;
+            entry.EnableMask = mask;
+            entry.Level = &IPR2;
+            entry.LevelMask = mask;
+            break;
+    }
+    entry.FlagMask = mask;
+    entry.Priority = priority;
+    entry.Handler = handler;
+#if defined(USE_INTERRUPT_STATS)
+    InterruptStatsReset(&entry.Stats, flag);
+#endif
+    //---------
+    di();                                           //!< The table must not change under the ISR
+    InterruptUnregisterHandler(flag);
+    if(InterruptHandlerCnt >= INTERRUPT_MAX_HANDLERS)
+    {
+        if(gie)
+            ei();
+        return 1;
+    }
+    for(i = InterruptHandlerCnt; i > 0 && InterruptHandlers[i - 1].Priority > priority; --i)
+        InterruptHandlers[i] = InterruptHandlers[i - 1];
+    InterruptHandlers[i] = entry;
+    ++InterruptHandlerCnt;
+    if(gie)
+        ei();
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+void InterruptUnregisterHandler(uint16_t flag)
+{
+    //---------
+    uint8_t gie = INTCONbits.GIE;
+    uint8_t i;
+    //---------
+    di();
+    i = InterruptFindHandler(flag);
+    if(i < InterruptHandlerCnt)
+    {
+        --InterruptHandlerCnt;
+        for(; i < InterruptHandlerCnt; ++i)
+            InterruptHandlers[i] = InterruptHandlers[i + 1];
+    }
+    if(gie)
+        ei();
+    //---------
+}
+//-----------------------------------
+
+void InterruptDispatch(void)
+{
+    //---------
+#if defined(USE_INTERRUPT_STATS)
+    uint16_t entered = InterruptStatsTime();
+#endif
+    InterruptHandlerEntryType *entry = InterruptHandlers;
+    uint8_t cnt = InterruptHandlerCnt;
+    //---------
+    for(; cnt != 0; --cnt, ++entry)
+    {
+        if((SFR_PTR_ACCESS(entry->Enable) & entry->EnableMask) && (SFR_PTR_ACCESS(entry->Flag) & entry->FlagMask))
+#if defined(USE_INTERRUPT_STATS)
+            InterruptStatsCall(entry, entered);
+#else
+            entry->Handler();
+#endif
+    }
+    //---------
+}
+//-----------------------------------
+
+#if defined(USE_HIGH_LOW_ISR)
+
+static void InterruptDispatchLevel(uint8_t high)
+{
+    //---------
+#if defined(USE_INTERRUPT_STATS)
+    uint16_t entered = InterruptStatsTime();
+#endif
+    InterruptHandlerEntryType *entry = InterruptHandlers;
+    uint8_t cnt = InterruptHandlerCnt;
+    uint8_t level;
+    //---------
+    for(; cnt != 0; --cnt, ++entry)
+    {
+        level = (entry->Level == 0) ? 1 : ((SFR_PTR_ACCESS(entry->Level) & entry->LevelMask) != 0);
+        if(level == high && (SFR_PTR_ACCESS(entry->Enable) & entry->EnableMask) && (SFR_PTR_ACCESS(entry->Flag) & entry->FlagMask))
+#if defined(USE_INTERRUPT_STATS)
+            InterruptStatsCall(entry, entered);
+#else
+            entry->Handler();
+#endif
+    }
+    //---------
+}
+//-----------------------------------
+
+void InterruptDispatchHigh(void)
+{
+    InterruptDispatchLevel(1);
+}
+//-----------------------------------
+
+void InterruptDispatchLow(void)
+{
+    InterruptDispatchLevel(0);
+}
+//-----------------------------------
+
+#endif
+
+#if defined(USE_INTERRUPT_STATS)
+
+void InterruptStatsInit(void)
+{
+    //---------
+    InterruptTimeBaseStart();
+    InterruptStatsClear();
+    //---------
+}
+//-----------------------------------
+
+void InterruptStatsClear(void)
+{
+    //---------
+    uint8_t gie = INTCONbits.GIE;
+    uint8_t i;
+    //---------
+    di();
+    for(i = 0; i < InterruptHandlerCnt; ++i)
+        InterruptStatsReset(&InterruptHandlers[i].Stats, InterruptHandlers[i].Stats.Flag);
+    if(gie)
+        ei();
+    //---------
+}
+//-----------------------------------
+
+uint8_t InterruptGetStats(uint8_t index, InterruptStatsType *stats)
+{
+    //---------
+    uint8_t gie = INTCONbits.GIE;
+    //---------
+    if(index >= InterruptHandlerCnt)
+        return 1;
+    di();
+    *stats = InterruptHandlers[index].Stats;
+    if(gie)
+        ei();
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+/**
+ * @brief   Append "<min>/<mean>/<max> [<hist>]" to a string
+ * @retval  end of the string
+ *
+ */
+static char *InterruptStatsTimes(char *str, uint16_t min, uint32_t sum, uint16_t max, const uint16_t *hist, uint32_t cnt)
+{
+    //---------
+    uint8_t i;
+    //---------
+    str = FormatDec(str, cnt ? min : 0);
+    *str++ = '/';
+    str = FormatDec(str, cnt ? sum / cnt : 0);
+    *str++ = '/';
+    str = FormatDec(str, max);
+    *str++ = ' ';
+    *str++ = '[';
+    for(i = 0; i < INTERRUPT_STATS_BUCKETS; ++i)
+    {
+        if(i != 0)
+            *str++ = ' ';
+        str = FormatDec(str, hist[i]);
+    }
+    *str++ = ']';
+    //---------
+    return str;
+}
+//-----------------------------------
+
+void InterruptStatsPrint(void (*print)(const char *str))
+{
+    //---------
+    static const char hex[] = "0123456789ABCDEF";
+    char line[44 + 6 * INTERRUPT_STATS_BUCKETS];                //!< Printed in two parts
+    InterruptStatsType stats;
+    char *str;
+    uint8_t i, d;
+    //---------
+    for(i = 0; InterruptGetStats(i, &stats) == 0; ++i)
+    {
+        str = line;
+        for(d = 0; d < 4; ++d)
+            *str++ = hex[(stats.Flag >> (12 - 4 * d)) & 0x0F];
+        *str++ = ' ';
+        *str++ = 'n';
+        *str++ = '=';
+        str = FormatDec(str, stats.Count);
+        *str++ = ' ';
+        *str++ = stats.Timer ? 'l' : 'd';                       //!< "lat": from the interrupt flag, "dly": from the dispatcher entry
+        *str++ = stats.Timer ? 'a' : 'l';
+        *str++ = stats.Timer ? 't' : 'y';
+        *str++ = '=';
+        str = InterruptStatsTimes(str, stats.LatencyMin, stats.LatencySum, stats.LatencyMax, stats.LatencyHist, stats.Count);
+        *str = '\0';
+        print(line);
+        str = line;
+        *str++ = ' ';
+        *str++ = 'd';
+        *str++ = 'u';
+        *str++ = 'r';
+        *str++ = '=';
+        str = InterruptStatsTimes(str, stats.DurationMin, stats.DurationSum, stats.DurationMax, stats.DurationHist, stats.Count);
+        *str++ = '\r';
+        *str = '\0';
+        print(line);
+    }
+    //---------
+}
+//-----------------------------------
+
+#endif
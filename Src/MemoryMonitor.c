@@ -0,0 +1,173 @@
+/**
+ ******************************************************************************
+ * @file            MemoryMonitor.c
+ * @author          Maxime
+ * @brief           Source file for PIC18 hardware stack and RAM usage monitor
+ * @brief           See MemoryMonitor.h
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include "../Inc/MemoryMonitor.h"
+#include "../Inc/Format.h"
+//-----------------------------------
+
+/**
+ * @brief   Monitored RAM region type
+ *
+ */
+typedef struct
+{
+    const char *Name;
+    const uint8_t *Buf;
+    uint16_t Size;
+}MemMonRegionType;
+//-----------------------------------
+static volatile MemMonStackType MemMonStack;
+static MemMonRegionType MemMonRegions[MEMMON_REGIONS];
+static uint8_t MemMonRegionCnt = 0;
+//-----------------------------------
+
+void MemMonInit(void)
+{
+    //---------
+    uint8_t stkptr = STKPTR;
+    //---------
+    MemMonStack.Boot = stkptr & (MEMMON_BOOT_STACK_FULL | MEMMON_BOOT_STACK_UNDERFLOW);
+    STKPTRbits.STKFUL = 0;                                      //!< Bit instructions: the stack pointer is not modified
+    STKPTRbits.STKUNF = 0;
+    MemMonStack.MaxDepth = stkptr & 0x1F;
+    MemMonStack.Full = 0;
+    MemMonStack.Underflow = 0;
+    MemMonRegionCnt = 0;
+    //---------
+}
+//-----------------------------------
+
+void MemMonStackSample(void)
+{
+    //---------
+    uint8_t stkptr = STKPTR;
+    uint8_t depth = stkptr & 0x1F;
+    //---------
+    if(depth > MemMonStack.MaxDepth)
+        MemMonStack.MaxDepth = depth;
+    if(stkptr & 0x80)
+    {
+        STKPTRbits.STKFUL = 0;
+        if(MemMonStack.Full != 0xFF)
+            ++MemMonStack.Full;
+        MemMonStack.MaxDepth = MEMMON_STACK_LEVELS;
+    }
+    if(stkptr & 0x40)
+    {
+        STKPTRbits.STKUNF = 0;
+        if(MemMonStack.Underflow != 0xFF)
+            ++MemMonStack.Underflow;
+    }
+    //---------
+}
+//-----------------------------------
+
+void MemMonGetStack(MemMonStackType *stack)
+{
+    //---------
+    uint8_t gie = INTCONbits.GIE;
+    //---------
+    di();
+    stack->MaxDepth = MemMonStack.MaxDepth;
+    stack->Full = MemMonStack.Full;
+    stack->Underflow = MemMonStack.Underflow;
+    stack->Boot = MemMonStack.Boot;
+    if(gie)
+        ei();
+    //---------
+}
+//-----------------------------------
+
+uint8_t MemMonAddRegion(const char *name, void *buf, uint16_t size)
+{
+    //---------
+    uint8_t *p = (uint8_t *)buf;
+    uint16_t i;
+    //---------
+    if(MemMonRegionCnt >= MEMMON_REGIONS)
+        return 1;
+    //---------
+    for(i = 0; i < size; ++i)
+        p[i] = MEMMON_PAINT_PATTERN;
+    MemMonRegions[MemMonRegionCnt].Name = name;
+    MemMonRegions[MemMonRegionCnt].Buf = p;
+    MemMonRegions[MemMonRegionCnt].Size = size;
+    ++MemMonRegionCnt;
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+uint16_t MemMonHighWater(const void *buf, uint16_t size)
+{
+    //---------
+    const uint8_t *p = (const uint8_t *)buf;
+    //---------
+    while(size != 0 && p[size - 1] == MEMMON_PAINT_PATTERN)
+        --size;
+    //---------
+    return size;
+}
+//-----------------------------------
+
+/**
+ * @brief   Append "<label><decimal value>" to a string
+ * @retval  end of the string
+ *
+ */
+static char *MemMonField(char *str, const char *label, uint16_t value)
+{
+    //---------
+    while(*label)
+        *str++ = *label++;
+    //---------
+    return FormatDec(str, value);
+}
+//-----------------------------------
+
+void MemMonPrint(void (*print)(const char *str))
+{
+    //---------
+    static const char hex[] = "0123456789ABCDEF";
+    char line[64];
+    MemMonStackType stack;
+    char *str;
+    uint8_t i;
+    //---------
+    MemMonGetStack(&stack);
+    str = MemMonField(line, "stack max=", stack.MaxDepth);
+    str = MemMonField(str, "/", MEMMON_STACK_LEVELS);
+    str = MemMonField(str, " full=", stack.Full);
+    str = MemMonField(str, " underflow=", stack.Underflow);
+    str = MemMonField(str, " boot=", 0);
+    str[-1] = hex[stack.Boot >> 4];                             //!< Hexadecimal, over the 0 placeholder
+    *str++ = hex[stack.Boot & 0x0F];
+    *str++ = '\r';
+    *str = '\0';
+    print(line);
+    //---------
+    for(i = 0; i < MemMonRegionCnt; ++i)
+    {
+        print(MemMonRegions[i].Name);
+        str = MemMonField(line, " used=", MemMonHighWater(MemMonRegions[i].Buf, MemMonRegions[i].Size));
+        str = MemMonField(str, "/", MemMonRegions[i].Size);
+        *str++ = '\r';
+        *str = '\0';
+        print(line);
+    }
+    //---------
+}
+//-----------------------------------
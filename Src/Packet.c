@@ -0,0 +1,309 @@
+/**
+ ******************************************************************************
+ * @file            Packet.c
+ * @author          Maxime
+ * @brief           Source file for PIC18 USART packet layer
+ * @brief           See Packet.h
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include <stddef.h>
+#include "../Inc/Packet.h"
+#include "../Inc/Interrupts.h"
+#include "../Inc/CRC.h"
+//-----------------------------------
+
+//-----------------------------------
+#if (PACKET_MAX_SIZE < 1) || (PACKET_MAX_SIZE > 253)
+#error "PACKET_MAX_SIZE must be from 1 to 253"
+#endif
+#define PACKET_RX_SLOTS_MASK        (PACKET_RX_SLOTS - 1)
+#if (PACKET_RX_SLOTS < 1) || (PACKET_RX_SLOTS > 8) || ((PACKET_RX_SLOTS & PACKET_RX_SLOTS_MASK) != 0)
+#error "PACKET_RX_SLOTS must be a power of two, from 1 to 8"
+#endif
+#define PACKET_CRC_INIT             CRC16_INIT
+//-----------------------------------
+#define PACKET_TX_IDLE              0
+#define PACKET_TX_START             1                           //!< Opening END
+#define PACKET_TX_DATA              2
+#define PACKET_TX_CRC_MSB           3
+#define PACKET_TX_CRC_LSB           4
+#define PACKET_TX_END               5                           //!< Closing END
+//-----------------------------------
+static uint8_t PacketRxBuf[PACKET_RX_SLOTS][PACKET_MAX_SIZE + 2];  //!< Payload and CRC
+static uint8_t PacketRxLen[PACKET_RX_SLOTS];
+static volatile uint8_t PacketRxHead = 0;                       //!< Free running slot index, only modified by PacketRxCallBack()
+static volatile uint8_t PacketRxTail = 0;                       //!< Free running slot index, only modified by the application
+static uint8_t PacketRxCnt = 0;                                 //!< Bytes decoded in the current packet
+static uint16_t PacketRxCrc = PACKET_CRC_INIT;
+static uint8_t PacketRxEsc = 0;                                 //!< ESC received
+static uint8_t PacketRxDiscard = 0;                             //!< Packet rejected, skipped up to the next END
+static volatile PacketStatsType PacketStats;
+//-----------------------------------
+static const uint8_t *PacketTxData;
+static uint8_t PacketTxLen = 0;
+static uint16_t PacketTxCrc;
+static uint8_t PacketTxNext = 0;                                //!< Second byte of an escape sequence, 0 if none
+static volatile uint8_t PacketTxState = PACKET_TX_IDLE;
+//-----------------------------------
+
+void PacketInit(void)
+{
+    //---------
+    PIE1bits.RCIE = 0;
+    PIE1bits.TXIE = 0;
+    PacketRxTail = PacketRxHead;
+    PacketRxCnt = 0;
+    PacketRxCrc = PACKET_CRC_INIT;
+    PacketRxEsc = 0;
+    PacketRxDiscard = 0;
+    PacketTxState = PACKET_TX_IDLE;
+    PacketTxNext = 0;
+    PacketClearStats();
+#if defined(USE_INTERRUPT_DISPATCHER)
+    InterruptRegisterHandler(USART_RX_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGH, PacketRxCallBack);
+    InterruptRegisterHandler(UART_TX_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_LOW, PacketTxCallBack);
+#endif
+    PIE1bits.RCIE = 1;
+    INTCONbits.PEIE = 1;
+    //---------
+}
+//-----------------------------------
+
+uint8_t PacketSend(const uint8_t *data, uint8_t len)
+{
+    //---------
+    if(PacketTxState != PACKET_TX_IDLE)
+        return 1;
+    //---------
+    PacketTxData = data;
+    PacketTxLen = len;
+    PacketTxCrc = PACKET_CRC_INIT;
+    PacketTxState = PACKET_TX_START;
+    PIE1bits.TXIE = 1;                                          //!< TXIF is set while TXREG is empty, the ISR fires right away
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+uint8_t PacketTxBusy(void)
+{
+    //---------
+    return (uint8_t)(PacketTxState != PACKET_TX_IDLE);
+    //---------
+}
+//-----------------------------------
+
+uint8_t *PacketReceive(uint8_t *len)
+{
+    //---------
+    uint8_t slot = PacketRxTail;
+    //---------
+    if(slot == PacketRxHead)
+        return NULL;
+    //---------
+    slot &= PACKET_RX_SLOTS_MASK;
+    *len = PacketRxLen[slot];
+    //---------
+    return PacketRxBuf[slot];
+}
+//-----------------------------------
+
+void PacketRelease(void)
+{
+    //---------
+    uint8_t tail = PacketRxTail;
+    //---------
+    if(tail != PacketRxHead)
+        PacketRxTail = (uint8_t)(tail + 1);
+    //---------
+}
+//-----------------------------------
+
+void PacketGetStats(PacketStatsType *stats)
+{
+    //---------
+    uint8_t ie = PIE1bits.RCIE;
+    //---------
+    PIE1bits.RCIE = 0;                                          //!< 16 bits counters are not updated atomically
+    *stats = PacketStats;
+    PIE1bits.RCIE = ie;
+    //---------
+}
+//-----------------------------------
+
+void PacketClearStats(void)
+{
+    //---------
+    uint8_t ie = PIE1bits.RCIE;
+    //---------
+    PIE1bits.RCIE = 0;
+    PacketStats.Received = 0;
+    PacketStats.CrcErr = 0;
+    PacketStats.FormatErr = 0;
+    PacketStats.Oversize = 0;
+    PacketStats.NoBuffer = 0;
+    PacketStats.HwOverrun = 0;
+    PIE1bits.RCIE = ie;
+    //---------
+}
+//-----------------------------------
+
+void PacketRxCallBack(void)
+{
+    //---------
+    uint8_t data, head;
+    //---------
+    if(PIE1bits.RCIE == 0)
+        return;
+    //---------
+    head = PacketRxHead;
+    while(PIR1bits.RCIF)                                        //!< Empty the 2 bytes hardware FIFO
+    {
+        if(RCSTAbits.FERR && !PacketRxDiscard)
+        {
+            ++PacketStats.FormatErr;
+            PacketRxDiscard = 1;
+        }
+        data = RCREG;
+        //---------
+        if(data == PACKET_END)
+        {
+            if(PacketRxCnt != 0 && !PacketRxDiscard)            //!< Back to back END bytes are not packets
+            {
+                if(PacketRxCnt < 2 || PacketRxCrc != 0)         //!< The CRC of the payload and its CRC is 0
+                    ++PacketStats.CrcErr;
+                else
+                {
+                    PacketRxLen[head & PACKET_RX_SLOTS_MASK] = (uint8_t)(PacketRxCnt - 2);
+                    ++head;
+                    ++PacketStats.Received;
+                }
+            }
+            PacketRxCnt = 0;
+            PacketRxCrc = PACKET_CRC_INIT;
+            PacketRxEsc = 0;
+            PacketRxDiscard = 0;
+            continue;
+        }
+        if(PacketRxDiscard)
+            continue;
+        //---------
+        if(PacketRxEsc)
+        {
+            PacketRxEsc = 0;
+            if(data == PACKET_ESC_END)
+                data = PACKET_END;
+            else if(data == PACKET_ESC_ESC)
+                data = PACKET_ESC;
+            else
+            {
+                ++PacketStats.FormatErr;
+                PacketRxDiscard = 1;
+                continue;
+            }
+        }
+        else if(data == PACKET_ESC)
+        {
+            PacketRxEsc = 1;
+            continue;
+        }
+        //---------
+        if(PacketRxCnt >= PACKET_MAX_SIZE + 2)
+        {
+            ++PacketStats.Oversize;
+            PacketRxDiscard = 1;
+            continue;
+        }
+        if((uint8_t)(head - PacketRxTail) >= PACKET_RX_SLOTS)
+        {
+            ++PacketStats.NoBuffer;
+            PacketRxDiscard = 1;
+            continue;
+        }
+        PacketRxBuf[head & PACKET_RX_SLOTS_MASK][PacketRxCnt++] = data;
+        PacketRxCrc = CRC16Update(PacketRxCrc, data);
+    }
+    PacketRxHead = head;
+    //---------
+    if(RCSTAbits.OERR)                                          //!< Reception is stopped until CREN is cycled
+    {
+        ++PacketStats.HwOverrun;
+        RCSTAbits.CREN = 0;
+        RCSTAbits.CREN = 1;
+        PacketRxDiscard = 1;                                    //!< Bytes lost in the current packet
+    }
+    //---------
+}
+//-----------------------------------
+
+void PacketTxCallBack(void)
+{
+    //---------
+    uint8_t data;
+    //---------
+    if((PIE1bits.TXIE == 0) || (PIR1bits.TXIF == 0))
+        return;
+    //---------
+    if(PacketTxNext != 0)                                       //!< Second byte of an escape sequence
+    {
+        TXREG = PacketTxNext;
+        PacketTxNext = 0;
+        return;
+    }
+    //---------
+    switch(PacketTxState)
+    {
+        case PACKET_TX_START:
+            TXREG = PACKET_END;                                 //!< Flushes the noise received by the other end
+            PacketTxState = PACKET_TX_DATA;
+            return;
+        case PACKET_TX_DATA:
+            if(PacketTxLen != 0)
+            {
+                data = *PacketTxData++;
+                --PacketTxLen;
+                PacketTxCrc = CRC16Update(PacketTxCrc, data);
+                break;
+            }
+            PacketTxState = PACKET_TX_CRC_MSB;
+            /* fall through */
+        case PACKET_TX_CRC_MSB:
+            data = (uint8_t)(PacketTxCrc >> 8);
+            PacketTxState = PACKET_TX_CRC_LSB;
+            break;
+        case PACKET_TX_CRC_LSB:
+            data = (uint8_t)PacketTxCrc;
+            PacketTxState = PACKET_TX_END;
+            break;
+        case PACKET_TX_END:
+            TXREG = PACKET_END;
+            PacketTxState = PACKET_TX_IDLE;
+            return;
+        default:
+            PIE1bits.TXIE = 0;                                  //!< Nothing to send, stop the interrupt until PacketSend()
+            return;
+    }
+    //---------
+    if(data == PACKET_END)
+    {
+        TXREG = PACKET_ESC;
+        PacketTxNext = PACKET_ESC_END;
+    }
+    else if(data == PACKET_ESC)
+    {
+        TXREG = PACKET_ESC;
+        PacketTxNext = PACKET_ESC_ESC;
+    }
+    else
+        TXREG = data;
+    //---------
+}
+//-----------------------------------
@@ -0,0 +1,202 @@
+/**
+ ******************************************************************************
+ * @file            Profile.c
+ * @author          Maxime
+ * @brief           Source file for PIC18 code sections profiler
+ * @brief           See Profile.h
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include <stddef.h>
+#include "../Inc/Profile.h"
+#include "../Inc/Interrupts.h"
+#include "../Inc/Format.h"
+//-----------------------------------
+
+#if defined(USE_PROFILE)
+
+//-----------------------------------
+#if (PROFILE_SECTIONS < 1) || (PROFILE_SECTIONS > 100)
+#error "PROFILE_SECTIONS must be from 1 to 100"
+#endif
+//-----------------------------------
+static ProfileSectionType ProfileSections[PROFILE_SECTIONS];
+static volatile uint16_t ProfileOverflows = 0;                  //!< Timer3 overflows, high word of the time
+static uint16_t ProfileOverhead = 0;                            //!< Cycles measured by an empty section
+//-----------------------------------
+#define PROFILE_CALIBRATION_RUNS    4                           //!< Empty sections measured by ProfileInit(), the shortest one is kept
+//-----------------------------------
+
+void ProfileInit(void)
+{
+    //---------
+    uint8_t i;
+    //---------
+#if defined(USE_INTERRUPT_DISPATCHER)
+    InterruptRegisterHandler(TMR3_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGH, ProfileCallBack);
+#endif
+    InterruptTimeBaseStart();                                   //!< Shared with the interrupt statistics, not cleared when they started it
+    PIE2bits.TMR3IE = 1;
+    INTCON |= 0xC0;
+    //---------
+    ProfileOverhead = 0;
+    ProfileClear();
+    for(i = 0; i < PROFILE_CALIBRATION_RUNS; ++i)               //!< Cost of PROFILE_BEGIN() + PROFILE_END() without code in between
+    {
+        PROFILE_BEGIN(0);
+        PROFILE_END(0);
+    }
+    ProfileOverhead = (uint16_t)ProfileSections[0].Min;         //!< An interrupt may lengthen some runs, not all
+    ProfileClear();
+    //---------
+}
+//-----------------------------------
+
+void ProfileClear(void)
+{
+    //---------
+    uint8_t i;
+    //---------
+    for(i = 0; i < PROFILE_SECTIONS; ++i)
+    {
+        ProfileSections[i].Total = 0;
+        ProfileSections[i].Min = 0xFFFFFFFFUL;
+        ProfileSections[i].Max = 0;
+        ProfileSections[i].Count = 0;
+    }
+    //---------
+}
+//-----------------------------------
+
+uint32_t ProfileTime(void)
+{
+    //---------
+    uint16_t t, ovf;
+    uint8_t gie = INTCONbits.GIE;
+    //---------
+    di();
+    t = TMR3L;                                                  //!< Reading TMR3L latches TMR3H
+    t |= (uint16_t)TMR3H << 8;
+    ovf = ProfileOverflows;
+    if(PIR2bits.TMR3IF)                                         //!< Overflow not accounted yet
+    {
+        t = TMR3L;                                              //!< Read again: the count may predate the overflow
+        t |= (uint16_t)TMR3H << 8;
+        ++ovf;
+    }
+    if(gie)
+        ei();
+    //---------
+    return ((uint32_t)ovf << 16) | t;
+}
+//-----------------------------------
+
+void ProfileBegin(uint8_t id)
+{
+    ProfileSections[id].Start = ProfileTime();
+}
+//-----------------------------------
+
+void ProfileEnd(uint8_t id)
+{
+    //---------
+    uint32_t duration = ProfileTime();
+    ProfileSectionType *section = &ProfileSections[id];
+    //---------
+    duration -= section->Start;
+    duration = duration > ProfileOverhead ? duration - ProfileOverhead : 0;
+    section->Total += duration;
+    if(duration < section->Min)
+        section->Min = duration;
+    if(duration > section->Max)
+        section->Max = duration;
+    if(section->Count != 0xFFFF)
+        ++section->Count;
+    //---------
+}
+//-----------------------------------
+
+uint8_t ProfileGetSection(uint8_t id, ProfileSectionType *section)
+{
+    //---------
+    if(id >= PROFILE_SECTIONS)
+        return 1;
+    //---------
+    *section = ProfileSections[id];
+    return 0;
+}
+//-----------------------------------
+
+/**
+ * @brief   Append " <label>=<decimal value>" to a string
+ * @retval  end of the string
+ *
+ */
+static char *ProfileField(char *str, const char *label, uint32_t value)
+{
+    //---------
+    *str++ = ' ';
+    while(*label)
+        *str++ = *label++;
+    *str++ = '=';
+    //---------
+    return FormatDec(str, value);
+}
+//-----------------------------------
+
+void ProfilePrint(void (*print)(const char *str), const char *const *names)
+{
+    //---------
+    char line[48];
+    ProfileSectionType section;
+    char *str;
+    uint8_t id;
+    //---------
+    for(id = 0; id < PROFILE_SECTIONS; ++id)
+    {
+        ProfileGetSection(id, &section);
+        if(section.Count == 0)
+            continue;
+        if(names != NULL)
+            print(names[id]);
+        str = line;
+        if(names == NULL)
+        {
+            if(id >= 10)
+                *str++ = (char)('0' + id / 10);
+            *str++ = (char)('0' + id % 10);
+        }
+        str = ProfileField(str, "n", section.Count);
+        str = ProfileField(str, "total", section.Total);
+        *str = '\0';
+        print(line);                                            //!< Printed in two parts
+        str = ProfileField(line, "min", section.Min);
+        str = ProfileField(str, "mean", section.Total / section.Count);
+        str = ProfileField(str, "max", section.Max);
+        *str++ = '\r';
+        *str = '\0';
+        print(line);
+    }
+    //---------
+}
+//-----------------------------------
+
+void ProfileCallBack(void)
+{
+    //---------
+    if(PIR2bits.TMR3IF == 0)
+        return;
+    //---------
+    PIR2bits.TMR3IF = 0;
+    ++ProfileOverflows;
+}
+//-----------------------------------
+
+#endif
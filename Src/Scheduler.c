@@ -0,0 +1,186 @@
+/**
+ ******************************************************************************
+ * @file            Scheduler.c
+ * @author          Maxime
+ * @brief           Source file for PIC18 cooperative task scheduler
+ * @brief           See Scheduler.h
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include "../Inc/Scheduler.h"
+//-----------------------------------
+
+//-----------------------------------
+static TaskType *SchedulerHead = NULL;                          //!< Run queue, first task to run
+static TaskType *SchedulerTail = NULL;                          //!< Run queue, last task to run
+static uint8_t SchedulerReady = 0;                              //!< Tasks in the run queue
+static TaskType *volatile SchedulerWakeList = NULL;             //!< SchedulerWake() requests, last first, only modified with the interrupts disabled
+//-----------------------------------
+
+/**
+ * @brief   Put a task at the end of the run queue
+ * @param   task: the task
+ *
+ */
+static void SchedulerEnqueue(TaskType *task)
+{
+    //---------
+    task->State = TASK_STATE_READY;
+    task->Next = NULL;
+    if(SchedulerTail != NULL)
+        SchedulerTail->Next = task;
+    else
+        SchedulerHead = task;
+    SchedulerTail = task;
+    ++SchedulerReady;
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   TASK_WAIT_MS() timer expiry, called by SoftTimerTask()
+ * @param   arg: the task
+ *
+ */
+static void SchedulerTimerHandler(void *arg)
+{
+    //---------
+    TaskType *task = (TaskType *)arg;
+    //---------
+    if(task->State == TASK_STATE_WAITING)
+        SchedulerEnqueue(task);
+}
+//-----------------------------------
+
+/**
+ * @brief   Put the tasks woken by SchedulerWake() back in the run queue
+ *
+ */
+static void SchedulerWakePending(void)
+{
+    //---------
+    uint8_t gie = INTCONbits.GIE;
+    TaskType *task, *next;
+    //---------
+    di();
+    task = SchedulerWakeList;
+    SchedulerWakeList = NULL;
+    if(gie)
+        ei();
+    //---------
+    while(task != NULL)                                         //!< Requests made while the task ran apply to the wait it returned with
+    {
+        next = task->WakeNext;                                  //!< Read first: a new request reuses WakeNext
+        task->WakePending = 0;
+        if(task->State == TASK_STATE_WAITING)
+        {
+            SoftTimerStop(&task->Timer);
+            SchedulerEnqueue(task);
+        }
+        task = next;
+    }
+    //---------
+}
+//-----------------------------------
+
+void SchedulerInit(void)
+{
+    //---------
+    SchedulerHead = NULL;
+    SchedulerTail = NULL;
+    SchedulerReady = 0;
+    SchedulerWakeList = NULL;
+    //---------
+}
+//-----------------------------------
+
+void SchedulerAddTask(TaskType *task, TaskFunctionType function)
+{
+    //---------
+    task->Function = function;
+    task->Resume = 0;
+    task->Timer.Handler = NULL;
+    task->WakePending = 0;
+    SchedulerEnqueue(task);
+    //---------
+}
+//-----------------------------------
+
+void SchedulerWake(TaskType *task)
+{
+    //---------
+    uint8_t gie = INTCONbits.GIE;
+    //---------
+    di();
+    if(task->WakePending == 0)                                  //!< The state is not checked here: the task may be about to wait
+    {
+        task->WakePending = 1;
+        task->WakeNext = SchedulerWakeList;
+        SchedulerWakeList = task;
+    }
+    if(gie)
+        ei();
+    //---------
+}
+//-----------------------------------
+
+void SchedulerSleep(TaskType *task, uint16_t ms)
+{
+    SoftTimerStart(&task->Timer, (uint16_t)(((uint32_t)ms + (SOFTTIMER_TICK_MS - 1)) / SOFTTIMER_TICK_MS), 0, SchedulerTimerHandler, task);
+}
+//-----------------------------------
+
+uint8_t SchedulerStep(void)
+{
+    //---------
+    uint8_t i, cnt;
+    TaskType *task;
+    //---------
+    SoftTimerTask();
+    if(SchedulerWakeList != NULL)
+        SchedulerWakePending();
+    cnt = SchedulerReady;                                       //!< Tasks made ready by this turn run on the next one
+    for(i = 0; i < cnt; ++i)
+    {
+        task = SchedulerHead;
+        SchedulerHead = task->Next;
+        if(SchedulerHead == NULL)
+            SchedulerTail = NULL;
+        --SchedulerReady;
+        //---------
+        switch(task->Function(task))
+        {
+            case TASK_YIELDED:
+                SchedulerEnqueue(task);
+                break;
+            case TASK_WAITING:
+                task->State = TASK_STATE_WAITING;
+                break;
+            default:
+                SoftTimerStop(&task->Timer);
+                task->State = TASK_STATE_ENDED;
+                break;
+        }
+    }
+    //---------
+    return cnt;
+}
+//-----------------------------------
+
+void SchedulerRun(void)
+{
+    while(1)
+    {
+        if(SchedulerStep() == 0)                                //!< Every task sleeps: idle until the next interrupt
+            SysTimeIdle();
+    }
+}
+//-----------------------------------
+
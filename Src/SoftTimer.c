@@ -0,0 +1,163 @@
+/**
+ ******************************************************************************
+ * @file            SoftTimer.c
+ * @author          Maxime
+ * @brief           Source file for PIC18 software timers library
+ * @brief           See SoftTimer.h
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include "../Inc/SoftTimer.h"
+//-----------------------------------
+
+//-----------------------------------
+#if (SOFTTIMER_WHEEL_SIZE < 2) || (SOFTTIMER_WHEEL_SIZE > 128) || (SOFTTIMER_WHEEL_SIZE & (SOFTTIMER_WHEEL_SIZE - 1))
+#error "SOFTTIMER_WHEEL_SIZE must be a power of 2 from 2 to 128"
+#endif
+#if (SOFTTIMER_TICK_MS < 1)
+#error "SOFTTIMER_TICK_MS must be 1 or more"
+#endif
+//-----------------------------------
+#define SOFTTIMER_SLOT_MASK                         (SOFTTIMER_WHEEL_SIZE - 1)
+//-----------------------------------
+static SoftTimerType *SoftTimerWheel[SOFTTIMER_WHEEL_SIZE];     //!< First timer of every slot
+static SoftTimerType *SoftTimerCursor = NULL;                   //!< Next timer to visit in the slot being processed
+static uint32_t SoftTimerLast = 0;                              //!< Tick_ms() of the last processed tick
+static uint16_t SoftTimerCount = 0;                             //!< Running timers
+static uint8_t SoftTimerNow = 0;                                //!< Slot of the last processed tick
+//-----------------------------------
+
+/**
+ * @brief   Link a timer in the slot of its expiry
+ * @param   timer: the timer
+ * @param   ticks: ticks from now to the expiry, 1 or more
+ *
+ */
+static void SoftTimerLink(SoftTimerType *timer, uint16_t ticks)
+{
+    //---------
+    uint8_t slot = (uint8_t)(SoftTimerNow + (uint8_t)ticks) & SOFTTIMER_SLOT_MASK;
+    //---------
+    timer->Rounds = (uint16_t)(ticks - 1) / SOFTTIMER_WHEEL_SIZE;  //!< The current slot is visited again after SOFTTIMER_WHEEL_SIZE ticks
+    timer->Slot = slot;
+    timer->Prev = NULL;
+    timer->Next = SoftTimerWheel[slot];                         //!< First of the slot: not visited again if it is being processed
+    if(timer->Next != NULL)
+        timer->Next->Prev = timer;
+    SoftTimerWheel[slot] = timer;
+}
+//-----------------------------------
+
+/**
+ * @brief   Unlink a timer from its slot
+ * @param   timer: the timer
+ *
+ */
+static void SoftTimerUnlink(SoftTimerType *timer)
+{
+    //---------
+    if(timer == SoftTimerCursor)                                //!< Stopped from a handler of the same slot
+        SoftTimerCursor = timer->Next;
+    if(timer->Prev != NULL)
+        timer->Prev->Next = timer->Next;
+    else
+        SoftTimerWheel[timer->Slot] = timer->Next;
+    if(timer->Next != NULL)
+        timer->Next->Prev = timer->Prev;
+    //---------
+}
+//-----------------------------------
+
+void SoftTimerInit(void)
+{
+    //---------
+    uint8_t i;
+    //---------
+    for(i = 0; i < SOFTTIMER_WHEEL_SIZE; ++i)
+        SoftTimerWheel[i] = NULL;
+    SoftTimerCursor = NULL;
+    SoftTimerCount = 0;
+    SoftTimerNow = 0;
+    SoftTimerLast = Tick_ms();
+    //---------
+}
+//-----------------------------------
+
+void SoftTimerStart(SoftTimerType *timer, uint16_t timeout, uint16_t period, SoftTimerHandlerType handler, void *arg)
+{
+    //---------
+    if(timer->Handler != NULL)
+        SoftTimerUnlink(timer);
+    else
+        ++SoftTimerCount;
+    //---------
+    timer->Handler = handler;
+    timer->Arg = arg;
+    timer->Period = period;
+    SoftTimerLink(timer, timeout ? timeout : 1);
+}
+//-----------------------------------
+
+void SoftTimerStop(SoftTimerType *timer)
+{
+    //---------
+    if(timer->Handler == NULL)
+        return;
+    //---------
+    SoftTimerUnlink(timer);
+    timer->Handler = NULL;
+    --SoftTimerCount;
+}
+//-----------------------------------
+
+void SoftTimerTask(void)
+{
+    //---------
+    uint32_t now = Tick_ms();
+    SoftTimerType *timer;
+    SoftTimerHandlerType handler;
+    //---------
+    if(SoftTimerCount == 0)                                     //!< Nothing to expire: skip the elapsed ticks
+    {
+        SoftTimerLast = now - (now - SoftTimerLast) % SOFTTIMER_TICK_MS;
+        return;
+    }
+    //---------
+    while((now - SoftTimerLast) >= SOFTTIMER_TICK_MS)
+    {
+        SoftTimerLast += SOFTTIMER_TICK_MS;
+        SoftTimerNow = (SoftTimerNow + 1) & SOFTTIMER_SLOT_MASK;
+        SoftTimerCursor = SoftTimerWheel[SoftTimerNow];
+        while(SoftTimerCursor != NULL)
+        {
+            timer = SoftTimerCursor;
+            SoftTimerCursor = timer->Next;
+            if(timer->Rounds)
+            {
+                --timer->Rounds;
+                continue;
+            }
+            //---------
+            handler = timer->Handler;
+            SoftTimerUnlink(timer);
+            if(timer->Period)
+                SoftTimerLink(timer, timer->Period);            //!< Relative to the expiry tick: no drift
+            else
+            {
+                timer->Handler = NULL;
+                --SoftTimerCount;
+            }
+            handler(timer->Arg);
+        }
+    }
+    //---------
+}
+//-----------------------------------
+
@@ -0,0 +1,763 @@
+/**
+ ******************************************************************************
+ * @file            SoftwareUART.c
+ * @author          Maxime
+ * @brief           Source file for PIC18 UART bit banging library
+ * @brief           See SoftwareUART.h
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include <stddef.h>
+#include "../Inc/SoftwareUART.h"
+#include "../Inc/SystemTime.h"
+#include "../Inc/Interrupts.h"
+//-----------------------------------
+
+//-----------------------------------
+#if (SUART_RX_BUFFER_SIZE < 2) || (SUART_RX_BUFFER_SIZE > 128) || ((SUART_RX_BUFFER_SIZE & SUART_RX_BUFFER_MASK) != 0)
+#error "SUART_RX_BUFFER_SIZE must be a power of two, from 2 to 128"
+#endif
+#if (SUART_TX_BUFFER_SIZE < 2) || (SUART_TX_BUFFER_SIZE > 128) || ((SUART_TX_BUFFER_SIZE & SUART_TX_BUFFER_MASK) != 0)
+#error "SUART_TX_BUFFER_SIZE must be a power of two, from 2 to 128"
+#endif
+#if (SUART_TX_PIN < 0) || (SUART_TX_PIN > 7)
+#error "SUART_TX_PIN must be from 0 to 7"
+#endif
+#if (SUART_MODE != SUART_MODE_DELAY) && (SUART_MODE != SUART_MODE_COMPARE) && (SUART_MODE != SUART_MODE_TICK)
+#error "SUART_MODE must be SUART_MODE_DELAY, SUART_MODE_COMPARE or SUART_MODE_TICK"
+#endif
+#if (SUART_OVERSAMPLE != 3) && (SUART_OVERSAMPLE != 4)
+#error "SUART_OVERSAMPLE must be 3 or 4"
+#endif
+#if (SUART_CHANNELS < 1) || (SUART_CHANNELS > 4)
+#error "SUART_CHANNELS must be from 1 to 4"
+#endif
+#if (SUART_CHANNELS > 1) && (SUART_MODE != SUART_MODE_TICK)
+#error "Several channels require SUART_MODE_TICK"
+#endif
+#if (SUART_MODE == SUART_MODE_COMPARE) && (SYSTIME_IDLE == SYSTIME_IDLE_T1OSC)
+#error "SUART_MODE_COMPARE uses Timer1, so does SYSTIME_IDLE_T1OSC"
+#endif
+//-----------------------------------
+/**
+ * @brief   Build time timing check: a negative array size error here means that SUART_BAUD
+ *          cannot be generated from FOSC_MHZ (See SUART_TIMING in SoftwareUART.h and "make suart-check").
+ */
+#if (SUART_MODE == SUART_MODE_COMPARE)
+typedef char SoftUARTTimingCheckType[SUART_CMP_VALID_OF(FOSC_MHZ, SUART_BAUD) ? 1 : -1];
+#elif (SUART_MODE == SUART_MODE_TICK)
+typedef char SoftUARTTimingCheckType[SUART_TICK_VALID_OF(FOSC_MHZ, SUART_BAUD) ? 1 : -1];
+#else
+typedef char SoftUARTTimingCheckType[SUART_VALID_OF(FOSC_MHZ, SUART_BAUD) ? 1 : -1];
+#endif
+//-----------------------------------
+#if (SUART_MODE == SUART_MODE_TICK)
+/**
+ * @brief   I/O ports used by the channels, one bit per port (See IO_PORT_CONSTANTS in PIC18Types.h)
+ *
+ */
+#define SUART_CH_PORT(ch, port)     ((SUART_CHANNELS > (ch)) ? (1 << (port)) : 0)
+#define SUART_RX_PORTS              (SUART_CH_PORT(0, SUART_CH0_RX_PORT) | SUART_CH_PORT(1, SUART_CH1_RX_PORT) \
+                                        | SUART_CH_PORT(2, SUART_CH2_RX_PORT) | SUART_CH_PORT(3, SUART_CH3_RX_PORT))
+#define SUART_TX_PORTS              (SUART_CH_PORT(0, SUART_CH0_TX_PORT) | SUART_CH_PORT(1, SUART_CH1_TX_PORT) \
+                                        | SUART_CH_PORT(2, SUART_CH2_TX_PORT) | SUART_CH_PORT(3, SUART_CH3_TX_PORT))
+#define SUART_PORT_COUNT            5
+//---------
+#define SUART_PORT_IN(port)         if(SUART_RX_PORTS & (1 << (port))) in[port] = GPIOReadPort(port)
+#define SUART_LATCH_IN(port)        if(SUART_TX_PORTS & (1 << (port))) out[port] = GPIO.Bytes[(port) + IO_LATCH_OFFSET]
+#define SUART_LATCH_OUT(port)       if(SUART_TX_PORTS & (1 << (port))) GPIOWritePort(port, out[port])
+#else
+#if (SUART_RX_INT == 0)
+#define SUART_RX_PIN                0
+#define SUART_RX_INT_FLAG           INT0_INT_FLAG
+#define SUART_RX_IF                 INTCONbits.INT0IF
+#define SUART_RX_IE                 INTCONbits.INT0IE
+#define SUART_RX_EDGE               INTCON2bits.INTEDG0
+#elif (SUART_RX_INT == 1)
+#define SUART_RX_PIN                1
+#define SUART_RX_INT_FLAG           INT1_INT_FLAG
+#define SUART_RX_IF                 INTCON3bits.INT1IF
+#define SUART_RX_IE                 INTCON3bits.INT1IE
+#define SUART_RX_EDGE               INTCON2bits.INTEDG1
+#elif (SUART_RX_INT == 2)
+#define SUART_RX_PIN                2
+#define SUART_RX_INT_FLAG           INT2_INT_FLAG
+#define SUART_RX_IF                 INTCON3bits.INT2IF
+#define SUART_RX_IE                 INTCON3bits.INT2IE
+#define SUART_RX_EDGE               INTCON2bits.INTEDG2
+#else
+#error "SUART_RX_INT must be 0, 1 or 2"
+#endif
+//---------
+#define SUART_TX_HIGH()             GPIOSetPin(SUART_TX_PORT, SUART_TX_PIN)
+#define SUART_TX_LOW()              GPIOClearPin(SUART_TX_PORT, SUART_TX_PIN)
+#define SUART_RX_READ()             GPIOGetPin(GPIOB, SUART_RX_PIN)
+#endif
+//-----------------------------------
+
+/**
+ * @brief   Channel state
+ *
+ */
+typedef struct
+{
+    volatile uint8_t RxBuf[SUART_RX_BUFFER_SIZE];               //!< Receive ring buffer
+    volatile uint8_t RxHead;                                    //!< Free running write index, only modified by the interrupt
+    volatile uint8_t RxTail;                                    //!< Free running read index, only modified by the application
+    volatile SoftUARTStatusType Status;
+#if (SUART_MODE != SUART_MODE_DELAY)
+    volatile uint8_t TxBuf[SUART_TX_BUFFER_SIZE];               //!< Transmit queue
+    volatile uint8_t TxHead;                                    //!< Free running write index, only modified by the application
+    volatile uint8_t TxTail;                                    //!< Free running read index, only modified by the interrupt
+    uint16_t TxFrame;                                           //!< Bits left to send, LSB first, stop bit included
+    uint8_t RxData;                                             //!< Byte being received
+    uint8_t RxBits;                                             //!< Bits left to sample, stop bit included
+#endif
+#if (SUART_MODE == SUART_MODE_TICK)
+    uint8_t TxTicks;                                            //!< Ticks left in the bit being sent
+    uint8_t RxTicks;                                            //!< Ticks left to the next sample
+    volatile uint8_t RxOn;                                      //!< Start bit detection enabled (See SoftUARTChSuspend())
+#endif
+}SoftUARTChannelType;
+//-----------------------------------
+static SoftUARTChannelType SoftUARTCh[SUART_CHANNELS];
+static SoftUARTRxHookType SoftUARTRxHook = NULL;                //!< See SoftUARTSetRxHook()
+//-----------------------------------
+#if (SUART_MODE == SUART_MODE_TICK)
+/**
+ * @brief   Channel pins: port (See IO_PORT_CONSTANTS in PIC18Types.h) and pin mask
+ *
+ */
+typedef struct
+{
+    uint8_t TxPort;
+    uint8_t TxMask;
+    uint8_t RxPort;
+    uint8_t RxMask;
+}SoftUARTPinsType;
+//-----------------------------------
+static const SoftUARTPinsType SoftUARTPins[SUART_CHANNELS] =
+{
+    { SUART_CH0_TX_PORT, 1 << SUART_CH0_TX_PIN, SUART_CH0_RX_PORT, 1 << SUART_CH0_RX_PIN },
+#if (SUART_CHANNELS > 1)
+    { SUART_CH1_TX_PORT, 1 << SUART_CH1_TX_PIN, SUART_CH1_RX_PORT, 1 << SUART_CH1_RX_PIN },
+#endif
+#if (SUART_CHANNELS > 2)
+    { SUART_CH2_TX_PORT, 1 << SUART_CH2_TX_PIN, SUART_CH2_RX_PORT, 1 << SUART_CH2_RX_PIN },
+#endif
+#if (SUART_CHANNELS > 3)
+    { SUART_CH3_TX_PORT, 1 << SUART_CH3_TX_PIN, SUART_CH3_RX_PORT, 1 << SUART_CH3_RX_PIN },
+#endif
+};
+//-----------------------------------
+static void SoftUARTTickHandler(void);
+#elif (SUART_MODE == SUART_MODE_COMPARE)
+static void SoftUARTStartHandler(void);
+static void SoftUARTTxHandler(void);
+static void SoftUARTRxHandler(void);
+#endif
+#if (SUART_MODE != SUART_MODE_DELAY)
+static void SoftUARTRxComplete(SoftUARTChannelType *ch, uint8_t stop);
+#endif
+//-----------------------------------
+
+void SoftUARTInit(void)
+{
+    //---------
+    uint8_t i;
+#if (SUART_MODE == SUART_MODE_TICK)
+    const SoftUARTPinsType *pins = SoftUARTPins;
+#endif
+    SoftUARTChannelType *ch = SoftUARTCh;
+    //---------
+    for(i = 0; i < SUART_CHANNELS; ++i, ++ch)
+    {
+        ch->RxTail = ch->RxHead;
+        ch->Status.Byte = 0;
+#if (SUART_MODE != SUART_MODE_DELAY)
+        ch->TxTail = ch->TxHead;
+        ch->TxFrame = 0;
+        ch->RxBits = 0;
+#endif
+#if (SUART_MODE == SUART_MODE_TICK)
+        ch->TxTicks = 1;
+        ch->RxOn = 1;
+        GPIO.Bytes[pins->TxPort + IO_LATCH_OFFSET] |= pins->TxMask;   //!< Idle line
+        GPIO.Bytes[pins->TxPort + IO_TRIS_OFFSET] &= (uint8_t)~pins->TxMask;
+        GPIO.Bytes[pins->RxPort + IO_TRIS_OFFSET] |= pins->RxMask;
+        ++pins;
+#endif
+    }
+    //---------
+#if (SUART_MODE == SUART_MODE_TICK)
+    T2CON = 0x00;
+    TMR2 = 0;
+    PR2 = SUART_TICK_PR2;
+    T2CON = SUART_TICK_T2CON;                                   //!< SUART_OVERSAMPLE ticks per bit
+#if defined(USE_INTERRUPT_DISPATCHER)
+    InterruptRegisterHandler(TMR2_PR2_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGHEST, SoftUARTTickHandler);
+#endif
+    PIR1bits.TMR2IF = 0;
+    PIE1bits.TMR2IE = 1;
+#else
+    SUART_TX_HIGH();                                            //!< Idle line
+    GPIOSetOutput(SUART_TX_PORT, SUART_TX_PIN);
+    GPIOSetInput(GPIOB, SUART_RX_PIN);
+#if (SUART_MODE == SUART_MODE_COMPARE)
+    T1CON = 0x81;                                               //!< Timer1 free running on FOSC/4, 16 bits read/write
+    CCP1CON = 0x0A;                                             //!< Compare, software interrupt only: transmission bits
+    CCP2CON = 0x0A;                                             //!< Compare, software interrupt only: reception bits
+    T3CONbits.T3CCP2 = 0;                                       //!< CCP1 and CCP2 use Timer1
+    T3CONbits.T3CCP1 = 0;
+    PIE1bits.CCP1IE = 0;
+    PIE2bits.CCP2IE = 0;
+#if defined(USE_INTERRUPT_DISPATCHER)
+    InterruptRegisterHandler(SUART_RX_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGHEST, SoftUARTStartHandler);
+    InterruptRegisterHandler(CCP2_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGHEST, SoftUARTRxHandler);
+    InterruptRegisterHandler(CCP1_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGHEST, SoftUARTTxHandler);
+#endif
+#elif defined(USE_INTERRUPT_DISPATCHER)
+    InterruptRegisterHandler(SUART_RX_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGH, SoftUARTCallBack);
+#endif
+    SUART_RX_EDGE = 0;                                          //!< Start bit: falling edge
+    SUART_RX_IF = 0;
+    SUART_RX_IE = 1;
+#endif
+    INTCONbits.PEIE = 1;
+    ei();
+    //---------
+}
+//-----------------------------------
+
+void SoftUARTSetRxHook(SoftUARTRxHookType hook)
+{
+    //---------
+    uint8_t gie = INTCONbits.GIE;
+    //---------
+    di();
+    SoftUARTRxHook = hook;
+    if(gie)
+        ei();
+    //---------
+}
+//-----------------------------------
+
+uint8_t SoftUARTChRxAvailable(uint8_t ch)
+{
+    return (uint8_t)(SoftUARTCh[ch].RxHead != SoftUARTCh[ch].RxTail);
+}
+//-----------------------------------
+
+#if (SUART_MODE == SUART_MODE_DELAY)
+
+void SoftUARTChTransmitByte(uint8_t ch, uint8_t data)
+{
+    //---------
+    uint8_t i;
+    uint8_t gie = INTCONbits.GIE;
+    //---------
+    (void)ch;
+    di();                                                       //!< The bit timing must not be stretched by interrupts
+    SUART_TX_LOW();                                             //!< Start bit
+    _delay(SUART_TX_START_DELAY);
+    for(i = 8; i != 0; --i)
+    {
+        if(data & 0x01)                                         //!< Both tests are always executed, so that
+            SUART_TX_HIGH();                                    //!< the loop costs the same for 0 and 1 bits
+        if(!(data & 0x01))
+            SUART_TX_LOW();
+        data >>= 1;
+        _delay(SUART_TX_BIT_DELAY);
+    }
+    SUART_TX_HIGH();                                            //!< Stop bit
+    _delay(SUART_TX_BIT_DELAY);
+    if(gie)
+        ei();
+    //---------
+}
+//-----------------------------------
+
+#else
+
+void SoftUARTChTransmitByte(uint8_t ch, uint8_t data)
+{
+    //---------
+    SoftUARTChannelType *p = &SoftUARTCh[ch];
+    uint8_t head = p->TxHead;
+    //---------
+    while((uint8_t)(head - p->TxTail) >= SUART_TX_BUFFER_SIZE)
+    {
+        if(INTCONbits.GIE == 0)
+            SoftUARTCallBack();                                 //!< Nobody else can drain the queue
+    }
+    p->TxBuf[head & SUART_TX_BUFFER_MASK] = data;
+    p->TxHead = (uint8_t)(head + 1);
+    //---------
+#if (SUART_MODE == SUART_MODE_COMPARE)
+    if(PIE1bits.CCP1IE == 0)                                    //!< Transmitter idle: first bit in a few cycles
+    {
+        CCPR1 = (uint16_t)(TMR1 + SUART_CMP_ISR_CYCLES);
+        PIR1bits.CCP1IF = 0;
+        PIE1bits.CCP1IE = 1;
+    }
+#endif
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Store the received byte, or raise the frame error/buffer overflow flag
+ * @param   ch: channel
+ * @param   stop: level sampled in the middle of the stop bit
+ *
+ */
+static void SoftUARTRxComplete(SoftUARTChannelType *ch, uint8_t stop)
+{
+    //---------
+    uint8_t head;
+    //---------
+    if(stop == 0)
+    {
+        ch->Status.Ferr = 1;
+        return;
+    }
+    head = ch->RxHead;
+    if((uint8_t)(head - ch->RxTail) >= SUART_RX_BUFFER_SIZE)
+    {
+        ch->Status.Buf = 1;
+        return;
+    }
+    ch->RxBuf[head & SUART_RX_BUFFER_MASK] = ch->RxData;
+    ch->RxHead = (uint8_t)(head + 1);
+    if(SoftUARTRxHook != NULL)
+        SoftUARTRxHook((uint8_t)(ch - SoftUARTCh));
+    //---------
+}
+//-----------------------------------
+
+#if (SUART_MODE == SUART_MODE_COMPARE)
+
+/**
+ * @brief   Transmission bit interrupt: CCP1 compare
+ *
+ */
+static void SoftUARTTxHandler(void)
+{
+    //---------
+    uint8_t tail;
+    //---------
+    if(PIR1bits.CCP1IF == 0)
+        return;
+    PIR1bits.CCP1IF = 0;
+    CCPR1 += SUART_BIT_CYCLES;                                  //!< Next bit edge, relative to this one: no drift
+    //---------
+    if(SoftUARTCh[0].TxFrame == 0)                              //!< Previous stop bit sent
+    {
+        tail = SoftUARTCh[0].TxTail;
+        if(tail == SoftUARTCh[0].TxHead)
+        {
+            PIE1bits.CCP1IE = 0;
+            return;
+        }
+        SoftUARTCh[0].TxFrame = (uint16_t)(((uint16_t)SoftUARTCh[0].TxBuf[tail & SUART_TX_BUFFER_MASK] << 1) | 0x0200);   //!< Start bit, data, stop bit
+        SoftUARTCh[0].TxTail = (uint8_t)(tail + 1);
+    }
+    if(SoftUARTCh[0].TxFrame & 0x01)
+        SUART_TX_HIGH();
+    else
+        SUART_TX_LOW();
+    SoftUARTCh[0].TxFrame >>= 1;
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Reception start bit interrupt: INTx falling edge
+ *
+ */
+static void SoftUARTStartHandler(void)
+{
+    //---------
+    CCPR2 = (uint16_t)(TMR1 + SUART_CMP_RX_START);             //!< Middle of the first data bit
+    SUART_RX_IE = 0;                                            //!< Data bits edges are not start bits
+    SUART_RX_IF = 0;
+    SoftUARTCh[0].RxBits = 9;
+    PIR2bits.CCP2IF = 0;
+    PIE2bits.CCP2IE = 1;
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Reception bit interrupt: CCP2 compare
+ *
+ */
+static void SoftUARTRxHandler(void)
+{
+    //---------
+    PIR2bits.CCP2IF = 0;
+    CCPR2 += SUART_BIT_CYCLES;
+    if(--SoftUARTCh[0].RxBits != 0)
+    {
+        SoftUARTCh[0].RxData >>= 1;
+        if(SUART_RX_READ())
+            SoftUARTCh[0].RxData |= 0x80;
+        return;
+    }
+    //---------
+    PIE2bits.CCP2IE = 0;                                        //!< Stop bit
+    SoftUARTRxComplete(&SoftUARTCh[0], SUART_RX_READ());
+    SUART_RX_IF = 0;
+    SUART_RX_IE = 1;                                            //!< Wait for the next start bit
+    //---------
+}
+//-----------------------------------
+
+#else
+
+/**
+ * @brief   Tick interrupt: Timer2 to PR2 match, SUART_OVERSAMPLE times per bit
+ * @note    Transmission and reception run side by side: a transmitted bit lasts SUART_OVERSAMPLE
+ *          ticks, the start bit is detected on the first low sample, and the bits are then
+ *          sampled every SUART_OVERSAMPLE ticks from SUART_TICK_RX_FIRST ticks after the detection.
+ * @note    The ports are read once and the transmission latches written once per tick, whatever
+ *          the number of channels sharing them.
+ *
+ */
+static void SoftUARTTickHandler(void)
+{
+    //---------
+    uint8_t in[SUART_PORT_COUNT], out[SUART_PORT_COUNT];
+    uint8_t i, tail, rx;
+    SoftUARTChannelType *ch = SoftUARTCh;
+    const SoftUARTPinsType *pins = SoftUARTPins;
+    //---------
+    if(PIR1bits.TMR2IF == 0)
+        return;
+    PIR1bits.TMR2IF = 0;
+    SUART_PORT_IN(GPIOA);                                       //!< Sampled first: constant delay from the tick
+    SUART_PORT_IN(GPIOB);
+    SUART_PORT_IN(GPIOC);
+    SUART_PORT_IN(GPIOD);
+    SUART_PORT_IN(GPIOE);
+    SUART_LATCH_IN(GPIOA);
+    SUART_LATCH_IN(GPIOB);
+    SUART_LATCH_IN(GPIOC);
+    SUART_LATCH_IN(GPIOD);
+    SUART_LATCH_IN(GPIOE);
+    //---------
+    for(i = SUART_CHANNELS; i != 0; --i, ++ch, ++pins)
+    {
+        if(--ch->TxTicks == 0)
+        {
+            ch->TxTicks = SUART_OVERSAMPLE;
+            if(ch->TxFrame == 0)                                //!< Previous stop bit sent
+            {
+                tail = ch->TxTail;
+                if(tail != ch->TxHead)
+                {
+                    ch->TxFrame = (uint16_t)(((uint16_t)ch->TxBuf[tail & SUART_TX_BUFFER_MASK] << 1) | 0x0200);   //!< Start bit, data, stop bit
+                    ch->TxTail = (uint8_t)(tail + 1);
+                }
+            }
+            if(ch->TxFrame != 0)
+            {
+                if(ch->TxFrame & 0x01)
+                    out[pins->TxPort] |= pins->TxMask;
+                else
+                    out[pins->TxPort] &= (uint8_t)~pins->TxMask;
+                ch->TxFrame >>= 1;
+            }
+        }
+        //---------
+        rx = in[pins->RxPort] & pins->RxMask;
+        if(ch->RxBits == 0)                                     //!< Waiting for a start bit
+        {
+            if((rx == 0) && ch->RxOn)
+            {
+                ch->RxBits = 9;
+                ch->RxTicks = SUART_TICK_RX_FIRST;
+            }
+        }
+        else if(--ch->RxTicks == 0)
+        {
+            ch->RxTicks = SUART_OVERSAMPLE;
+            if(--ch->RxBits != 0)
+            {
+                ch->RxData >>= 1;
+                if(rx)
+                    ch->RxData |= 0x80;
+            }
+            else
+            {
+                SoftUARTRxComplete(ch, rx);                     //!< Stop bit
+            }
+        }
+    }
+    //---------
+    SUART_LATCH_OUT(GPIOA);                                     //!< One write per transmission port
+    SUART_LATCH_OUT(GPIOB);
+    SUART_LATCH_OUT(GPIOC);
+    SUART_LATCH_OUT(GPIOD);
+    SUART_LATCH_OUT(GPIOE);
+    //---------
+}
+//-----------------------------------
+
+#endif
+
+#endif
+
+int SoftUARTChReceiveByte(uint8_t ch)
+{
+    //---------
+    SoftUARTChannelType *p = &SoftUARTCh[ch];
+    uint8_t tail = p->RxTail;
+    int data;
+    //---------
+    if(tail == p->RxHead)
+        return -1;
+    data = p->RxBuf[tail & SUART_RX_BUFFER_MASK];
+    p->RxTail = (uint8_t)(tail + 1);
+    //---------
+    return data;
+}
+//-----------------------------------
+
+void SoftUARTChTransmitBytes(uint8_t ch, uint8_t *data, uint16_t cnt)
+{
+    //---------
+    while(cnt != 0)
+    {
+        SoftUARTChTransmitByte(ch, *data);
+        ++data;
+        --cnt;
+    }
+    //---------
+}
+//-----------------------------------
+
+uint16_t SoftUARTChReceiveBytes(uint8_t ch, uint8_t *data, uint16_t cnt, uint32_t tout)
+{
+    //---------
+    uint16_t j = 0;
+    int c;
+    uint32_t time = Tick_ms();
+    //---------
+    while(cnt != 0)
+    {
+        c = SoftUARTChReceiveByte(ch);
+        if(c >= 0)
+        {
+            *data = (uint8_t)c;
+            ++data;
+            ++j;
+            --cnt;
+            continue;                                           //!< Drain the buffer before checking the time-out
+        }
+        if((Tick_ms() - time) >= tout)
+            break;
+    }
+    //---------
+    return j;
+}
+//-----------------------------------
+
+void SoftUARTChPrint(uint8_t ch, const char *str)
+{
+    //---------
+    while(*str != '\0')
+    {
+        SoftUARTChTransmitByte(ch, (uint8_t)*str);
+        ++str;
+    }
+    //---------
+}
+//-----------------------------------
+
+SoftUARTStatusType SoftUARTChGetStatus(uint8_t ch)
+{
+    //---------
+    SoftUARTStatusType status;
+    uint8_t gie = INTCONbits.GIE;
+    //---------
+    di();
+    status.Byte = SoftUARTCh[ch].Status.Byte;
+    SoftUARTCh[ch].Status.Byte = 0;
+    if(gie)
+        ei();
+    //---------
+    return status;
+}
+//-----------------------------------
+
+void SoftUARTChSuspend(uint8_t ch)
+{
+#if (SUART_MODE == SUART_MODE_TICK)
+    SoftUARTCh[ch].RxOn = 0;                                    //!< Byte being received is completed
+#else
+    (void)ch;
+    SUART_RX_IE = 0;
+#endif
+#if (SUART_MODE == SUART_MODE_COMPARE)
+    PIE2bits.CCP2IE = 0;                                        //!< Byte being received is dropped
+#endif
+}
+//-----------------------------------
+
+void SoftUARTChResume(uint8_t ch)
+{
+#if (SUART_MODE == SUART_MODE_TICK)
+    SoftUARTCh[ch].RxOn = 1;
+#else
+    (void)ch;
+    SUART_RX_IF = 0;                                            //!< Ignore the edges seen while suspended
+    SUART_RX_IE = 1;
+#endif
+}
+//-----------------------------------
+
+void SoftUARTChFlushRx(uint8_t ch)
+{
+    SoftUARTCh[ch].RxTail = SoftUARTCh[ch].RxHead;
+}
+//-----------------------------------
+
+uint8_t SoftUARTRxAvailable(void)
+{
+    return SoftUARTChRxAvailable(0);
+}
+//-----------------------------------
+
+void SoftUARTTransmitByte(uint8_t data)
+{
+    SoftUARTChTransmitByte(0, data);
+}
+//-----------------------------------
+
+int SoftUARTReceiveByte(void)
+{
+    return SoftUARTChReceiveByte(0);
+}
+//-----------------------------------
+
+void SoftUARTTransmitBytes(uint8_t *data, uint16_t cnt)
+{
+    SoftUARTChTransmitBytes(0, data, cnt);
+}
+//-----------------------------------
+
+uint16_t SoftUARTReceiveBytes(uint8_t *data, uint16_t cnt, uint32_t tout)
+{
+    return SoftUARTChReceiveBytes(0, data, cnt, tout);
+}
+//-----------------------------------
+
+void SoftUARTPrint(const char *str)
+{
+    SoftUARTChPrint(0, str);
+}
+//-----------------------------------
+
+SoftUARTStatusType SoftUARTGetStatus(void)
+{
+    return SoftUARTChGetStatus(0);
+}
+//-----------------------------------
+
+void SoftUARTSuspend(void)
+{
+    SoftUARTChSuspend(0);
+}
+//-----------------------------------
+
+void SoftUARTResume(void)
+{
+    SoftUARTChResume(0);
+}
+//-----------------------------------
+
+void SoftUARTFlushRx(void)
+{
+    SoftUARTChFlushRx(0);
+}
+//-----------------------------------
+
+#if (SUART_MODE == SUART_MODE_DELAY)
+
+void SoftUARTCallBack(void)
+{
+    //---------
+    uint8_t i, data = 0, head, stop;
+    //---------
+    if((SUART_RX_IE == 0) || (SUART_RX_IF == 0))
+        return;
+    //---------
+    _delay(SUART_RX_START_DELAY);                               //!< Middle of the first data bit
+    for(i = 8; i != 0; --i)
+    {
+        data >>= 1;
+        if(SUART_RX_READ())
+            data |= 0x80;
+        _delay(SUART_RX_BIT_DELAY);
+    }
+    //---------
+    stop = SUART_RX_READ();                                     //!< Middle of the stop bit
+    SUART_RX_IF = 0;                                            //!< Data bits edges are not start bits
+    if(stop == 0)
+    {
+        SoftUARTCh[0].Status.Ferr = 1;
+    }
+    else
+    {
+        head = SoftUARTCh[0].RxHead;
+        if((uint8_t)(head - SoftUARTCh[0].RxTail) >= SUART_RX_BUFFER_SIZE)
+        {
+            SoftUARTCh[0].Status.Buf = 1;
+        }
+        else
+        {
+            SoftUARTCh[0].RxBuf[head & SUART_RX_BUFFER_MASK] = data;
+            SoftUARTCh[0].RxHead = (uint8_t)(head + 1);
+            if(SoftUARTRxHook != NULL)
+                SoftUARTRxHook(0);                              //!< After the stop bit: its cycles add to SUART_RX_TAIL_CYCLES
+        }
+    }
+    //---------
+}
+//-----------------------------------
+
+#elif (SUART_MODE == SUART_MODE_COMPARE)
+
+void SoftUARTCallBack(void)
+{
+    //---------
+    if(SUART_RX_IE && SUART_RX_IF)
+        SoftUARTStartHandler();
+    if(PIE2bits.CCP2IE && PIR2bits.CCP2IF)
+        SoftUARTRxHandler();
+    if(PIE1bits.CCP1IE && PIR1bits.CCP1IF)
+        SoftUARTTxHandler();
+    //---------
+}
+//-----------------------------------
+
+#elif (SUART_MODE == SUART_MODE_TICK)
+
+void SoftUARTCallBack(void)
+{
+    //---------
+    if(PIE1bits.TMR2IE && PIR1bits.TMR2IF)
+        SoftUARTTickHandler();
+    //---------
+}
+//-----------------------------------
+
+#endif
@@ -0,0 +1,478 @@
+/**
+ ******************************************************************************
+ * @file            SystemTime.c
+ * @author          Maxime
+ * @brief           Source file for PIC18 System Time library
+ * @brief           See SystemTime.h
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include <stddef.h>
+#include "../Inc/SystemTime.h"
+#include "../Inc/Interrupts.h"
+//-----------------------------------
+
+//-----------------------------------
+#if (SYSTIME_MODE != SYSTIME_MODE_1MS) && (SYSTIME_MODE != SYSTIME_MODE_OVERFLOW)
+#error "SYSTIME_MODE must be SYSTIME_MODE_1MS or SYSTIME_MODE_OVERFLOW"
+#endif
+#if (FOSC_MHZ < 1) || (FOSC_MHZ > 40)
+#error "FOSC_MHZ must be from 1 to 40"
+#endif
+#if (SYSTIME_IDLE == SYSTIME_IDLE_SLEEP) && (SYSTIME_MODE != SYSTIME_MODE_1MS)
+#error "SYSTIME_IDLE_SLEEP requires SYSTIME_MODE_1MS: the Timer0 interrupt must wake the CPU up every millisecond"
+#endif
+#if (SYSTIME_LOAD_WINDOW_MS < 10) || (SYSTIME_LOAD_WINDOW_MS > 60000)
+#error "SYSTIME_LOAD_WINDOW_MS must be from 10 to 60000"
+#endif
+#if (SYSTIME_IDLE == SYSTIME_IDLE_SLEEP) && !defined(_OSCCON_IDLEN_POSN)
+#error "SYSTIME_IDLE_SLEEP requires a device with idle mode (OSCCON.IDLEN)"
+#endif
+#if (SYSTIME_IDLE == SYSTIME_IDLE_T1OSC) && (SYSTIME_MODE != SYSTIME_MODE_OVERFLOW)
+#error "SYSTIME_IDLE_T1OSC requires SYSTIME_MODE_OVERFLOW: the time asleep is added to the time of the overflows"
+#endif
+#if (SYSTIME_IDLE == SYSTIME_IDLE_T1OSC) && ((SYSTIME_T1OSC_SLEEP_TICKS < 2) || (SYSTIME_T1OSC_SLEEP_TICKS > 65535))
+#error "SYSTIME_T1OSC_SLEEP_TICKS must be from 2 to 65535"
+#endif
+#define SYSTIME_SPIN_CALIBRATION    16                          //!< SYSTIME_IDLE_SPIN: polls timed by SystimeInit(), power of two
+#define SYSTIME_SPIN_RUNS           4                           //!< SYSTIME_IDLE_SPIN: timings made, the shortest one is kept
+//-----------------------------------
+static volatile uint32_t SysTimeMs = 0;                         //!< Milliseconds elapsed, only modified by SysTimeCallBack()
+#if (SYSTIME_MODE == SYSTIME_MODE_OVERFLOW)
+static volatile uint16_t SysTimeRem = 0;                        //!< Instruction cycles elapsed over SysTimeMs, below SYSTIME_CYCLES_PER_MS
+#endif
+static SysTimeIdleHookType SysTimeIdleHook = NULL;              //!< See SysTimeSetIdleHook()
+static uint32_t SysTimeIdleUs = 0;                              //!< Idle time in the current measurement window
+static uint32_t SysTimeIdleWindow = 0;                          //!< Tick_ms() at the start of the current measurement window
+static uint16_t SysTimeIdlePermille = 1000;                     //!< Idle time of the last measurement window
+static uint16_t SysTimeLoadPeak = 0;                            //!< Highest CPU load of the windows, per mille
+#if (SYSTIME_IDLE == SYSTIME_IDLE_SPIN)
+static uint16_t SysTimeSpinCycles = 0;                          //!< Instruction cycles of SYSTIME_SPIN_CALIBRATION polls, measured by SystimeInit()
+#endif
+#if (SYSTIME_IDLE == SYSTIME_IDLE_T1OSC)
+static uint16_t SysTimeT1Frac = 0;                              //!< Instruction cycles asleep not accounted yet, in 1/2048 cycle
+#endif
+//-----------------------------------
+
+/**
+ * @brief   Read the time atomically
+ * @param   cycles: instruction cycles elapsed over the returned milliseconds, beyond
+ *          SYSTIME_CYCLES_PER_MS in SYSTIME_MODE_1MS when the overflow is pending
+ * @retval  milliseconds elapsed
+ *
+ */
+static uint32_t SysTimeRead(uint16_t *cycles)
+{
+    //---------
+    uint32_t ms;
+    uint16_t t;
+    uint8_t gie = INTCONbits.GIE;
+#if (SYSTIME_MODE == SYSTIME_MODE_OVERFLOW)
+    uint16_t rem;
+#endif
+    //---------
+    di();
+    t = TMR0L;                                                  //!< Reading TMR0L latches TMR0H: both bytes of the same count
+    t |= (uint16_t)TMR0H << 8;
+    ms = SysTimeMs;
+#if (SYSTIME_MODE == SYSTIME_MODE_OVERFLOW)
+    rem = SysTimeRem;
+    if(INTCONbits.TMR0IF)                                       //!< Overflow not accounted yet (interrupts disabled by the caller)
+    {
+        t = TMR0L;                                              //!< Read again: the count may predate the overflow
+        t |= (uint16_t)TMR0H << 8;
+        ms += SYSTIME_OVF_MS;
+        rem += SYSTIME_OVF_REM;
+    }
+    if(gie)
+        ei();
+    //---------
+    ms += t / SYSTIME_CYCLES_PER_MS;                            //!< 16 bits division only
+    rem += t % SYSTIME_CYCLES_PER_MS;
+    while(rem >= SYSTIME_CYCLES_PER_MS)
+    {
+        rem -= SYSTIME_CYCLES_PER_MS;
+        ++ms;
+    }
+    *cycles = rem;
+#else
+    if(gie)
+        ei();
+    *cycles = (uint16_t)(t + SYSTIME_CYCLES_PER_MS);           //!< TMR0 is 65536 - SYSTIME_CYCLES_PER_MS on the millisecond, also right when the overflow is pending
+#endif
+    //---------
+    return ms;
+}
+//-----------------------------------
+
+#if (SYSTIME_IDLE == SYSTIME_IDLE_SPIN)
+/**
+ * @brief   Time in instruction cycles, wraps around after 2^32 cycles
+ *
+ */
+static uint32_t SysTimeCycles(void)
+{
+    //---------
+    uint16_t cycles;
+    uint32_t ms = SysTimeRead(&cycles);
+    //---------
+    return ms * SYSTIME_CYCLES_PER_MS + cycles;
+}
+//-----------------------------------
+
+/**
+ * @brief   Poll the time until span milliseconds elapsed from ms, or max polls
+ * @retval  polls made: a call with n polls costs n + 2 polls (the last time read, ms), whatever
+ *          the interrupts serviced in between (See SysTimeSpinCycles)
+ *
+ */
+static uint16_t SysTimeSpin(uint32_t ms, uint32_t span, uint16_t max)
+{
+    //---------
+    uint16_t n = 0;
+    //---------
+    while((Tick_ms() - ms) < span && n != max)
+        ++n;
+    //---------
+    return n;
+}
+//-----------------------------------
+#endif
+
+void SystimeInit(void)
+{
+    //---------
+#if (SYSTIME_IDLE == SYSTIME_IDLE_SPIN)
+    uint32_t t, over = 0xFFFFFFFFUL, polls = 0xFFFFFFFFUL;
+    uint8_t i;
+#endif
+    //---------
+    SysTimeMs = 0;
+#if (SYSTIME_MODE == SYSTIME_MODE_OVERFLOW)
+    SysTimeRem = 0;
+#endif
+    SysTimeIdleUs = 0;
+    SysTimeIdleWindow = 0;
+    SysTimeIdlePermille = 1000;
+    SysTimeLoadPeak = 0;
+#if (SYSTIME_IDLE == SYSTIME_IDLE_T1OSC)
+    SysTimeT1Frac = 0;
+    PIE1bits.TMR1IE = 0;                                        //!< Enabled during the sleeps only
+    T1CON = 0x8F;                                               //!< On, 16 bits read/write, oscillator, not synchronized: counts in SLEEP
+    INTCONbits.PEIE = 1;                                        //!< Timer1 overflow wakes the CPU up
+#endif
+#if defined(USE_INTERRUPT_DISPATCHER)
+    InterruptRegisterHandler(TMR0_OVF_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGHEST, SysTimeCallBack);
+#endif
+    //---------
+    T0CON = 0x88;                                               //!< On, 16 bits, internal clock, no prescaler
+#if (SYSTIME_MODE == SYSTIME_MODE_OVERFLOW)
+    TMR0H = 0;
+    TMR0L = 0;
+#else
+    TMR0H = (uint8_t)((uint16_t)(0 - SYSTIME_CYCLES_PER_MS) >> 8);  //!< Buffered, written with TMR0L
+    TMR0L = (uint8_t)(0 - SYSTIME_CYCLES_PER_MS);
+#endif
+    INTCONbits.TMR0IF = 0;
+    INTCONbits.TMR0IE = 1;
+    INTCON |= 0xC0;
+    //---------
+#if (SYSTIME_IDLE == SYSTIME_IDLE_SPIN)
+    for(i = 0; i < SYSTIME_SPIN_RUNS; ++i)                      //!< Interrupts enabled as in SysTimeIdle(): they only lengthen a timing
+    {
+        t = SysTimeCycles();
+        SysTimeSpin(Tick_ms(), 0xFFFFFFFFUL, 0);
+        t = SysTimeCycles() - t;                                //!< Call and measurement overhead
+        if(t < over)
+            over = t;
+        t = SysTimeCycles();
+        SysTimeSpin(Tick_ms(), 0xFFFFFFFFUL, SYSTIME_SPIN_CALIBRATION);
+        t = SysTimeCycles() - t;
+        if(t < polls)
+            polls = t;
+    }
+    SysTimeSpinCycles = (uint16_t)(polls - over);
+#endif
+}
+//-----------------------------------
+
+uint32_t Tick_ms(void)
+{
+    //---------
+#if (SYSTIME_MODE == SYSTIME_MODE_OVERFLOW)
+    uint16_t cycles;
+    //---------
+    return SysTimeRead(&cycles);
+#else
+    uint32_t ms;
+    uint8_t gie = INTCONbits.GIE;
+    //---------
+    di();
+    ms = SysTimeMs;
+    if(gie)
+        ei();
+    //---------
+    return ms;
+#endif
+}
+//-----------------------------------
+
+uint32_t Tick_us(void)
+{
+    //---------
+    uint16_t cycles;
+    uint32_t ms = SysTimeRead(&cycles);
+    //---------
+#if (SYSTIME_MODE == SYSTIME_MODE_OVERFLOW)
+    return ms * 1000UL + (uint16_t)(cycles * 4U / FOSC_MHZ);
+#else
+    return ms * 1000UL + (uint32_t)cycles * 4U / FOSC_MHZ;     //!< Beyond SYSTIME_CYCLES_PER_MS when the overflow is pending
+#endif
+}
+//-----------------------------------
+
+void Wait_ms(uint32_t value)
+{
+    //---------
+    uint32_t start = Tick_ms();
+    //---------
+    while((Tick_ms() - start) < value)
+        SysTimeIdle();
+}
+//-----------------------------------
+
+#if (SYSTIME_IDLE == SYSTIME_IDLE_T1OSC)
+/**
+ * @brief   Wait for the next Timer1 increment, interrupts disabled
+ * @retval  Timer1 count
+ *
+ */
+static uint16_t SysTimeT1Edge(void)
+{
+    //---------
+    uint16_t t;
+    uint8_t l = TMR1L;
+    //---------
+    while(TMR1L == l);
+    t = TMR1L;                                                  //!< Reading TMR1L latches TMR1H
+    t |= (uint16_t)TMR1H << 8;
+    //---------
+    return t;
+}
+//-----------------------------------
+
+/**
+ * @brief   Add Timer1 periods to the time, interrupts disabled
+ * @param   ticks: Timer1 periods
+ *
+ */
+static void SysTimeT1Add(uint16_t ticks)
+{
+    //---------
+    uint32_t cycles;
+    uint16_t rem;
+    //---------
+    cycles = (uint32_t)(ticks & 0x07FF) * SYSTIME_T1OSC_CYCLES_PER_16 + SysTimeT1Frac;   //!< 32768 Hz: cycles = ticks * SYSTIME_T1OSC_CYCLES_PER_16 / 2048
+    SysTimeT1Frac = (uint16_t)cycles & 0x07FF;
+    cycles = (cycles >> 11) + (uint32_t)(ticks >> 11) * SYSTIME_T1OSC_CYCLES_PER_16;
+    rem = SysTimeRem;
+    while(cycles >= SYSTIME_CYCLES_PER_MS)                      //!< About one millisecond per sleep: no division
+    {
+        cycles -= SYSTIME_CYCLES_PER_MS;
+        ++SysTimeMs;
+    }
+    rem += (uint16_t)cycles;
+    if(rem >= SYSTIME_CYCLES_PER_MS)
+    {
+        rem -= SYSTIME_CYCLES_PER_MS;
+        ++SysTimeMs;
+    }
+    SysTimeRem = rem;
+    //---------
+}
+//-----------------------------------
+#endif
+
+/**
+ * @brief   Close the idle time measurement window once SYSTIME_LOAD_WINDOW_MS elapsed
+ *
+ */
+static void SysTimeLoadUpdate(void)
+{
+    //---------
+    uint32_t now = Tick_ms();
+    uint16_t load;
+    //---------
+    if((now - SysTimeIdleWindow) < SYSTIME_LOAD_WINDOW_MS)
+        return;
+    //---------
+    SysTimeIdleUs /= now - SysTimeIdleWindow;                   //!< Microseconds per millisecond: per mille
+    SysTimeIdlePermille = SysTimeIdleUs > 1000 ? 1000 : (uint16_t)SysTimeIdleUs;
+    SysTimeIdleUs = 0;
+    SysTimeIdleWindow = now;
+    load = 1000 - SysTimeIdlePermille;
+    if(load > SysTimeLoadPeak)
+        SysTimeLoadPeak = load;
+}
+//-----------------------------------
+
+void SysTimeIdle(void)
+{
+    //---------
+    uint32_t idle;                                              //!< Microseconds idle, the interrupts serviced meanwhile excluded
+#if (SYSTIME_IDLE == SYSTIME_IDLE_SLEEP)
+    uint32_t start;
+    uint8_t gie = INTCONbits.GIE;
+#elif (SYSTIME_IDLE == SYSTIME_IDLE_T1OSC)
+    uint32_t start;
+    uint16_t t, wake;
+    uint8_t gie = INTCONbits.GIE, run = T0CONbits.TMR0ON;
+#else
+    uint16_t n;
+#endif
+    //---------
+    if(SysTimeIdleHook != NULL)
+        SysTimeIdleHook();
+#if (SYSTIME_IDLE == SYSTIME_IDLE_SLEEP)
+    di();                                                       //!< An interrupt still wakes the CPU up, serviced once the time is read
+    start = Tick_us();
+    OSCCONbits.IDLEN = 1;                                       //!< CPU stopped, peripherals clocked: Timer0 keeps counting
+    SLEEP();
+    NOP();
+    idle = Tick_us() - start;
+    if(gie)
+        ei();
+#elif (SYSTIME_IDLE == SYSTIME_IDLE_T1OSC)
+    di();                                                       //!< An interrupt raised from here on makes SLEEP a NOP: no wake up is missed
+    start = Tick_us();
+    SysTimeT1Edge();                                            //!< A whole Timer1 period ahead to write it
+    T0CONbits.TMR0ON = 0;                                       //!< Time counted by Timer1 from this increment
+    idle = Tick_us() - start;
+    TMR1H = (uint8_t)((uint16_t)(0 - SYSTIME_T1OSC_SLEEP_TICKS) >> 8);  //!< Buffered, written with TMR1L
+    TMR1L = (uint8_t)(0 - SYSTIME_T1OSC_SLEEP_TICKS);
+    PIR1bits.TMR1IF = 0;
+    PIE1bits.TMR1IE = 1;
+    SLEEP();
+    NOP();
+    PIE1bits.TMR1IE = 0;
+    PIR1bits.TMR1IF = 0;
+    wake = TMR1L;                                               //!< Reading TMR1L latches TMR1H
+    wake |= (uint16_t)TMR1H << 8;
+    t = wake;
+    if(gie)
+    {
+        ei();                                                   //!< The interrupt that woke the CPU up is serviced first
+        di();
+        t = TMR1L;
+        t |= (uint16_t)TMR1H << 8;
+    }
+    t -= wake;                                                  //!< Timer1 periods in the interrupts: unbiased on average, the wake ups are asynchronous
+    wake = SysTimeT1Edge();                                     //!< ... to this increment
+    T0CONbits.TMR0ON = run;
+    if(run)
+        SysTimeT1Add((uint16_t)(wake + SYSTIME_T1OSC_SLEEP_TICKS));
+    if(gie)
+        ei();
+    idle += (uint32_t)(uint16_t)(wake + SYSTIME_T1OSC_SLEEP_TICKS - t) * 15625U >> 9;   //!< 32768 Hz: 15625 / 512 us per period
+#else
+    n = SysTimeSpin(Tick_ms(), 1, 0xFFFF);                      //!< Polls counted, not time: the interrupts serviced meanwhile are left out
+    idle = (uint32_t)(n + 2UL) * SysTimeSpinCycles / SYSTIME_SPIN_CALIBRATION * 4U / FOSC_MHZ;
+#endif
+    //---------
+    SysTimeIdleUs += idle;
+    SysTimeLoadUpdate();
+}
+//-----------------------------------
+
+void SysTimeSetIdleHook(SysTimeIdleHookType hook)
+{
+    SysTimeIdleHook = hook;
+}
+//-----------------------------------
+
+uint16_t SysTimeIdleLoad(void)
+{
+    SysTimeLoadUpdate();
+    return SysTimeIdlePermille;
+}
+//-----------------------------------
+
+uint8_t SysTimeCpuLoad(void)
+{
+    SysTimeLoadUpdate();
+    return (uint8_t)((1000 - SysTimeIdlePermille + 5) / 10);
+}
+//-----------------------------------
+
+uint8_t SysTimeCpuLoadPeak(uint8_t clear)
+{
+    //---------
+    uint8_t peak;
+    //---------
+    SysTimeLoadUpdate();
+    peak = (uint8_t)((SysTimeLoadPeak + 5) / 10);
+    if(clear)
+        SysTimeLoadPeak = 0;
+    //---------
+    return peak;
+}
+//-----------------------------------
+
+void SysTimeCallBack(void)
+{
+    //---------
+#if (SYSTIME_MODE == SYSTIME_MODE_OVERFLOW)
+    uint16_t rem;
+#else
+    uint16_t t;
+    uint8_t ms = 1;
+#endif
+    //---------
+    if(INTCONbits.TMR0IF == 0)
+        return;
+    INTCONbits.TMR0IF = 0;
+#if (SYSTIME_MODE == SYSTIME_MODE_OVERFLOW)
+    rem = SysTimeRem + SYSTIME_OVF_REM;
+    SysTimeMs += SYSTIME_OVF_MS;
+    if(rem >= SYSTIME_CYCLES_PER_MS)
+    {
+        rem -= SYSTIME_CYCLES_PER_MS;
+        ++SysTimeMs;
+    }
+    SysTimeRem = rem;
+#else
+    t = TMR0L;                                                  //!< Counts since the overflow: interrupt latency, interrupts disabled
+    t |= (uint16_t)TMR0H << 8;
+    t += SYSTIME_1MS_LOST;                                      //!< Counts when the write takes effect
+    while(t >= SYSTIME_CYCLES_PER_MS)                           //!< Milliseconds missed
+    {
+        t -= SYSTIME_CYCLES_PER_MS;
+        ++ms;
+    }
+    t -= SYSTIME_CYCLES_PER_MS;                                 //!< Next overflow SYSTIME_CYCLES_PER_MS after this one: no counts lost
+    TMR0H = (uint8_t)(t >> 8);
+    TMR0L = (uint8_t)t;
+    SysTimeMs += ms;
+#endif
+    //---------
+}
+//-----------------------------------
+
+void SysTimeSuspend(void)
+{
+    T0CONbits.TMR0ON = 0;
+}
+//-----------------------------------
+
+void SysTimeResume(void)
+{
+    T0CONbits.TMR0ON = 1;
+}
+//-----------------------------------
@@ -0,0 +1,245 @@
+/**
+ ******************************************************************************
+ * @file            Trace.c
+ * @author          Maxime
+ * @brief           Source file for PIC18 binary trace library
+ * @brief           See Trace.h
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; </center></h2>
+ *
+ *
+ ******************************************************************************
+ */
+
+//-----------------------------------
+#include "../Inc/Trace.h"
+#include "../Inc/Interrupts.h"
+//-----------------------------------
+
+#if defined(USE_TRACE)
+
+//-----------------------------------
+#define TRACE_BUFFER_MASK           (TRACE_BUFFER_SIZE - 1)
+#if (TRACE_BUFFER_SIZE < 8) || (TRACE_BUFFER_SIZE > 128) || ((TRACE_BUFFER_SIZE & TRACE_BUFFER_MASK) != 0)
+#error "TRACE_BUFFER_SIZE must be a power of two, from 8 to 128"
+#endif
+#define TRACE_PUT(head, data)       TraceBuf[(uint8_t)((head)++) & TRACE_BUFFER_MASK] = (uint8_t)(data)
+//-----------------------------------
+static uint8_t TraceBuf[TRACE_BUFFER_SIZE];
+static volatile uint8_t TraceHead = 0;                          //!< Free running index, only modified with the interrupts disabled
+static volatile uint8_t TraceTail = 0;                          //!< Free running index, only modified by TraceTxCallBack()
+static uint16_t TracePending = 0;                               //!< Events dropped, not reported by a loss record yet
+static uint16_t TraceDropped = 0;
+#if defined(HOST_BUILD)
+static uint16_t TraceFormatErrors = 0;
+#endif
+//-----------------------------------
+
+void TraceInit(void)
+{
+    //---------
+    PIE1bits.TXIE = 0;
+    TraceTail = TraceHead;
+    TracePending = 0;
+    TraceDropped = 0;
+#if defined(USE_INTERRUPT_DISPATCHER)
+    InterruptRegisterHandler(UART_TX_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_LOW, TraceTxCallBack);
+#endif
+    INTCONbits.PEIE = 1;
+    //---------
+}
+//-----------------------------------
+
+/**
+ * @brief   Reserve room for an event of len bytes, interrupts disabled
+ * @retval  0: reserved, 1: buffer full, event dropped
+ *
+ */
+static uint8_t TraceReserve(uint8_t len)
+{
+    //---------
+    uint8_t head = TraceHead;
+    uint8_t room = (uint8_t)(TRACE_BUFFER_SIZE - (uint8_t)(head - TraceTail));
+    //---------
+    if(TracePending != 0)                                       //!< The loss record goes first
+    {
+        if(room < len + 4)
+        {
+            if(TracePending != 0xFFFF)
+                ++TracePending;
+            if(TraceDropped != 0xFFFF)
+                ++TraceDropped;
+            return 1;
+        }
+        TRACE_PUT(head, TRACE_ID_LOST & 0xFF);
+        TRACE_PUT(head, TRACE_ID_LOST >> 8);
+        TRACE_PUT(head, TracePending);
+        TRACE_PUT(head, TracePending >> 8);
+        TraceHead = head;
+        TracePending = 0;
+        return 0;
+    }
+    //---------
+    if(room < len)
+    {
+        TracePending = 1;
+        if(TraceDropped != 0xFFFF)
+            ++TraceDropped;
+        return 1;
+    }
+    //---------
+    return 0;
+}
+//-----------------------------------
+
+void TraceWrite(uint16_t id, uint8_t argc, uint16_t a, uint16_t b, uint16_t c)
+{
+    //---------
+    uint8_t gie = INTCONbits.GIE;
+    uint8_t head;
+    //---------
+    di();
+    if(TraceReserve((uint8_t)(2 + 2 * argc)) == 0)
+    {
+        head = TraceHead;
+        TRACE_PUT(head, id);
+        TRACE_PUT(head, id >> 8);
+        if(argc > 0)
+        {
+            TRACE_PUT(head, a);
+            TRACE_PUT(head, a >> 8);
+        }
+        if(argc > 1)
+        {
+            TRACE_PUT(head, b);
+            TRACE_PUT(head, b >> 8);
+        }
+        if(argc > 2)
+        {
+            TRACE_PUT(head, c);
+            TRACE_PUT(head, c >> 8);
+        }
+        TraceHead = head;
+        PIE1bits.TXIE = 1;                                      //!< TXIF is set while TXREG is empty, the ISR fires right away
+    }
+    if(gie)
+        ei();
+    //---------
+}
+//-----------------------------------
+
+void TraceWrite32(uint16_t id, uint32_t a)
+{
+    //---------
+    uint8_t gie = INTCONbits.GIE;
+    uint8_t head;
+    //---------
+    di();
+    if(TraceReserve(6) == 0)
+    {
+        head = TraceHead;
+        TRACE_PUT(head, id);
+        TRACE_PUT(head, id >> 8);
+        TRACE_PUT(head, a);
+        TRACE_PUT(head, a >> 8);
+        TRACE_PUT(head, a >> 16);
+        TRACE_PUT(head, a >> 24);
+        TraceHead = head;
+        PIE1bits.TXIE = 1;
+    }
+    if(gie)
+        ei();
+    //---------
+}
+//-----------------------------------
+
+void TraceFlush(void)
+{
+    //---------
+    while(TraceHead != TraceTail)
+    {
+        if(INTCONbits.GIE == 0)
+            TraceTxCallBack();
+    }
+    while(TXSTAbits.TRMT == 0);                                 //!< Last byte shifted out?
+    //---------
+}
+//-----------------------------------
+
+uint16_t TraceGetDropped(void)
+{
+    //---------
+    uint8_t gie = INTCONbits.GIE;
+    uint16_t dropped;
+    //---------
+    di();
+    dropped = TraceDropped;
+    if(gie)
+        ei();
+    //---------
+    return dropped;
+}
+//-----------------------------------
+
+void TraceTxCallBack(void)
+{
+    //---------
+    uint8_t tail;
+    //---------
+    if(PIR1bits.TXIF == 0)
+        return;
+    //---------
+    tail = TraceTail;
+    if(tail == TraceHead)
+    {
+        PIE1bits.TXIE = 0;                                      //!< Nothing to send, stop the interrupt until the next event
+        return;
+    }
+    TXREG = TraceBuf[tail & TRACE_BUFFER_MASK];
+    TraceTail = (uint8_t)(tail + 1);
+    //---------
+}
+//-----------------------------------
+
+#if defined(HOST_BUILD)
+uint16_t TraceCheckFormat(const char *fmt, uint8_t size)
+{
+    //---------
+    const char *p = fmt;
+    uint8_t bytes = 0;
+    char c;
+    //---------
+    while((c = *p++) != '\0')
+    {
+        if(c != '%')
+            continue;
+        for(c = *p++; c == '-' || c == '.' || (c >= '0' && c <= '9'); c = *p++);      //!< Flags, width and decimals
+        if(c == 'l')
+        {
+            bytes += 4;
+            c = *p++;
+        }
+        else if(c == 'd' || c == 'u' || c == 'x' || c == 'X' || c == 'c')
+            bytes += 2;
+        if(c == 's')
+            bytes = 0xFF;                                       //!< Not supported
+        if(c == '\0')
+            break;
+    }
+    if(bytes != size && TraceFormatErrors != 0xFFFF)
+        ++TraceFormatErrors;
+    //---------
+    return (uint16_t)(unsigned long)(fmt);
+}
+//-----------------------------------
+
+uint16_t TraceGetFormatErrors(void)
+{
+    return TraceFormatErrors;
+}
+//-----------------------------------
+#endif
+
+#endif
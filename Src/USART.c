@@ -16,6 +16,49 @@
 //-----------------------------------
 #include "../Inc/USART.h"
 #include "../Inc/SystemTime.h"
+#include "../Inc/Interrupts.h"
+#include "../Inc/GPIO.h"
+//-----------------------------------
+
+//-----------------------------------
+#if (USART_RX_BUFFER_SIZE < 2) || (USART_RX_BUFFER_SIZE > 128) || ((USART_RX_BUFFER_SIZE & USART_RX_BUFFER_MASK) != 0)
+#error "USART_RX_BUFFER_SIZE must be a power of two, from 2 to 128"
+#endif
+//-----------------------------------
+static volatile uint8_t USARTRxBuf[USART_RX_BUFFER_SIZE];      //!< Receive ring buffer
+static volatile uint8_t USARTRxHead = 0;                        //!< Free running write index, only modified by USARTRxCallBack()
+static volatile uint8_t USARTRxTail = 0;                        //!< Free running read index, only modified by the application
+static volatile USARTRxStatsType USARTRxStats;                  //!< Reception error counters
+//-----------------------------------
+
+//-----------------------------------
+#if (USART_TX_BUFFER_SIZE < 2) || (USART_TX_BUFFER_SIZE > 128) || ((USART_TX_BUFFER_SIZE & USART_TX_BUFFER_MASK) != 0)
+#error "USART_TX_BUFFER_SIZE must be a power of two, from 2 to 128"
+#endif
+//-----------------------------------
+static volatile uint8_t USARTTxBuf[USART_TX_BUFFER_SIZE];      //!< Transmit queue
+static volatile uint8_t USARTTxHead = 0;                        //!< Free running write index, only modified by the application
+static volatile uint8_t USARTTxTail = 0;                        //!< Free running read index, only modified by USARTTxCallBack()
+static uint8_t USARTTxQueued = FALSE;                           //!< Interrupt driven transmission enabled
+static uint16_t USARTTxDropped = 0;                             //!< Bytes dropped on a full queue
+//-----------------------------------
+
+//-----------------------------------
+#if (USART_MD_FRAME_SIZE < 1) || (USART_MD_FRAME_SIZE > 255)
+#error "USART_MD_FRAME_SIZE must be from 1 to 255"
+#endif
+#define USART_MD_OFF                0                           //!< Multi-drop mode not started
+#define USART_MD_IDLE               1                           //!< Waiting for the node address, ADDEN set
+#define USART_MD_LENGTH             2                           //!< Addressed, waiting for the payload length
+#define USART_MD_PAYLOAD            3                           //!< Receiving the payload
+#define USART_MD_READY              4                           //!< Frame waiting to be read, ADDEN set
+//-----------------------------------
+static uint8_t USARTMdBuf[USART_MD_FRAME_SIZE];                 //!< Payload of the frame being received
+static volatile uint8_t USARTMdState = USART_MD_OFF;
+static uint8_t USARTMdAddress = 0;
+static uint8_t USARTMdLen = 0;
+static uint8_t USARTMdCnt = 0;
+static volatile uint16_t USARTMdDropped = 0;
 //-----------------------------------
 
 void USARTSetBGR(uint8_t bgr)
@@ -31,13 +74,13 @@ void USARTSetBaudRate(uint32_t baud)
     //---------
     uint8_t q = 1;uint32_t val = 1;
     //---------
-    if(TXSTA,SYNC)
+    if(TXSTAbits.SYNC)
     {
         q = 4;
     }
     else
     {
-        if(TXSTA,BRGH)
+        if(TXSTAbits.BRGH)
             q = 16;
         else
             q = 64;
@@ -72,7 +115,7 @@ void USARTAsyncInit(uint8_t bgr)
 void USARTTransmitByte9(uint16_t data)
 {
     //---------
-    while(TXSTA,TRMT == 0);                 //!< Last transmit completed?
+    while(TXSTAbits.TRMT == 0);             //!< Last transmit completed?
     //---------
     if(data & 0x100)
         TXSTA |= 0x01;                      //!< 9th bit is 1
@@ -86,6 +129,12 @@ void USARTTransmitByte9(uint16_t data)
 
 void USARTTransmitBytes(uint8_t *data, uint16_t cnt)
 {
+    //---------
+    if(USARTTxQueued)
+    {
+        USARTTxQueueBytes(data, cnt);
+        return;
+    }
     //---------
     while(cnt != 0)
     {
@@ -110,10 +159,31 @@ void USARTTransmitBytes9(uint16_t *data, uint16_t cnt)
 }
 //-----------------------------------------
 
+void USARTPutByte(uint8_t data)
+{
+    //---------
+    if(USARTTxQueued)
+    {
+        USARTTxQueueByte(data);
+        return;
+    }
+    //---------
+    USARTTransmitByte(data);
+    //---------
+}
+//-----------------------------------------
+
 void USARTPrint(const char *str)
 {
+    if(USARTTxQueued){
+        while(*str!='\0'){
+            USARTTxQueueByte((uint8_t)*str);
+            ++str;
+        }
+        return;
+    }
     while(*str!='\0'){
-        while(TXSTA,TRMT == 0);
+        while(TXSTAbits.TRMT == 0);
         TXREG = *str;
         ++str;
     }    
@@ -125,8 +195,11 @@ uint8_t USARTReceiveByte(void)
     //---------    
     uint8_t data = RCREG;
     //---------
-    if(RCSTA,OERR)
-        RCSTA,CREN = 0; 
+    if(RCSTAbits.OERR)
+    {
+        RCSTAbits.CREN = 0;                             //!< Reception is stopped until CREN is cycled
+        RCSTAbits.CREN = 1;
+    }
     //---------
     return data;     
 }
@@ -135,11 +208,14 @@ uint8_t USARTReceiveByte(void)
 uint16_t USARTReceiveByte9(void)
 {
     //---------    
-    uint16_t data = RCREG;
-    data |= (uint16_t)((RCSTA & 0x01) << 8);
+    uint16_t data = (uint16_t)((RCSTA & 0x01) << 8);    //!< RX9D belongs to the byte on top of the FIFO, read it first
+    data |= RCREG;
     //---------
-    if(RCSTA,OERR)
-        RCSTA,CREN = 0; 
+    if(RCSTAbits.OERR)
+    {
+        RCSTAbits.CREN = 0;                             //!< Reception is stopped until CREN is cycled
+        RCSTAbits.CREN = 1;
+    }
     //---------
     return data;    
 }
@@ -148,15 +224,27 @@ uint16_t USARTReceiveByte9(void)
 uint16_t USARTReceiveBytes(uint8_t *data, uint16_t cnt, uint32_t tout)
 {
     //---------
-    unsigned char j = 0;
+    uint16_t j = 0;
+    int c;
     uint32_t time = Tick_ms(); 
     while(cnt != 0)
     {
         //---------
-        if(USARTRxAvailable()){
+        if(PIE1bits.RCIE){
+            c = USARTRxBufferRead();
+            if(c >= 0){
+                *data = (uint8_t)c;
+                ++data;
+                ++j;
+                --cnt;
+                continue;                               //!< Drain the ring buffer before checking the time-out
+            }
+        }
+        else if(USARTRxAvailable()){
             *data = USARTReceiveByte();
             ++data;
             ++j;
+            --cnt;
         }
         //---------
         if((Tick_ms() - time) >= tout)
@@ -170,7 +258,7 @@ uint16_t USARTReceiveBytes(uint8_t *data, uint16_t cnt, uint32_t tout)
 uint16_t USARTReceiveBytes9(uint16_t *data, uint16_t cnt, uint32_t tout)
 {
     //---------
-    unsigned char j = 0;
+    uint16_t j = 0;
     uint32_t time = Tick_ms(); 
     while(cnt != 0)
     {
@@ -179,6 +267,7 @@ uint16_t USARTReceiveBytes9(uint16_t *data, uint16_t cnt, uint32_t tout)
             *data = USARTReceiveByte9();
             ++data;
             ++j;
+            --cnt;
         }
         //---------
         if((Tick_ms() - time) >= tout)
@@ -187,4 +276,414 @@ uint16_t USARTReceiveBytes9(uint16_t *data, uint16_t cnt, uint32_t tout)
  return j;
     //---------    
 }
-//-----------------------------------------
\ No newline at end of file
+//-----------------------------------------
+
+void USARTRxIntEnable(void)
+{
+    //---------
+    USARTMdState = USART_MD_OFF;                        //!< Back to the ring buffer from the multi-drop mode
+    USARTRxTail = USARTRxHead;
+#if defined(USE_INTERRUPT_DISPATCHER)
+    InterruptRegisterHandler(USART_RX_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGH, USARTRxCallBack);
+#endif
+    PIE1bits.RCIE = 1;
+    INTCONbits.PEIE = 1;
+    //---------
+}
+//-----------------------------------------
+
+void USARTRxIntDisable(void)
+{
+    //---------
+    PIE1bits.RCIE = 0;
+    //---------
+}
+//-----------------------------------------
+
+uint8_t USARTRxBufferAvailable(void)
+{
+    //---------
+    return (uint8_t)(USARTRxHead - USARTRxTail);
+    //---------
+}
+//-----------------------------------------
+
+int USARTRxBufferRead(void)
+{
+    //---------
+    uint8_t data;
+    uint8_t tail = USARTRxTail;
+    //---------
+    if(tail == USARTRxHead)
+        return -1;
+    //---------
+    data = USARTRxBuf[tail & USART_RX_BUFFER_MASK];
+    USARTRxTail = (uint8_t)(tail + 1);
+    //---------
+    return data;
+}
+//-----------------------------------------
+
+int USARTRxBufferPeek(void)
+{
+    //---------
+    uint8_t tail = USARTRxTail;
+    //---------
+    if(tail == USARTRxHead)
+        return -1;
+    //---------
+    return USARTRxBuf[tail & USART_RX_BUFFER_MASK];
+}
+//-----------------------------------------
+
+void USARTRxBufferFlush(void)
+{
+    //---------
+    USARTRxTail = USARTRxHead;
+    //---------
+}
+//-----------------------------------------
+
+void USARTRxGetStats(USARTRxStatsType *stats)
+{
+    //---------
+    uint8_t ie = PIE1bits.RCIE;
+    //---------
+    PIE1bits.RCIE = 0;                                  //!< 16 bits counters are not updated atomically
+    *stats = USARTRxStats;
+    PIE1bits.RCIE = ie;
+    //---------
+}
+//-----------------------------------------
+
+void USARTRxClearStats(void)
+{
+    //---------
+    uint8_t ie = PIE1bits.RCIE;
+    //---------
+    PIE1bits.RCIE = 0;
+    USARTRxStats.SwOverrun = 0;
+    USARTRxStats.HwOverrun = 0;
+    USARTRxStats.FrameErr = 0;
+    PIE1bits.RCIE = ie;
+    //---------
+}
+//-----------------------------------------
+
+/**
+ * @brief   Multi-drop frames reception, called by USARTRxCallBack()
+ *
+ */
+static void USARTMultidropCallBack(void)
+{
+    //---------
+    uint8_t data, address;
+    uint8_t state = USARTMdState;
+    //---------
+    while(PIR1bits.RCIF)
+    {
+        if(RCSTAbits.FERR)
+            ++USARTRxStats.FrameErr;
+        address = RCSTA & 0x01;                         //!< RX9D first, it belongs to the byte on top of the FIFO
+        data = RCREG;
+        //---------
+        if(address)                                     //!< A new frame starts, whatever the state
+        {
+            if(data != USARTMdAddress && data != USART_MD_BROADCAST)
+            {
+                if(state != USART_MD_READY)
+                    state = USART_MD_IDLE;
+                RCSTAbits.ADDEN = 1;                    //!< Not for us: sleep through the payload
+            }
+            else if(state == USART_MD_READY)
+                ++USARTMdDropped;                       //!< Previous frame not read yet
+            else
+            {
+                state = USART_MD_LENGTH;
+                RCSTAbits.ADDEN = 0;
+            }
+            continue;
+        }
+        //---------
+        if(state == USART_MD_LENGTH)
+        {
+            USARTMdLen = data;
+            USARTMdCnt = 0;
+            state = USART_MD_PAYLOAD;
+            if(data > USART_MD_FRAME_SIZE)
+            {
+                ++USARTMdDropped;
+                state = USART_MD_IDLE;
+            }
+        }
+        else if(state == USART_MD_PAYLOAD)
+            USARTMdBuf[USARTMdCnt++] = data;
+        else
+            continue;                                   //!< Received before ADDEN was set back
+        if(state == USART_MD_PAYLOAD && USARTMdCnt == USARTMdLen)
+            state = USART_MD_READY;
+        if(state != USART_MD_PAYLOAD)
+            RCSTAbits.ADDEN = 1;
+    }
+    //---------
+    if(RCSTAbits.OERR)                                  //!< Reception is stopped until CREN is cycled
+    {
+        ++USARTRxStats.HwOverrun;
+        RCSTAbits.CREN = 0;
+        RCSTAbits.CREN = 1;
+        if(state != USART_MD_READY)
+            state = USART_MD_IDLE;                      //!< Frame broken, wait for the next address
+        RCSTAbits.ADDEN = 1;
+    }
+    USARTMdState = state;
+    //---------
+}
+//-----------------------------------------
+
+void USARTRxCallBack(void)
+{
+    //---------
+    uint8_t data;
+    uint8_t head;
+    //---------
+    if(PIE1bits.RCIE == 0)
+        return;
+    //---------
+    if(USARTMdState != USART_MD_OFF)
+    {
+        USARTMultidropCallBack();
+        return;
+    }
+    //---------
+    head = USARTRxHead;
+    while(PIR1bits.RCIF)                                //!< Empty the 2 bytes hardware FIFO
+    {
+        if(RCSTAbits.FERR)
+            ++USARTRxStats.FrameErr;
+        data = RCREG;
+        //---------
+        if((uint8_t)(head - USARTRxTail) < USART_RX_BUFFER_SIZE)
+        {
+            USARTRxBuf[head & USART_RX_BUFFER_MASK] = data;
+            ++head;
+        }
+        else
+            ++USARTRxStats.SwOverrun;
+    }
+    USARTRxHead = head;
+    //---------
+    if(RCSTAbits.OERR)                                  //!< Reception is stopped until CREN is cycled
+    {
+        ++USARTRxStats.HwOverrun;
+        RCSTAbits.CREN = 0;
+        RCSTAbits.CREN = 1;
+    }
+    //---------
+}
+//-----------------------------------------
+
+void USARTTxIntEnable(void)
+{
+    //---------
+    USARTTxQueued = TRUE;
+#if defined(USE_INTERRUPT_DISPATCHER)
+    InterruptRegisterHandler(UART_TX_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_LOW, USARTTxCallBack);
+#endif
+    INTCONbits.PEIE = 1;
+    if(USARTTxHead != USARTTxTail)
+        PIE1bits.TXIE = 1;
+    //---------
+}
+//-----------------------------------------
+
+void USARTTxIntDisable(void)
+{
+    //---------
+    USARTTxFlush();
+    USARTTxQueued = FALSE;
+    PIE1bits.TXIE = 0;
+    //---------
+}
+//-----------------------------------------
+
+uint8_t USARTTxQueueByte(uint8_t data)
+{
+    //---------
+    uint8_t head = USARTTxHead;
+    //---------
+    while((uint8_t)(head - USARTTxTail) >= USART_TX_BUFFER_SIZE)
+    {
+#if (USART_TX_BLOCK_ON_FULL != 0)
+        if(INTCONbits.GIE == 0)
+            USARTTxCallBack();                          //!< Nobody else can drain the queue
+#else
+        ++USARTTxDropped;
+        return FALSE;
+#endif
+    }
+    //---------
+    USARTTxBuf[head & USART_TX_BUFFER_MASK] = data;
+    USARTTxHead = (uint8_t)(head + 1);
+    PIE1bits.TXIE = 1;                                  //!< TXIF is set while TXREG is empty, the ISR fires right away
+    //---------
+    return TRUE;
+}
+//-----------------------------------------
+
+uint16_t USARTTxQueueBytes(const uint8_t *data, uint16_t cnt)
+{
+    //---------
+    uint16_t j = 0;
+    //---------
+    while(cnt != 0)
+    {
+        if(USARTTxQueueByte(*data) == FALSE)
+            break;
+        ++data;
+        ++j;
+        --cnt;
+    }
+    //---------
+    return j;
+}
+//-----------------------------------------
+
+uint8_t USARTTxFree(void)
+{
+    //---------
+    return (uint8_t)(USART_TX_BUFFER_SIZE - (uint8_t)(USARTTxHead - USARTTxTail));
+    //---------
+}
+//-----------------------------------------
+
+void USARTTxFlush(void)
+{
+    //---------
+    while(USARTTxHead != USARTTxTail)
+    {
+        if(INTCONbits.GIE == 0)
+            USARTTxCallBack();
+    }
+    while(TXSTAbits.TRMT == 0);                         //!< Last byte shifted out?
+    //---------
+}
+//-----------------------------------------
+
+uint16_t USARTTxGetDropped(void)
+{
+    //---------
+    return USARTTxDropped;
+    //---------
+}
+//-----------------------------------------
+
+void USARTTxCallBack(void)
+{
+    //---------
+    uint8_t tail;
+    //---------
+    if((PIE1bits.TXIE == 0) || (PIR1bits.TXIF == 0))
+        return;
+    //---------
+    tail = USARTTxTail;
+    if(tail == USARTTxHead)
+    {
+        PIE1bits.TXIE = 0;                              //!< Queue empty, stop the interrupt until new data is queued
+        return;
+    }
+    //---------
+    TXREG = USARTTxBuf[tail & USART_TX_BUFFER_MASK];
+    USARTTxTail = (uint8_t)(tail + 1);
+    //---------
+}
+//-----------------------------------------
+
+void USARTMultidropInit(uint8_t bgr, uint8_t address)
+{
+    //---------
+#if defined(USART_MD_DE_PIN)
+    GPIOPinClear(USART_MD_DE_PIN);
+    GPIOPinOutput(USART_MD_DE_PIN);
+#endif
+    USARTMdAddress = address;
+    USARTMdState = USART_MD_IDLE;
+    TXSTA = 0x64;                   //!< Asynchronous mode, 9 bits transmit, high speed, transmitter enabled.
+    RCSTA = 0xD8;                   //!< USART enable, 9 bits reception, Receiver enabled, address detection
+    SPBRG = bgr;
+#if defined(USE_INTERRUPT_DISPATCHER)
+    InterruptRegisterHandler(USART_RX_INT_FLAG, INTERRUPT_HANDLER_PRIORITY_HIGH, USARTRxCallBack);
+#endif
+    PIE1bits.RCIE = 1;
+    INTCONbits.PEIE = 1;
+    //---------
+}
+//-----------------------------------------
+
+void USARTMultidropSetAddress(uint8_t address)
+{
+    //---------
+    USARTMdAddress = address;
+    //---------
+}
+//-----------------------------------------
+
+void USARTMultidropSend(uint8_t address, const uint8_t *data, uint8_t len)
+{
+    //---------
+#if defined(USART_MD_DE_PIN)
+    GPIOPinSet(USART_MD_DE_PIN);
+#endif
+    USARTTransmitByte9(0x100 | address);
+    USARTTransmitByte9(len);
+    while(len != 0)
+    {
+        USARTTransmitByte9(*data);
+        ++data;
+        --len;
+    }
+    while(TXSTAbits.TRMT == 0);                         //!< Last byte shifted out?
+#if defined(USART_MD_DE_PIN)
+    GPIOPinClear(USART_MD_DE_PIN);
+#endif
+    //---------
+}
+//-----------------------------------------
+
+uint8_t USARTMultidropFrameReady(void)
+{
+    //---------
+    return (uint8_t)(USARTMdState == USART_MD_READY);
+    //---------
+}
+//-----------------------------------------
+
+int USARTMultidropRead(uint8_t *data)
+{
+    //---------
+    uint8_t i, len;
+    //---------
+    if(USARTMdState != USART_MD_READY)
+        return -1;
+    //---------
+    len = USARTMdLen;                                   //!< Not modified by the interrupt in this state
+    for(i = 0; i < len; ++i)
+        data[i] = USARTMdBuf[i];
+    USARTMdState = USART_MD_IDLE;
+    //---------
+    return len;
+}
+//-----------------------------------------
+
+uint16_t USARTMultidropGetDropped(void)
+{
+    //---------
+    uint16_t dropped;
+    uint8_t ie = PIE1bits.RCIE;
+    //---------
+    PIE1bits.RCIE = 0;
+    dropped = USARTMdDropped;
+    PIE1bits.RCIE = ie;
+    //---------
+    return dropped;
+}
+//-----------------------------------------
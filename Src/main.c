@@ -10,28 +10,108 @@
 #include "../Inc/GPIO.h"
 #include "../Inc/Interrupts.h"
 #include "../Inc/SystemTime.h"
+#include "../Inc/SoftTimer.h"
+#include "../Inc/Scheduler.h"
+#include "../Inc/Profile.h"
+#include "../Inc/MemoryMonitor.h"
 #include "../Inc/USART.h"
 #include "../Inc/SoftwareUART.h"
+#include "../Inc/CRC.h"
+#include "../Inc/Format.h"
+#include "../Inc/Trace.h"
+
+#define PROFILE_BANNER          0                       // Profiled sections
+#define LED                     GPIO_PIN(GPIOA, 0)      // Blinking LED
+
+static TaskType BlinkTask;
+static TaskType EchoTask;
+
+static uint8_t Blink(TaskType *task)
+{
+    TASK_BEGIN(task);
+    while(1)
+    {
+        GPIOPinToggle(LED);
+        TASK_WAIT_MS(task, 500);
+    }
+    TASK_END(task);
+}
+
+static void EchoRxHook(uint8_t ch)                      // Interrupt context: a byte was received
+{
+    (void)ch;
+    SchedulerWake(&EchoTask);
+}
+
+static uint8_t Echo(TaskType *task)
+{
+    int c;
+    char line[24];                                      // Not kept across the waits
+    
+    TASK_BEGIN(task);
+    while(1)
+    {
+        TASK_SUSPEND_UNTIL(task, SoftUARTRxAvailable()); // Out of the run queue: SchedulerRun() idles
+        c = SoftUARTReceiveByte();
+        TRACE1("echo %c", c);
+        if(c == '?')                                    // Statistics dump command
+        {
+            MemMonPrint(SoftUARTPrint);
+            FormatString(line, sizeof(line), "load=%u%% peak=%u%%\r", SysTimeCpuLoad(), SysTimeCpuLoadPeak(0));
+            SoftUARTPrint(line);
+#if defined(USE_INTERRUPT_STATS)
+            InterruptStatsPrint(SoftUARTPrint);
+#endif
+            PROFILE_PRINT_REPORT(SoftUARTPrint, NULL);
+            continue;
+        }
+#if defined(USE_PROFILE)
+        if(c == '#')                                    // CRC and formatter benchmarks command
+        {
+            CRCBenchmark(SoftUARTPrint);
+            FormatBenchmark(SoftUARTPrint);
+            continue;
+        }
+#endif
+        SoftUARTTransmitByte((uint8_t)c);
+    }
+    TASK_END(task);
+}
 
 void main(void) {
     
+    MemMonInit();                                       // First: reports a stack overflow reset
     SystimeInit();
-    GPIOClearPin(GPIOA, 0);
-    GPIOSetOutput(GPIOA, 0);
+    SoftTimerInit();
+    SchedulerInit();
+#if defined(USE_INTERRUPT_STATS)
+    InterruptStatsInit();
+#endif
+#if defined(USE_PROFILE)
+    ProfileInit();
+#endif
+#if defined(USE_TRACE)
+    USARTAsyncInitBaud(9600);                           // Binary trace output, decoded by "make trace"
+    TraceInit();
+#endif
+    GPIOPinClear(LED);
+    GPIOPinOutput(LED);
     GPIOClearPin(GPIOB, 4);
     GPIOSetOutput(GPIOB, 4);
     
     SoftUARTInit();
+    TRACE("boot");
+    PROFILE_BEGIN(PROFILE_BANNER);
     SoftUARTPrint("Hello World!\r");
     SoftUARTPrint("This is a software UART library test!\r");
     SoftUARTPrint("Designed by Firmware Engineer Team. Copyright 2023.\r");
     SoftUARTPrint("\r\r");
     SoftUARTPrint("Freely available source code on GitHub (https://github.com/Firmware-Engineers/PIC18-API)\r");
+    PROFILE_END(PROFILE_BANNER);
     
-    while(1)
-    {
-        GPIOTogglePin(GPIOA, 0);
-        Wait_ms(500);
-    }
+    SchedulerAddTask(&BlinkTask, Blink);
+    SchedulerAddTask(&EchoTask, Echo);
+    SoftUARTSetRxHook(EchoRxHook);
+    SchedulerRun();
 }
 
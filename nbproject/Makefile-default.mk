@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=Src/main.c Src/FUSE_CONFIG.c Src/Interrupts.c Src/ISR.c Src/USART.c
+SOURCEFILES_QUOTED_IF_SPACED=Src/main.c Src/FUSE_CONFIG.c Src/Interrupts.c Src/ISR.c Src/USART.c Src/SoftwareUART.c Src/SystemTime.c Src/SoftTimer.c Src/Scheduler.c Src/Profile.c Src/MemoryMonitor.c Src/Packet.c Src/CRC.c Src/Format.c Src/Trace.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/Src/main.p1 ${OBJECTDIR}/Src/FUSE_CONFIG.p1 ${OBJECTDIR}/Src/Interrupts.p1 ${OBJECTDIR}/Src/ISR.p1 ${OBJECTDIR}/Src/USART.p1
-POSSIBLE_DEPFILES=${OBJECTDIR}/Src/main.p1.d ${OBJECTDIR}/Src/FUSE_CONFIG.p1.d ${OBJECTDIR}/Src/Interrupts.p1.d ${OBJECTDIR}/Src/ISR.p1.d ${OBJECTDIR}/Src/USART.p1.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/Src/main.p1 ${OBJECTDIR}/Src/FUSE_CONFIG.p1 ${OBJECTDIR}/Src/Interrupts.p1 ${OBJECTDIR}/Src/ISR.p1 ${OBJECTDIR}/Src/USART.p1 ${OBJECTDIR}/Src/SoftwareUART.p1 ${OBJECTDIR}/Src/SystemTime.p1 ${OBJECTDIR}/Src/SoftTimer.p1 ${OBJECTDIR}/Src/Scheduler.p1 ${OBJECTDIR}/Src/Profile.p1 ${OBJECTDIR}/Src/MemoryMonitor.p1 ${OBJECTDIR}/Src/Packet.p1 ${OBJECTDIR}/Src/CRC.p1 ${OBJECTDIR}/Src/Format.p1 ${OBJECTDIR}/Src/Trace.p1
+POSSIBLE_DEPFILES=${OBJECTDIR}/Src/main.p1.d ${OBJECTDIR}/Src/FUSE_CONFIG.p1.d ${OBJECTDIR}/Src/Interrupts.p1.d ${OBJECTDIR}/Src/ISR.p1.d ${OBJECTDIR}/Src/USART.p1.d ${OBJECTDIR}/Src/SoftwareUART.p1.d ${OBJECTDIR}/Src/SystemTime.p1.d ${OBJECTDIR}/Src/SoftTimer.p1.d ${OBJECTDIR}/Src/Scheduler.p1.d ${OBJECTDIR}/Src/Profile.p1.d ${OBJECTDIR}/Src/MemoryMonitor.p1.d ${OBJECTDIR}/Src/Packet.p1.d ${OBJECTDIR}/Src/CRC.p1.d ${OBJECTDIR}/Src/Format.p1.d ${OBJECTDIR}/Src/Trace.p1.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/Src/main.p1 ${OBJECTDIR}/Src/FUSE_CONFIG.p1 ${OBJECTDIR}/Src/Interrupts.p1 ${OBJECTDIR}/Src/ISR.p1 ${OBJECTDIR}/Src/USART.p1
+OBJECTFILES=${OBJECTDIR}/Src/main.p1 ${OBJECTDIR}/Src/FUSE_CONFIG.p1 ${OBJECTDIR}/Src/Interrupts.p1 ${OBJECTDIR}/Src/ISR.p1 ${OBJECTDIR}/Src/USART.p1 ${OBJECTDIR}/Src/SoftwareUART.p1 ${OBJECTDIR}/Src/SystemTime.p1 ${OBJECTDIR}/Src/SoftTimer.p1 ${OBJECTDIR}/Src/Scheduler.p1 ${OBJECTDIR}/Src/Profile.p1 ${OBJECTDIR}/Src/MemoryMonitor.p1 ${OBJECTDIR}/Src/Packet.p1 ${OBJECTDIR}/Src/CRC.p1 ${OBJECTDIR}/Src/Format.p1 ${OBJECTDIR}/Src/Trace.p1
 
 # Source Files
-SOURCEFILES=Src/main.c Src/FUSE_CONFIG.c Src/Interrupts.c Src/ISR.c Src/USART.c
+SOURCEFILES=Src/main.c Src/FUSE_CONFIG.c Src/Interrupts.c Src/ISR.c Src/USART.c Src/SoftwareUART.c Src/SystemTime.c Src/SoftTimer.c Src/Scheduler.c Src/Profile.c Src/MemoryMonitor.c Src/Packet.c Src/CRC.c Src/Format.c Src/Trace.c
 
 
 
@@ -134,6 +134,86 @@ ${OBJECTDIR}/Src/USART.p1: Src/USART.c  nbproject/Makefile-${CND_CONF}.mk
 	@-${MV} ${OBJECTDIR}/Src/USART.d ${OBJECTDIR}/Src/USART.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/Src/USART.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/Src/Trace.p1: Src/Trace.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/Trace.p1.d 
+	@${RM} ${OBJECTDIR}/Src/Trace.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/Trace.p1 Src/Trace.c 
+	@-${MV} ${OBJECTDIR}/Src/Trace.d ${OBJECTDIR}/Src/Trace.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/Trace.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/Format.p1: Src/Format.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/Format.p1.d 
+	@${RM} ${OBJECTDIR}/Src/Format.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/Format.p1 Src/Format.c 
+	@-${MV} ${OBJECTDIR}/Src/Format.d ${OBJECTDIR}/Src/Format.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/Format.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/CRC.p1: Src/CRC.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/CRC.p1.d 
+	@${RM} ${OBJECTDIR}/Src/CRC.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/CRC.p1 Src/CRC.c 
+	@-${MV} ${OBJECTDIR}/Src/CRC.d ${OBJECTDIR}/Src/CRC.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/CRC.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/Packet.p1: Src/Packet.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/Packet.p1.d 
+	@${RM} ${OBJECTDIR}/Src/Packet.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/Packet.p1 Src/Packet.c 
+	@-${MV} ${OBJECTDIR}/Src/Packet.d ${OBJECTDIR}/Src/Packet.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/Packet.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/MemoryMonitor.p1: Src/MemoryMonitor.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/MemoryMonitor.p1.d 
+	@${RM} ${OBJECTDIR}/Src/MemoryMonitor.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/MemoryMonitor.p1 Src/MemoryMonitor.c 
+	@-${MV} ${OBJECTDIR}/Src/MemoryMonitor.d ${OBJECTDIR}/Src/MemoryMonitor.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/MemoryMonitor.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/Profile.p1: Src/Profile.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/Profile.p1.d 
+	@${RM} ${OBJECTDIR}/Src/Profile.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/Profile.p1 Src/Profile.c 
+	@-${MV} ${OBJECTDIR}/Src/Profile.d ${OBJECTDIR}/Src/Profile.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/Profile.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/Scheduler.p1: Src/Scheduler.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/Scheduler.p1.d 
+	@${RM} ${OBJECTDIR}/Src/Scheduler.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/Scheduler.p1 Src/Scheduler.c 
+	@-${MV} ${OBJECTDIR}/Src/Scheduler.d ${OBJECTDIR}/Src/Scheduler.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/Scheduler.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/SoftTimer.p1: Src/SoftTimer.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/SoftTimer.p1.d 
+	@${RM} ${OBJECTDIR}/Src/SoftTimer.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/SoftTimer.p1 Src/SoftTimer.c 
+	@-${MV} ${OBJECTDIR}/Src/SoftTimer.d ${OBJECTDIR}/Src/SoftTimer.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/SoftTimer.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/SystemTime.p1: Src/SystemTime.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/SystemTime.p1.d 
+	@${RM} ${OBJECTDIR}/Src/SystemTime.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/SystemTime.p1 Src/SystemTime.c 
+	@-${MV} ${OBJECTDIR}/Src/SystemTime.d ${OBJECTDIR}/Src/SystemTime.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/SystemTime.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/SoftwareUART.p1: Src/SoftwareUART.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/SoftwareUART.p1.d 
+	@${RM} ${OBJECTDIR}/Src/SoftwareUART.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/SoftwareUART.p1 Src/SoftwareUART.c 
+	@-${MV} ${OBJECTDIR}/Src/SoftwareUART.d ${OBJECTDIR}/Src/SoftwareUART.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/SoftwareUART.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 else
 ${OBJECTDIR}/Src/main.p1: Src/main.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/Src" 
@@ -175,6 +255,86 @@ ${OBJECTDIR}/Src/USART.p1: Src/USART.c  nbproject/Makefile-${CND_CONF}.mk
 	@-${MV} ${OBJECTDIR}/Src/USART.d ${OBJECTDIR}/Src/USART.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/Src/USART.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/Src/Trace.p1: Src/Trace.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/Trace.p1.d 
+	@${RM} ${OBJECTDIR}/Src/Trace.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/Trace.p1 Src/Trace.c 
+	@-${MV} ${OBJECTDIR}/Src/Trace.d ${OBJECTDIR}/Src/Trace.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/Trace.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/Format.p1: Src/Format.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/Format.p1.d 
+	@${RM} ${OBJECTDIR}/Src/Format.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/Format.p1 Src/Format.c 
+	@-${MV} ${OBJECTDIR}/Src/Format.d ${OBJECTDIR}/Src/Format.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/Format.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/CRC.p1: Src/CRC.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/CRC.p1.d 
+	@${RM} ${OBJECTDIR}/Src/CRC.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/CRC.p1 Src/CRC.c 
+	@-${MV} ${OBJECTDIR}/Src/CRC.d ${OBJECTDIR}/Src/CRC.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/CRC.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/Packet.p1: Src/Packet.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/Packet.p1.d 
+	@${RM} ${OBJECTDIR}/Src/Packet.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/Packet.p1 Src/Packet.c 
+	@-${MV} ${OBJECTDIR}/Src/Packet.d ${OBJECTDIR}/Src/Packet.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/Packet.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/MemoryMonitor.p1: Src/MemoryMonitor.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/MemoryMonitor.p1.d 
+	@${RM} ${OBJECTDIR}/Src/MemoryMonitor.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/MemoryMonitor.p1 Src/MemoryMonitor.c 
+	@-${MV} ${OBJECTDIR}/Src/MemoryMonitor.d ${OBJECTDIR}/Src/MemoryMonitor.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/MemoryMonitor.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/Profile.p1: Src/Profile.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/Profile.p1.d 
+	@${RM} ${OBJECTDIR}/Src/Profile.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/Profile.p1 Src/Profile.c 
+	@-${MV} ${OBJECTDIR}/Src/Profile.d ${OBJECTDIR}/Src/Profile.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/Profile.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/Scheduler.p1: Src/Scheduler.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/Scheduler.p1.d 
+	@${RM} ${OBJECTDIR}/Src/Scheduler.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/Scheduler.p1 Src/Scheduler.c 
+	@-${MV} ${OBJECTDIR}/Src/Scheduler.d ${OBJECTDIR}/Src/Scheduler.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/Scheduler.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/SoftTimer.p1: Src/SoftTimer.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/SoftTimer.p1.d 
+	@${RM} ${OBJECTDIR}/Src/SoftTimer.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/SoftTimer.p1 Src/SoftTimer.c 
+	@-${MV} ${OBJECTDIR}/Src/SoftTimer.d ${OBJECTDIR}/Src/SoftTimer.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/SoftTimer.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/SystemTime.p1: Src/SystemTime.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/SystemTime.p1.d 
+	@${RM} ${OBJECTDIR}/Src/SystemTime.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/SystemTime.p1 Src/SystemTime.c 
+	@-${MV} ${OBJECTDIR}/Src/SystemTime.d ${OBJECTDIR}/Src/SystemTime.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/SystemTime.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/Src/SoftwareUART.p1: Src/SoftwareUART.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/Src" 
+	@${RM} ${OBJECTDIR}/Src/SoftwareUART.p1.d 
+	@${RM} ${OBJECTDIR}/Src/SoftwareUART.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/Src/SoftwareUART.p1 Src/SoftwareUART.c 
+	@-${MV} ${OBJECTDIR}/Src/SoftwareUART.d ${OBJECTDIR}/Src/SoftwareUART.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/Src/SoftwareUART.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 endif
 
 # ------------------------------------------------------------------------------------
@@ -192,15 +352,15 @@ endif
 # ------------------------------------------------------------------------------------
 # Rules for buildStep: link
 ifeq ($(TYPE_IMAGE), DEBUG_RUN)
-dist/${CND_CONF}/${IMAGE_TYPE}/PIC18.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}: ${OBJECTFILES}  nbproject/Makefile-${CND_CONF}.mk  Lib/SUART-16-9600-B0-B3.a Lib/SystemTime.X.a  
+dist/${CND_CONF}/${IMAGE_TYPE}/PIC18.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}: ${OBJECTFILES}  nbproject/Makefile-${CND_CONF}.mk   
 	@${MKDIR} dist/${CND_CONF}/${IMAGE_TYPE} 
-	${MP_CC} $(MP_EXTRA_LD_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -Wl,-Map=dist/${CND_CONF}/${IMAGE_TYPE}/PIC18.X.${IMAGE_TYPE}.map  -D__DEBUG=1  -DXPRJ_default=$(CND_CONF)  -Wl,--defsym=__MPLAB_BUILD=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -mrom=default,-7dc0-7fff -mram=default,-5f4-5ff,-f9c-f9c,-fd4-fd4,-fdb-fdf,-fe3-fe7,-feb-fef,-ffd-fff  $(COMPARISON_BUILD) -Wl,--memorysummary,dist/${CND_CONF}/${IMAGE_TYPE}/memoryfile.xml -o dist/${CND_CONF}/${IMAGE_TYPE}/PIC18.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}    Lib\SUART-16-9600-B0-B3.a Lib\SystemTime.X.a 
+	${MP_CC} $(MP_EXTRA_LD_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -Wl,-Map=dist/${CND_CONF}/${IMAGE_TYPE}/PIC18.X.${IMAGE_TYPE}.map  -D__DEBUG=1  -DXPRJ_default=$(CND_CONF)  -Wl,--defsym=__MPLAB_BUILD=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -mrom=default,-7dc0-7fff -mram=default,-5f4-5ff,-f9c-f9c,-fd4-fd4,-fdb-fdf,-fe3-fe7,-feb-fef,-ffd-fff  $(COMPARISON_BUILD) -Wl,--memorysummary,dist/${CND_CONF}/${IMAGE_TYPE}/memoryfile.xml -o dist/${CND_CONF}/${IMAGE_TYPE}/PIC18.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}    
 	@${RM} dist/${CND_CONF}/${IMAGE_TYPE}/PIC18.X.${IMAGE_TYPE}.hex 
 	
 else
-dist/${CND_CONF}/${IMAGE_TYPE}/PIC18.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}: ${OBJECTFILES}  nbproject/Makefile-${CND_CONF}.mk  Lib/SUART-16-9600-B0-B3.a Lib/SystemTime.X.a 
+dist/${CND_CONF}/${IMAGE_TYPE}/PIC18.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}: ${OBJECTFILES}  nbproject/Makefile-${CND_CONF}.mk  
 	@${MKDIR} dist/${CND_CONF}/${IMAGE_TYPE} 
-	${MP_CC} $(MP_EXTRA_LD_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -Wl,-Map=dist/${CND_CONF}/${IMAGE_TYPE}/PIC18.X.${IMAGE_TYPE}.map  -DXPRJ_default=$(CND_CONF)  -Wl,--defsym=__MPLAB_BUILD=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     $(COMPARISON_BUILD) -Wl,--memorysummary,dist/${CND_CONF}/${IMAGE_TYPE}/memoryfile.xml -o dist/${CND_CONF}/${IMAGE_TYPE}/PIC18.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}    Lib\SUART-16-9600-B0-B3.a Lib\SystemTime.X.a 
+	${MP_CC} $(MP_EXTRA_LD_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -Wl,-Map=dist/${CND_CONF}/${IMAGE_TYPE}/PIC18.X.${IMAGE_TYPE}.map  -DXPRJ_default=$(CND_CONF)  -Wl,--defsym=__MPLAB_BUILD=1    -fshort-double -fshort-float -memi=wordwrite -O1 -fasmfile -maddrqual=ignore -DFOSC_MHZ=16 -xassembler-with-cpp -mwarn=-3 -Wa,-a -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     $(COMPARISON_BUILD) -Wl,--memorysummary,dist/${CND_CONF}/${IMAGE_TYPE}/memoryfile.xml -o dist/${CND_CONF}/${IMAGE_TYPE}/PIC18.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}    
 	
 endif
 